@@ -24,11 +24,18 @@ void RunExamples()
 	//Number of nodes for Gauss-Legendre method
 	int gaussNodes = 4;
 
-	//Calculating integrals using different methods
-	double rectResult = Rect(steps, funcIntegration, range);
-	double simpsonResult = Simpson(steps, funcIntegration, range);
-	double trapezoidResult = Trapezoids(steps, funcIntegration, range);
-	double gaussResult = gaussLegendreIntegralSplit(range[0], range[1], funcIntegration, gaussNodes, steps);
+	//Calculating integrals using different methods; the plan evaluates the nodes shared by the rules only once
+	IntegrationPlan plan(range);
+	std::size_t rectIndex = plan.AddRect(steps);
+	std::size_t simpsonIndex = plan.AddSimpson(steps);
+	std::size_t trapezoidIndex = plan.AddTrapezoids(steps);
+	std::size_t gaussIndex = plan.AddGaussLegendreSplit(gaussNodes, steps);
+	std::vector<double> estimates = plan.Evaluate(funcIntegration);
+
+	double rectResult = estimates[rectIndex];
+	double simpsonResult = estimates[simpsonIndex];
+	double trapezoidResult = estimates[trapezoidIndex];
+	double gaussResult = estimates[gaussIndex];
 
 	//output results
 	std::cout << "Rectangle method result: " << rectResult << std::endl;
@@ -62,7 +69,11 @@ void RunExamples()
 
 	//output results
 	std::cout << "Lagrange interpolation result at x = " << x << ": " << lagrangeResult << std::endl;
-	std::cout << "Newton interpolation result at x = " << x << ": " << newtonResult << std::endl << std::endl;
+	std::cout << "Newton interpolation result at x = " << x << ": " << newtonResult << std::endl;
+
+	//The same function compiled into a lookup table of polynomial segments, accurate to 1e-10 on [0, 2]
+	TabulatedFunction tabulated = tabulate(funcInterpolation, { 0.0, 2.0 }, 1e-10);
+	std::cout << "Tabulated function at x = " << x << ": " << tabulated(x) << " (" << tabulated.Segments() << " segments)" << std::endl << std::endl;
 
 	//#3
 	//Example of using gauss-elimination method to solve a system of linear equations
@@ -3,20 +3,43 @@
 #define NUMERICLIB_HPP
 
 #include <vector>
+#include "integration/integrand.hpp"
 #include "integration/simpson.hpp"
 #include "integration/trapezoid.hpp"
 #include "integration/rectangle.hpp"
 #include "integration/gauss_legendre.hpp"
+#include "integration/gauss_kronrod.hpp"
+#include "integration/romberg.hpp"
+#include "integration/double_exponential.hpp"
+#include "integration/oscillatory.hpp"
+#include "integration/evaluation_cache.hpp"
+#include "integration/cubature.hpp"
+#include "integration/monte_carlo.hpp"
+#include "integration/sampled.hpp"
+#include "integration/parallel_integration.hpp"
 
 #include "interpolation/lagrange.hpp"
 #include "interpolation/newton.hpp"
+#include "interpolation/chebyshev.hpp"
+#include "interpolation/spline.hpp"
+#include "interpolation/tabulate.hpp"
+#include "interpolation/grid.hpp"
 
 #include "liniear_systems/gauss_elimination.hpp"
 #include "liniear_systems/lu.hpp"
+#include "liniear_systems/sparse_matrix.hpp"
+
+#include "io/binary_matrix.hpp"
+#include "io/matrix_market.hpp"
+#include "io/matrix_writer.hpp"
+#include "io/artifact_cache.hpp"
 
 #include "approximation.hpp"
+#include "fft.hpp"
+#include "polynomial.hpp"
 #include "ode_methods.hpp"
 #include "nonliniear.hpp"
+#include "nonliniear_batch.hpp"
 #include "utils.hpp"
 
 #endif // !NUMERICLIB_HPP
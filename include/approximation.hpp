@@ -2,10 +2,38 @@
 
 #include <vector>
 #include <cmath>
+#include <numbers>
+#include <cstddef>
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
+#include "integration/gauss_legendre.hpp"
+#include "interpolation/chebyshev.hpp"
+#include "liniear_systems/gauss_elimination.hpp"
+#include "parallel.hpp"
+#include "polynomial.hpp"
 
 namespace NumericLib {
 
+    /// <summary>
+    /// Polynomial basis in which an Approximation is computed and stored.
+    /// Monomial coefficients multiply powers of x; Legendre and Chebyshev coefficients multiply P_k(t) and T_k(t)
+    /// of t = (2x - a - b) / (b - a), the interval mapped onto [-1, 1].
+    /// </summary>
+    enum class ApproximationBasis {
+        Monomial,
+        Legendre,
+        Chebyshev
+    };
+
+    /// <summary>
+    /// Smallest number of Gauss-Legendre nodes over the interval used for the least-squares moments. Degrees above
+    /// ApproximationQuadratureNodes / 2 - 1 use 2 * (degree + 1) nodes, so the moments of f P_k stay exact for polynomials
+    /// f of twice the degree and the quadrature error does not grow with the degree.
+    /// </summary>
+    constexpr int ApproximationQuadratureNodes = 40;
+
     /// <summary>
     /// Constructs a polynomial least-squares approximation of a given function over a specified interval.
     /// </summary>
@@ -19,10 +47,109 @@ namespace NumericLib {
         std::vector<double> coeffs;
         int degree;
         std::vector<double> range;
+        ApproximationBasis basis = ApproximationBasis::Monomial;
+
+        // Evaluates the function once at every node of a Gauss-Legendre rule sized to the degree and passes
+        // (x, weight * f(x)) to accumulate.
+        template <typename Accumulate>
+        void SampleMoments(Accumulate accumulate)
+        {
+            const GaussLegendreRule& rule = getGLRule(std::max(ApproximationQuadratureNodes, 2 * (degree + 1)));
+            const double half = (range[1] - range[0]) / 2.0, mid = (range[0] + range[1]) / 2.0;
+            for (std::size_t k = 0; k < rule.nodes.size(); k++) {
+                const double x = mid + half * rule.nodes[k];
+                accumulate(x, half * rule.weights[k] * function(x));
+            }
+        }
+
+        void FitMonomial()
+        {
+            std::vector<std::vector<double>> A(degree + 1, std::vector<double>(degree + 1));
+            std::vector<double> b(degree + 1, 0.0);
+
+            // Fill matrix A analytically: A[i][j] = (b^(i+j+1) - a^(i+j+1)) / (i + j + 1)
+            std::vector<double> upper(2 * degree + 2), lower(2 * degree + 2);
+            upper[0] = range[1];
+            lower[0] = range[0];
+            for (int power = 1; power <= 2 * degree; power++) {
+                upper[power] = upper[power - 1] * range[1];
+                lower[power] = lower[power - 1] * range[0];
+            }
+            for (int i = 0; i <= degree; i++) {
+                for (int j = 0; j <= degree; j++) {
+                    int power = i + j;
+                    A[i][j] = (upper[power] - lower[power]) / (power + 1);
+                }
+            }
+
+            // Fill vector b with all moments of f x^i in a single pass over the quadrature nodes
+            SampleMoments([&](double x, double weighted) {
+                double power = weighted;
+                for (int i = 0; i <= degree; i++) {
+                    b[i] += power;
+                    power *= x;
+                }
+                });
+
+            coeffs = GaussElimination(A, b);
+        }
+
+        void FitLegendre()
+        {
+            // The normal matrix of the Legendre basis is diagonal: c_k = (2k + 1) / (b - a) * integral of f P_k(t)
+            coeffs.assign(degree + 1, 0.0);
+            SampleMoments([&](double x, double weighted) {
+                const double t = MapToUnit(x);
+                double previous = 0.0, current = 1.0;
+                for (int k = 0; k <= degree; k++) {
+                    coeffs[k] += weighted * current;
+                    const double next = ((2 * k + 1) * t * current - k * previous) / (k + 1);
+                    previous = current;
+                    current = next;
+                }
+                });
+            for (int k = 0; k <= degree; k++) {
+                coeffs[k] *= (2 * k + 1) / (range[1] - range[0]);
+            }
+        }
+
+        void FitChebyshev()
+        {
+            // Discrete least squares on Chebyshev-Gauss points, where T_0..T_degree are exactly orthogonal
+            const int m = std::max(degree + 1, ApproximationQuadratureNodes);
+            coeffs.assign(degree + 1, 0.0);
+            for (int j = 0; j < m; j++) {
+                const double t = std::cos(std::numbers::pi * (j + 0.5) / m);
+                const double y = function((range[0] + range[1]) / 2.0 + (range[1] - range[0]) / 2.0 * t);
+                double previous = t, current = 1.0;
+                for (int k = 0; k <= degree; k++) {
+                    coeffs[k] += y * current;
+                    const double next = 2.0 * t * current - previous;
+                    previous = current;
+                    current = next;
+                }
+            }
+            for (int k = 0; k <= degree; k++) {
+                coeffs[k] *= (k == 0 ? 1.0 : 2.0) / m;
+            }
+        }
+
+        double MapToUnit(double x) const
+        {
+            return (2.0 * x - range[0] - range[1]) / (range[1] - range[0]);
+        }
+
+        void CheckRange() const
+        {
+            if (range.size() != 2 || range[0] >= range[1]) {
+                throw std::invalid_argument("Invalid range: range must be [a, b] with a < b.");
+            }
+        }
 
     public:
         /// <summary>
         /// Creates an approximation object by computing the polynomial coefficients using the least-squares method.
+        /// The function is evaluated once per quadrature node and all moments are accumulated in the same pass.
         /// </summary>
         /// <param name="func">
         /// Function to approximate.
@@ -33,43 +160,67 @@ namespace NumericLib {
         /// <param name="r">
         /// Vector of two doubles [a, b] specifying the interval over which to approximate the function.
         /// </param>
+        /// <param name="polynomialBasis">
+        /// Basis of the approximation. The Legendre and Chebyshev bases have diagonal normal matrices, need no linear
+        /// solve and stay well conditioned for high degrees; the Chebyshev fit is least squares on Chebyshev points.
+        /// </param>
         /// <exception cref="std::invalid_argument">
         /// Thrown if the interval is invalid or degree is negative.
         /// </exception>
-        Approximation(Func func, int deg, std::vector<double> r) : function(func), degree(deg), range(r)
+        Approximation(Func func, int deg, std::vector<double> r, ApproximationBasis polynomialBasis = ApproximationBasis::Monomial)
+            : function(func), degree(deg), range(r), basis(polynomialBasis)
         {
-            if (range.size() != 2 || range[0] >= range[1]) {
-                throw std::invalid_argument("Invalid range: range must be [a, b] with a < b.");
-            }
+            CheckRange();
 
             if (deg < 0) {
                 throw std::invalid_argument("Degree must be non-negative.");
             }
 
-            coeffs.resize(degree + 1);
-            std::vector<std::vector<double>> A(degree + 1, std::vector<double>(degree + 1));
-            std::vector<double> b(degree + 1);
-
-            // Fill matrix A analytically
-            for (int i = 0; i <= degree; i++) {
-                for (int j = 0; j <= degree; j++) {
-                    int power = i + j;
-                    A[i][j] = (std::pow(range[1], power + 1) - std::pow(range[0], power + 1)) / (power + 1);
-                }
+            switch (basis) {
+            case ApproximationBasis::Monomial:
+                FitMonomial();
+                break;
+            case ApproximationBasis::Legendre:
+                FitLegendre();
+                break;
+            case ApproximationBasis::Chebyshev:
+                FitChebyshev();
+                break;
             }
+        }
 
-            // Fill vector b using Gauss-Legendre quadrature
-            for (int i = 0; i <= degree; i++) {
-                b[i] = gaussLegendreIntegralSplit(range[0], range[1], [this, i](double x) {
-                    return this->function(x) * std::pow(x, i);
-                    }, 4, 10);
-            }
+        /// <summary>
+        /// Creates an approximation object from previously computed coefficients, e.g. loaded from an ArtifactCache.
+        /// </summary>
+        /// <param name="func">
+        /// Function that was approximated.
+        /// </param>
+        /// <param name="coefficients">
+        /// Coefficients of the approximating polynomial in the given basis, where coefficients[i] belongs to the i-th basis polynomial.
+        /// </param>
+        /// <param name="r">
+        /// Vector of two doubles [a, b] specifying the interval of the approximation.
+        /// </param>
+        /// <param name="polynomialBasis">
+        /// Basis of the coefficients.
+        /// </param>
+        /// <exception cref="std::invalid_argument">
+        /// Thrown if the interval is invalid or there are no coefficients.
+        /// </exception>
+        Approximation(Func func, std::vector<double> coefficients, std::vector<double> r,
+            ApproximationBasis polynomialBasis = ApproximationBasis::Monomial)
+            : function(func), coeffs(std::move(coefficients)), degree(static_cast<int>(coeffs.size()) - 1), range(r), basis(polynomialBasis)
+        {
+            CheckRange();
 
-            coeffs = GaussElimination(A, b);
+            if (coeffs.empty()) {
+                throw std::invalid_argument("At least one coefficient is required.");
+            }
         }
 
         /// <summary>
-        /// Evaluates the approximating polynomial at a given point x.
+        /// Evaluates the approximating polynomial at a given point x, with Horner's scheme for monomials and
+        /// the Clenshaw recurrence for the Legendre and Chebyshev bases.
         /// </summary>
         /// <param name="x">
         /// The input value at which to evaluate the approximation.
@@ -77,14 +228,88 @@ namespace NumericLib {
         /// <returns>
         /// The value of the approximating polynomial at point x.
         /// </returns>
-        double Approximate(double x)
+        double Approximate(double x) const
         {
-            double result = 0.0;
-            for (int i = 0; i < coeffs.size(); i++)
-            {
-                result += coeffs[i] * std::pow(x, i);
+            double y = 0.0;
+            Approximate(&x, &y, 1);
+            return y;
+        }
+
+        /// <summary>
+        /// Evaluates the approximating polynomial at count points; the Chebyshev basis uses EvaluateChebyshevSeries, the
+        /// Legendre basis a blocked Clenshaw recurrence.
+        /// </summary>
+        /// <param name="x">
+        /// Points at which to evaluate the approximation.
+        /// </param>
+        /// <param name="y">
+        /// Output array receiving count values.
+        /// </param>
+        /// <param name="count">
+        /// Number of points.
+        /// </param>
+        void Approximate(const double* x, double* y, std::size_t count) const
+        {
+            const double scale = 2.0 / (range[1] - range[0]);
+            const double shift = -(range[0] + range[1]) / (range[1] - range[0]);
+            if (basis == ApproximationBasis::Chebyshev) {
+                EvaluateChebyshevSeries(coeffs, scale, shift, x, y, count);
+                return;
+            }
+
+            double t[parallel::BlockSize];
+            double b1[parallel::BlockSize];
+            double b2[parallel::BlockSize];
+
+            for (std::size_t start = 0; start < count; start += parallel::BlockSize) {
+                const std::size_t n = std::min(parallel::BlockSize, count - start);
+                const double* xs = x + start;
+                double* ys = y + start;
+
+                if (basis == ApproximationBasis::Monomial) {
+                    for (std::size_t i = 0; i < n; i++) ys[i] = coeffs[degree];
+                    for (int k = degree - 1; k >= 0; k--) {
+                        const double c = coeffs[k];
+                        for (std::size_t i = 0; i < n; i++) ys[i] = ys[i] * xs[i] + c;
+                    }
+                    continue;
+                }
+
+                // Clenshaw for Legendre: b_k = c_k + alpha_k t b_(k+1) - beta_(k+1) b_(k+2), from the highest degree down,
+                // with P_(k+1) = alpha_k t P_k - beta_k P_(k-1), alpha_k = (2k + 1) / (k + 1), beta_k = k / (k + 1)
+                for (std::size_t i = 0; i < n; i++) {
+                    t[i] = scale * xs[i] + shift;
+                    b1[i] = 0.0;
+                    b2[i] = 0.0;
+                }
+                for (int k = degree; k >= 1; k--) {
+                    const double c = coeffs[k];
+                    const double alpha = (2.0 * k + 1.0) / (k + 1.0);
+                    const double beta = (k + 1.0) / (k + 2.0);
+                    for (std::size_t i = 0; i < n; i++) {
+                        const double b0 = c + alpha * t[i] * b1[i] - beta * b2[i];
+                        b2[i] = b1[i];
+                        b1[i] = b0;
+                    }
+                }
+                for (std::size_t i = 0; i < n; i++) ys[i] = coeffs[0] + t[i] * b1[i] - 0.5 * b2[i];
             }
-            return result;
+        }
+
+        /// <summary>
+        /// Evaluates the approximating polynomial at every element of x.
+        /// </summary>
+        /// <param name="x">
+        /// Points at which to evaluate the approximation.
+        /// </param>
+        /// <returns>
+        /// Values of the approximating polynomial, in the order of x.
+        /// </returns>
+        std::vector<double> Approximate(const std::vector<double>& x) const
+        {
+            std::vector<double> y(x.size());
+            Approximate(x.data(), y.data(), x.size());
+            return y;
         }
 
         /// <summary>
@@ -96,11 +321,54 @@ namespace NumericLib {
         /// <returns>
         /// The value of the approximating polynomial at point x.
         /// </returns>
-        double operator()(double x)
+        double operator()(double x) const
         {
             return Approximate(x);
         }
 
+        /// <summary>
+        /// Returns the coefficients of the approximating polynomial in its basis; for the monomial basis the i-th element is the coefficient for x^i.
+        /// </summary>
+        const std::vector<double>& Coefficients() const
+        {
+            return coeffs;
+        }
+
+        /// <summary>
+        /// Returns the basis of the coefficients.
+        /// </summary>
+        ApproximationBasis Basis() const
+        {
+            return basis;
+        }
+
+        /// <summary>
+        /// Returns the approximating polynomial in the monomial basis of x. Legendre and Chebyshev coefficients are
+        /// converted through the three-term recurrences, which loses accuracy for high degrees.
+        /// </summary>
+        Polynomial ToPolynomial() const
+        {
+            if (basis == ApproximationBasis::Monomial) {
+                return Polynomial(coeffs);
+            }
+
+            // sum c_k B_k(t) with B_(k+1) = alpha_k t B_k - beta_k B_(k-1), then t = (2x - a - b) / (b - a) substituted
+            const Polynomial t({ 0.0, 1.0 });
+            Polynomial previous({ 1.0 });
+            Polynomial current = t;
+            Polynomial sum = Polynomial({ coeffs[0] });
+            for (int k = 1; k <= degree; k++) {
+                sum = sum + current * coeffs[k];
+                const Polynomial next = basis == ApproximationBasis::Chebyshev
+                    ? t * current * 2.0 - previous
+                    : (t * current * (2.0 * k + 1.0) - previous * static_cast<double>(k)) * (1.0 / (k + 1.0));
+                previous = current;
+                current = next;
+            }
+            const double scale = 2.0 / (range[1] - range[0]);
+            return sum.Compose(Polynomial({ -(range[0] + range[1]) / (range[1] - range[0]), scale }));
+        }
+
         /// <summary>
         /// Prints the coefficients of the approximating polynomial to the standard output.
         /// </summary>
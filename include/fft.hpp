@@ -0,0 +1,28 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace NumericLib {
+
+    /// <summary>
+    /// computes the discrete Fourier transform X_k = sum_j x_j exp(-2 pi i j k / n) in place with the iterative
+    /// radix-2 Cooley-Tukey algorithm in O(n log n). The inverse transform includes the 1 / n factor.
+    /// </summary>
+    /// <param name="data">
+    /// sequence to transform; its length must be a power of two
+    /// </param>
+    /// <param name="inverse">
+    /// computes the inverse transform x_j = (1 / n) sum_k X_k exp(2 pi i j k / n) instead
+    /// </param>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if the length of data is not a power of two
+    /// </exception>
+    void FFT(std::vector<std::complex<double>>& data, bool inverse = false);
+
+    /// <summary>
+    /// returns the smallest power of two that is not less than n
+    /// </summary>
+    std::size_t NextPowerOfTwo(std::size_t n);
+
+} // namespace NumericLib
@@ -0,0 +1,538 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <numbers>
+#include <set>
+#include <stdexcept>
+#include <vector>
+#include "fft.hpp"
+#include "integration/gauss_legendre.hpp"
+#include "parallel.hpp"
+#include "summation.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// result of a multidimensional integration
+    /// </summary>
+    struct CubatureResult {
+        double value = 0.0;
+        double error = 0.0;
+        int evaluations = 0;
+        bool converged = false;
+    };
+
+    /// <summary>
+    /// number of points per block of evaluateCubaturePoints. Every point is a full integrand call rather than a step of
+    /// a vectorized loop, so blocks are a sixteenth of parallel::BlockSize and grids of parallel::BlockSize points
+    /// already reach the thread pool.
+    /// </summary>
+    constexpr std::size_t CubatureBlockSize = parallel::BlockSize / parallel::ParallelBlocks;
+
+    /// <summary>
+    /// evaluates func at count points in parallel blocks of CubatureBlockSize points
+    /// </summary>
+    /// <typeparam name="Func">
+    /// callable double(const std::vector<double>&); it is called from several threads at once
+    /// </typeparam>
+    /// <typeparam name="PointAt">
+    /// callable void(std::size_t i, std::vector<double>& x) writing the i-th point to x
+    /// </typeparam>
+    /// <param name="func">
+    /// function to evaluate
+    /// </param>
+    /// <param name="dim">
+    /// number of coordinates of every point
+    /// </param>
+    /// <param name="count">
+    /// number of points
+    /// </param>
+    /// <param name="pointAt">
+    /// generates the points
+    /// </param>
+    /// <param name="threads">
+    /// maximum number of threads, 0 uses all threads of the shared pool
+    /// </param>
+    /// <returns>
+    /// function values in point order
+    /// </returns>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func, typename PointAt>
+    std::vector<double> evaluateCubaturePoints(const Func& func, std::size_t dim, std::size_t count, PointAt pointAt, unsigned threads = 0) {
+        std::vector<double> values(count);
+        const std::size_t blocks = (count + CubatureBlockSize - 1) / CubatureBlockSize;
+
+        parallel::ForEachBlock(blocks, [&](std::size_t block) {
+            std::vector<double> x(dim);
+            const std::size_t end = std::min(count, (block + 1) * CubatureBlockSize);
+            for (std::size_t i = block * CubatureBlockSize; i < end; i++) {
+                pointAt(i, x);
+                const double y = func(x);
+                if (!std::isfinite(y))
+                    throw std::domain_error("Function evaluation returned non-finite value.");
+                values[i] = y;
+            }
+            }, threads);
+        return values;
+    }
+
+    /// <summary>
+    /// checks that lower and upper describe a non-empty box
+    /// </summary>
+    inline void checkCubatureBox(const std::vector<double>& lower, const std::vector<double>& upper) {
+        if (lower.empty() || lower.size() != upper.size())
+            throw std::invalid_argument("Lower and upper bounds must have the same non-zero dimension.");
+        for (std::size_t d = 0; d < lower.size(); d++) {
+            if (lower[d] >= upper[d])
+                throw std::invalid_argument("Range start must be less than range end.");
+        }
+    }
+
+    /// <summary>
+    /// computes the integral of a function over a box with the tensor product of n-point Gauss-Legendre rules (n^d points)
+    /// </summary>
+    /// <typeparam name="Func">
+    /// callable double(const std::vector<double>&) taking a point of the box; it is called from several threads at once
+    /// </typeparam>
+    /// <param name="lower">
+    /// lower corner of the box
+    /// </param>
+    /// <param name="upper">
+    /// upper corner of the box
+    /// </param>
+    /// <param name="func">
+    /// function to be integrated
+    /// </param>
+    /// <param name="n">
+    /// number of Gauss-Legendre nodes per dimension
+    /// </param>
+    /// <param name="threads">
+    /// maximum number of threads, 0 uses all threads of the shared pool
+    /// </param>
+    /// <returns>
+    /// approximate value of the integral over the box
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if the box is empty or malformed, n is not positive or the grid has too many points
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    double tensorGaussLegendre(const std::vector<double>& lower, const std::vector<double>& upper, Func func, int n, unsigned threads = 0) {
+        checkCubatureBox(lower, upper);
+        const GaussLegendreRule& rule = getGLRule(n);
+        const std::size_t dim = lower.size();
+
+        std::size_t count = 1;
+        for (std::size_t d = 0; d < dim; d++) {
+            if (count > (std::size_t(1) << 40) / static_cast<std::size_t>(n))
+                throw std::invalid_argument("Tensor product grid has too many points.");
+            count *= static_cast<std::size_t>(n);
+        }
+
+        std::vector<double> half(dim), mid(dim);
+        double volume = 1.0;
+        for (std::size_t d = 0; d < dim; d++) {
+            half[d] = (upper[d] - lower[d]) / 2.0;
+            mid[d] = (upper[d] + lower[d]) / 2.0;
+            volume *= half[d];
+        }
+
+        // Point i uses the base-n digits of i as the node index in every dimension.
+        std::vector<double> values = evaluateCubaturePoints(func, dim, count, [&](std::size_t i, std::vector<double>& x) {
+            for (std::size_t d = 0; d < dim; d++, i /= n) {
+                x[d] = mid[d] + half[d] * rule.nodes[i % n];
+            }
+            }, threads);
+
+        NeumaierSum sum;
+        for (std::size_t i = 0; i < count; i++) {
+            double weight = 1.0;
+            for (std::size_t d = 0, digits = i; d < dim; d++, digits /= n) {
+                weight *= rule.weights[digits % n];
+            }
+            sum.Add(weight * values[i]);
+        }
+        return volume * sum.Value();
+    }
+
+    /// <summary>
+    /// finest level of the nested Clenshaw-Curtis rules used by the sparse grids; level l has 2^l + 1 points (level 0 has one)
+    /// </summary>
+    constexpr int SparseGridMaxLevel = 14;
+
+    /// <summary>
+    /// difference between the nested Clenshaw-Curtis rules of two consecutive levels on [-1, 1].
+    /// Points are identified by their index on the finest level, so points shared between levels get the same key.
+    /// </summary>
+    struct NestedRuleDifference {
+        std::vector<std::int64_t> keys;
+        std::vector<double> weights;
+    };
+
+    /// <summary>
+    /// returns the coordinate in [-1, 1] of the Clenshaw-Curtis point with the given finest-level index
+    /// </summary>
+    inline double clenshawCurtisPoint(std::int64_t key) {
+        const std::int64_t finest = std::int64_t(1) << SparseGridMaxLevel;
+        return std::sin(std::numbers::pi * static_cast<double>(2 * key - finest) / static_cast<double>(2 * finest));
+    }
+
+    /// <summary>
+    /// returns the weights of the Clenshaw-Curtis rule of a level, indexed by the point index j = 0..2^level on that level
+    /// (finest-level key j * 2^(SparseGridMaxLevel - level)); level 0 is the midpoint rule. The weights
+    /// c_j / n (1 - sum_k b_k cos(2 pi k j / n) / (4 k^2 - 1)) of all levels are computed once, each sum by one FFT.
+    /// </summary>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if the level is negative or larger than SparseGridMaxLevel
+    /// </exception>
+    inline const std::vector<double>& clenshawCurtisWeights(int level) {
+        static const std::vector<std::vector<double>> table = []() {
+            std::vector<std::vector<double>> levels(SparseGridMaxLevel + 1);
+            levels[0] = { 2.0 };
+            for (int l = 1; l <= SparseGridMaxLevel; l++) {
+                const std::size_t n = std::size_t(1) << l;
+                std::vector<std::complex<double>> moments(n, 0.0);
+                for (std::size_t k = 1; k <= n / 2; k++) {
+                    const double b = (k == n / 2) ? 1.0 : 2.0;
+                    moments[k] = b / (4.0 * static_cast<double>(k * k) - 1.0);
+                }
+                FFT(moments);
+
+                std::vector<double>& weights = levels[l];
+                weights.resize(n + 1);
+                for (std::size_t j = 0; j <= n; j++) {
+                    const double c = (j == 0 || j == n) ? 1.0 : 2.0;
+                    weights[j] = c / static_cast<double>(n) * (1.0 - moments[j % n].real());
+                }
+            }
+            return levels;
+        }();
+
+        if (level < 0 || level > SparseGridMaxLevel) {
+            throw std::invalid_argument("Clenshaw-Curtis level must be between 0 and SparseGridMaxLevel.");
+        }
+        return table[level];
+    }
+
+    /// <summary>
+    /// computes the difference rule Q_level - Q_(level - 1) of the nested Clenshaw-Curtis rules, with Q_(-1) = 0
+    /// </summary>
+    inline NestedRuleDifference clenshawCurtisDifference(int level) {
+        const std::vector<double>& fine = clenshawCurtisWeights(level);
+        if (level == 0) {
+            return { { std::int64_t(1) << (SparseGridMaxLevel - 1) }, fine };
+        }
+
+        NestedRuleDifference difference;
+        difference.keys.resize(fine.size());
+        difference.weights = fine;
+        for (std::size_t j = 0; j < fine.size(); j++) {
+            difference.keys[j] = static_cast<std::int64_t>(j) << (SparseGridMaxLevel - level);
+        }
+
+        // Every point of the coarser level is a point of this level; level 0 is the midpoint.
+        const std::vector<double>& coarse = clenshawCurtisWeights(level - 1);
+        for (std::size_t j = 0; j < coarse.size(); j++) {
+            difference.weights[level == 1 ? 1 : 2 * j] -= coarse[j];
+        }
+        return difference;
+    }
+
+    /// <summary>
+    /// evaluates the tensor products of difference rules that make up Smolyak sparse grids over a box.
+    /// Function values are cached by point, so points shared between multi-indices are evaluated once.
+    /// </summary>
+    /// <typeparam name="Func">
+    /// callable double(const std::vector<double>&); it is called from several threads at once
+    /// </typeparam>
+    template <typename Func>
+    class SparseGridEvaluator
+    {
+        Func func;
+        std::vector<double> half;
+        std::vector<double> mid;
+        double volume = 1.0;
+        unsigned threads;
+        std::vector<NestedRuleDifference> rules;
+        std::map<std::vector<std::int64_t>, double> values;
+
+        const NestedRuleDifference& Rule(int level) {
+            while (static_cast<int>(rules.size()) <= level) {
+                rules.push_back(clenshawCurtisDifference(static_cast<int>(rules.size())));
+            }
+            return rules[level];
+        }
+
+        // Calls visit(key, weight) for every point of the tensor product of the difference rules of index.
+        template <typename Visit>
+        void ForEachPoint(const std::vector<int>& index, Visit visit) {
+            const std::size_t dim = index.size();
+            std::vector<const NestedRuleDifference*> factors(dim);
+            for (std::size_t d = 0; d < dim; d++) {
+                factors[d] = &Rule(index[d]);
+            }
+
+            std::vector<std::size_t> digits(dim, 0);
+            std::vector<std::int64_t> key(dim);
+            while (true) {
+                double weight = 1.0;
+                for (std::size_t d = 0; d < dim; d++) {
+                    key[d] = factors[d]->keys[digits[d]];
+                    weight *= factors[d]->weights[digits[d]];
+                }
+                visit(key, weight);
+
+                std::size_t d = 0;
+                while (d < dim && ++digits[d] == factors[d]->keys.size()) {
+                    digits[d++] = 0;
+                }
+                if (d == dim) return;
+            }
+        }
+
+    public:
+        /// <summary>
+        /// prepares the evaluator for a box
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if the box is empty or malformed
+        /// </exception>
+        SparseGridEvaluator(Func function, const std::vector<double>& lower, const std::vector<double>& upper, unsigned threadCount = 0)
+            : func(function), threads(threadCount)
+        {
+            checkCubatureBox(lower, upper);
+            for (std::size_t d = 0; d < lower.size(); d++) {
+                half.push_back((upper[d] - lower[d]) / 2.0);
+                mid.push_back((upper[d] + lower[d]) / 2.0);
+                volume *= half.back();
+            }
+        }
+
+        /// <summary>
+        /// returns the contributions of the given multi-indices, i.e. the integrals of the tensor products of the
+        /// difference rules with levels index[d]. All points not evaluated before are evaluated in one parallel batch.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if a level exceeds SparseGridMaxLevel
+        /// </exception>
+        std::vector<double> Differences(const std::vector<std::vector<int>>& indices) {
+            std::set<std::vector<std::int64_t>> missing;
+            for (const auto& index : indices) {
+                for (int level : index) {
+                    if (level < 0 || level > SparseGridMaxLevel)
+                        throw std::invalid_argument("Sparse grid level out of range.");
+                }
+                ForEachPoint(index, [&](const std::vector<std::int64_t>& key, double) {
+                    if (values.find(key) == values.end()) missing.insert(key);
+                    });
+            }
+
+            std::vector<std::vector<std::int64_t>> keys(missing.begin(), missing.end());
+            std::vector<double> results = evaluateCubaturePoints(func, half.size(), keys.size(), [&](std::size_t i, std::vector<double>& x) {
+                for (std::size_t d = 0; d < x.size(); d++) {
+                    x[d] = mid[d] + half[d] * clenshawCurtisPoint(keys[i][d]);
+                }
+                }, threads);
+            for (std::size_t i = 0; i < keys.size(); i++) {
+                values.emplace(keys[i], results[i]);
+            }
+
+            std::vector<double> differences;
+            for (const auto& index : indices) {
+                NeumaierSum sum;
+                ForEachPoint(index, [&](const std::vector<std::int64_t>& key, double weight) {
+                    sum.Add(weight * values.at(key));
+                    });
+                differences.push_back(volume * sum.Value());
+            }
+            return differences;
+        }
+
+        /// <summary>
+        /// returns the number of distinct points evaluated so far
+        /// </summary>
+        int Evaluations() const { return static_cast<int>(values.size()); }
+    };
+
+    /// <summary>
+    /// computes the integral of a function over a box with a Smolyak sparse grid built on nested Clenshaw-Curtis rules.
+    /// The grid is the sum of the tensor-product difference rules whose levels add up to at most level, so the number
+    /// of points grows only polynomially with the dimension. The error estimate is the contribution of the finest layer.
+    /// </summary>
+    /// <typeparam name="Func">
+    /// callable double(const std::vector<double>&) taking a point of the box; it is called from several threads at once
+    /// </typeparam>
+    /// <param name="lower">
+    /// lower corner of the box
+    /// </param>
+    /// <param name="upper">
+    /// upper corner of the box
+    /// </param>
+    /// <param name="func">
+    /// function to be integrated
+    /// </param>
+    /// <param name="level">
+    /// level of the sparse grid, 0 evaluates only the center of the box
+    /// </param>
+    /// <param name="threads">
+    /// maximum number of threads, 0 uses all threads of the shared pool
+    /// </param>
+    /// <returns>
+    /// integral, error estimate and number of function evaluations; converged is always true
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if the box is malformed or level is outside [0, SparseGridMaxLevel]
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    CubatureResult smolyakIntegral(const std::vector<double>& lower, const std::vector<double>& upper, Func func, int level, unsigned threads = 0) {
+        if (level < 0 || level > SparseGridMaxLevel)
+            throw std::invalid_argument("Sparse grid level out of range.");
+
+        SparseGridEvaluator<Func> grid(func, lower, upper, threads);
+        const std::size_t dim = lower.size();
+
+        // Enumerates all multi-indices with a level sum of at most level.
+        std::vector<std::vector<int>> indices;
+        std::vector<int> index(dim, 0);
+        int total = 0;
+        while (true) {
+            indices.push_back(index);
+            std::size_t d = 0;
+            while (d < dim && total == level) {
+                total -= index[d];
+                index[d++] = 0;
+            }
+            if (d == dim) break;
+            index[d]++;
+            total++;
+        }
+
+        std::vector<double> differences = grid.Differences(indices);
+        NeumaierSum value, finest;
+        for (std::size_t i = 0; i < indices.size(); i++) {
+            value.Add(differences[i]);
+            int sum = 0;
+            for (int l : indices[i]) sum += l;
+            if (sum == level) finest.Add(differences[i]);
+        }
+
+        CubatureResult result;
+        result.value = value.Value();
+        result.error = std::abs(finest.Value());
+        result.evaluations = grid.Evaluations();
+        result.converged = true;
+        return result;
+    }
+
+    /// <summary>
+    /// computes the integral of a function over a box with a dimension-adaptive sparse grid (Gerstner-Griebel).
+    /// Starting from the center point, the multi-index with the largest contribution is refined in every dimension,
+    /// so the grid grows only in the directions that matter. The error estimate is the sum of the contributions of
+    /// the indices that have not been refined yet.
+    /// </summary>
+    /// <typeparam name="Func">
+    /// callable double(const std::vector<double>&) taking a point of the box; it is called from several threads at once
+    /// </typeparam>
+    /// <param name="lower">
+    /// lower corner of the box
+    /// </param>
+    /// <param name="upper">
+    /// upper corner of the box
+    /// </param>
+    /// <param name="func">
+    /// function to be integrated
+    /// </param>
+    /// <param name="absTol">
+    /// absolute error tolerance
+    /// </param>
+    /// <param name="relTol">
+    /// relative error tolerance
+    /// </param>
+    /// <param name="maxEvaluations">
+    /// refinement stops once this many points have been evaluated
+    /// </param>
+    /// <param name="threads">
+    /// maximum number of threads, 0 uses all threads of the shared pool
+    /// </param>
+    /// <returns>
+    /// integral, error estimate, number of function evaluations and whether the tolerance was met
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if the box is malformed, both tolerances are non-positive or maxEvaluations is not positive
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    CubatureResult adaptiveSparseGridIntegral(const std::vector<double>& lower, const std::vector<double>& upper, Func func,
+        double absTol = 1e-8, double relTol = 1e-8, int maxEvaluations = 100000, unsigned threads = 0) {
+        if (absTol <= 0 && relTol <= 0)
+            throw std::invalid_argument("At least one tolerance must be positive");
+        if (maxEvaluations <= 0)
+            throw std::invalid_argument("Maximum number of evaluations must be greater than 0");
+
+        SparseGridEvaluator<Func> grid(func, lower, upper, threads);
+        const std::size_t dim = lower.size();
+
+        std::set<std::vector<int>> refined;
+        std::map<std::vector<int>, double> active;
+        const std::vector<int> root(dim, 0);
+        active[root] = grid.Differences({ root })[0];
+        NeumaierSum value;
+        value.Add(active[root]);
+
+        CubatureResult result;
+        while (true) {
+            double error = 0.0;
+            auto worst = active.end();
+            for (auto it = active.begin(); it != active.end(); ++it) {
+                error += std::abs(it->second);
+                if (worst == active.end() || std::abs(it->second) > std::abs(worst->second)) worst = it;
+            }
+            result.value = value.Value();
+            result.error = error;
+            result.converged = error <= std::max(absTol, relTol * std::abs(result.value));
+            if (result.converged || worst == active.end() || grid.Evaluations() >= maxEvaluations) break;
+
+            const std::vector<int> index = worst->first;
+            active.erase(worst);
+            refined.insert(index);
+
+            // A forward neighbour is admissible once all of its backward neighbours have been refined.
+            std::vector<std::vector<int>> candidates;
+            for (std::size_t d = 0; d < dim; d++) {
+                std::vector<int> next = index;
+                if (++next[d] > SparseGridMaxLevel) continue;
+                bool admissible = true;
+                for (std::size_t e = 0; e < dim && admissible; e++) {
+                    if (e == d || next[e] == 0) continue;
+                    std::vector<int> back = next;
+                    back[e]--;
+                    admissible = refined.count(back) > 0;
+                }
+                if (admissible) candidates.push_back(next);
+            }
+
+            std::vector<double> differences = grid.Differences(candidates);
+            for (std::size_t i = 0; i < candidates.size(); i++) {
+                active[candidates[i]] = differences[i];
+                value.Add(differences[i]);
+            }
+        }
+
+        result.evaluations = grid.Evaluations();
+        return result;
+    }
+
+} // namespace NumericLib
@@ -0,0 +1,337 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "integration/gauss_kronrod.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// finest refinement level of the double-exponential tables; level l has step 2^-l
+    /// </summary>
+    constexpr int DoubleExponentialMaxLevel = 8;
+
+    /// <summary>
+    /// minimum level reached before a double-exponential integrator accepts an error estimate
+    /// </summary>
+    constexpr int DoubleExponentialMinLevel = 2;
+
+    /// <summary>
+    /// abscissas and weights of a double-exponential rule, grouped by the level at which they first appear.
+    /// Level 0 holds the nodes t = k, level l > 0 only the new nodes t = (2k + 1) 2^-l, so refining a level
+    /// evaluates only the new points. For the symmetric rules only the nodes with t >= 0 are stored.
+    /// </summary>
+    struct DoubleExponentialTable {
+        std::vector<std::vector<double>> abscissas;
+        std::vector<std::vector<double>> weights;
+    };
+
+    /// <summary>
+    /// builds a table: node(t, abscissa, weight) computes the node for parameter t and returns false once t is beyond the
+    /// usable range. Nodes are generated outwards from t = 0, for symmetric rules only in the positive direction.
+    /// </summary>
+    template <typename Node>
+    DoubleExponentialTable makeDoubleExponentialTable(bool symmetric, Node node) {
+        DoubleExponentialTable table;
+        table.abscissas.resize(DoubleExponentialMaxLevel + 1);
+        table.weights.resize(DoubleExponentialMaxLevel + 1);
+
+        for (int level = 0; level <= DoubleExponentialMaxLevel; level++) {
+            const double h = std::ldexp(1.0, -level);
+            for (int direction = 1; direction >= (symmetric ? 1 : -1); direction -= 2) {
+                for (int k = (level == 0 && direction < 0) ? 1 : 0; ; k++) {
+                    const double t = direction * (level == 0 ? k : 2 * k + 1) * h;
+                    double abscissa = 0.0, weight = 0.0;
+                    if (!node(t, abscissa, weight)) break;
+                    table.abscissas[level].push_back(abscissa);
+                    table.weights[level].push_back(weight);
+                }
+            }
+        }
+        return table;
+    }
+
+    /// <summary>
+    /// tanh-sinh table on [-1, 1]. Abscissas are stored as the distance 1 - |x| to the nearer endpoint, which keeps
+    /// full relative precision for nodes crowding the endpoints.
+    /// </summary>
+    inline const DoubleExponentialTable& tanhSinhTable() {
+        static const DoubleExponentialTable table = makeDoubleExponentialTable(true, [](double t, double& distance, double& weight) {
+            const double u = std::numbers::pi / 2.0 * std::sinh(t);
+            if (2.0 * u > 690.0) return false;
+            distance = 2.0 / (std::exp(2.0 * u) + 1.0);
+            weight = std::numbers::pi / 2.0 * std::cosh(t) / (std::cosh(u) * std::cosh(u));
+            return true;
+            });
+        return table;
+    }
+
+    /// <summary>
+    /// exp-sinh table for [0, inf): x = exp(pi/2 sinh t), restricted to 1e-100 <= x <= 1e100
+    /// </summary>
+    inline const DoubleExponentialTable& expSinhTable() {
+        static const DoubleExponentialTable table = makeDoubleExponentialTable(false, [](double t, double& x, double& weight) {
+            const double u = std::numbers::pi / 2.0 * std::sinh(t);
+            if (std::abs(u) > 230.0) return false;
+            x = std::exp(u);
+            weight = std::numbers::pi / 2.0 * std::cosh(t) * x;
+            return true;
+            });
+        return table;
+    }
+
+    /// <summary>
+    /// sinh-sinh table for (-inf, inf): x = sinh(pi/2 sinh t), restricted to |x| <= 1e100
+    /// </summary>
+    inline const DoubleExponentialTable& sinhSinhTable() {
+        static const DoubleExponentialTable table = makeDoubleExponentialTable(true, [](double t, double& x, double& weight) {
+            const double u = std::numbers::pi / 2.0 * std::sinh(t);
+            if (u > 230.0) return false;
+            x = std::sinh(u);
+            weight = std::numbers::pi / 2.0 * std::cosh(t) * std::cosh(u);
+            return true;
+            });
+        return table;
+    }
+
+    /// <summary>
+    /// runs the level refinement shared by the double-exponential integrators: the sum over the nodes of every new level
+    /// is added to the running sum, the estimate is step * sum * scale, and refinement stops once successive estimates agree.
+    /// </summary>
+    /// <typeparam name="Term">
+    /// callable double(double abscissa, double weight, int& evaluations) returning the weighted function values of a node
+    /// </typeparam>
+    template <typename Term>
+    AdaptiveIntegrationResult doubleExponentialRefine(const DoubleExponentialTable& table, double scale, Term term,
+        double absTol, double relTol, int maxLevel) {
+        if (absTol <= 0 && relTol <= 0)
+            throw std::invalid_argument("At least one tolerance must be positive");
+        if (maxLevel < 0 || maxLevel > DoubleExponentialMaxLevel)
+            throw std::invalid_argument("Maximum level out of range");
+
+        AdaptiveIntegrationResult result;
+        result.intervals = 1;
+        result.error = std::numeric_limits<double>::infinity();
+        double sum = 0.0;
+
+        for (int level = 0; level <= maxLevel; level++) {
+            const std::vector<double>& abscissas = table.abscissas[level];
+            const std::vector<double>& weights = table.weights[level];
+            for (std::size_t i = 0; i < abscissas.size(); i++) {
+                sum += term(abscissas[i], weights[i], result.evaluations);
+            }
+
+            const double estimate = std::ldexp(sum, -level) * scale;
+            if (!std::isfinite(estimate))
+                throw std::domain_error("Function evaluation returned non-finite value.");
+            if (level > 0) result.error = std::abs(estimate - result.value);
+            result.value = estimate;
+
+            result.converged = level >= DoubleExponentialMinLevel && result.error <= std::max(absTol, relTol * std::abs(result.value));
+            if (result.converged) break;
+        }
+        return result;
+    }
+
+    /// <summary>
+    /// computes the definite integral of a function over [a, b] with tanh-sinh quadrature. The nodes cluster double
+    /// exponentially at the endpoints and the endpoints themselves are never evaluated, so integrable singularities and
+    /// infinite derivatives at a and b are handled. Every level halves the step, reuses all previous evaluations and
+    /// roughly doubles the number of correct digits.
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated: double(double x), or double(double x, double d) where d is the
+    /// distance from x to the nearer endpoint computed without cancellation, for singularities such as 1 / sqrt(b - x)
+    /// </typeparam>
+    /// <param name="a">
+    /// lower limit of the integral
+    /// </param>
+    /// <param name="b">
+    /// upper limit of the integral
+    /// </param>
+    /// <param name="func">
+    /// function to be integrated
+    /// </param>
+    /// <param name="absTol">
+    /// absolute error tolerance
+    /// </param>
+    /// <param name="relTol">
+    /// relative error tolerance
+    /// </param>
+    /// <param name="maxLevel">
+    /// finest level used, at most DoubleExponentialMaxLevel
+    /// </param>
+    /// <returns>
+    /// integral, difference between the last two levels as error estimate, number of function evaluations and whether the tolerance was met
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if a is not less than b, both tolerances are non-positive or maxLevel is out of range
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    AdaptiveIntegrationResult tanhSinhIntegral(double a, double b, Func func, double absTol = 1e-10, double relTol = 1e-10,
+        int maxLevel = DoubleExponentialMaxLevel) {
+        if (!(a < b))
+            throw std::invalid_argument("Range start must be less than range end.");
+
+        const double half = (b - a) / 2.0;
+        constexpr bool takesDistance = std::is_invocable_v<Func&, double, double>;
+        auto call = [&func](double x, double distance) {
+            if constexpr (std::is_invocable_v<Func&, double, double>) return func(x, distance);
+            else return func(x);
+            };
+
+        return doubleExponentialRefine(tanhSinhTable(), half, [&](double distance, double weight, int& evaluations) {
+            if (distance == 1.0) {
+                evaluations++;
+                return weight * call(a + half, half);
+            }
+            // Unless the function takes the distance, nodes that round onto an endpoint are skipped.
+            double value = 0.0;
+            const double offset = half * distance;
+            if (takesDistance || a + offset > a) {
+                value += call(a + offset, offset);
+                evaluations++;
+            }
+            if (takesDistance || b - offset < b) {
+                value += call(b - offset, offset);
+                evaluations++;
+            }
+            return weight * value;
+            }, absTol, relTol, maxLevel);
+    }
+
+    /// <summary>
+    /// computes the integral of a function over [a, inf) with exp-sinh quadrature; the function should decay faster than 1/x
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated, which should accept a double and return a double
+    /// </typeparam>
+    /// <param name="a">
+    /// finite lower limit of the integral
+    /// </param>
+    /// <param name="func">
+    /// function to be integrated
+    /// </param>
+    /// <param name="absTol">
+    /// absolute error tolerance
+    /// </param>
+    /// <param name="relTol">
+    /// relative error tolerance
+    /// </param>
+    /// <param name="maxLevel">
+    /// finest level used, at most DoubleExponentialMaxLevel
+    /// </param>
+    /// <returns>
+    /// integral, error estimate, number of function evaluations and whether the tolerance was met
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if a is not finite, both tolerances are non-positive or maxLevel is out of range
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    AdaptiveIntegrationResult expSinhIntegral(double a, Func func, double absTol = 1e-10, double relTol = 1e-10,
+        int maxLevel = DoubleExponentialMaxLevel) {
+        if (!std::isfinite(a))
+            throw std::invalid_argument("Lower limit must be finite.");
+
+        return doubleExponentialRefine(expSinhTable(), 1.0, [&](double x, double weight, int& evaluations) {
+            const double node = a + x;
+            if (node == a) return 0.0;
+            evaluations++;
+            return weight * func(node);
+            }, absTol, relTol, maxLevel);
+    }
+
+    /// <summary>
+    /// computes the integral of a function over (-inf, inf) with sinh-sinh quadrature; the function should decay faster than 1/|x|
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated, which should accept a double and return a double
+    /// </typeparam>
+    /// <param name="func">
+    /// function to be integrated
+    /// </param>
+    /// <param name="absTol">
+    /// absolute error tolerance
+    /// </param>
+    /// <param name="relTol">
+    /// relative error tolerance
+    /// </param>
+    /// <param name="maxLevel">
+    /// finest level used, at most DoubleExponentialMaxLevel
+    /// </param>
+    /// <returns>
+    /// integral, error estimate, number of function evaluations and whether the tolerance was met
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if both tolerances are non-positive or maxLevel is out of range
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    AdaptiveIntegrationResult sinhSinhIntegral(Func func, double absTol = 1e-10, double relTol = 1e-10,
+        int maxLevel = DoubleExponentialMaxLevel) {
+        return doubleExponentialRefine(sinhSinhTable(), 1.0, [&](double x, double weight, int& evaluations) {
+            if (x == 0.0) {
+                evaluations++;
+                return weight * func(0.0);
+            }
+            evaluations += 2;
+            return weight * (func(x) + func(-x));
+            }, absTol, relTol, maxLevel);
+    }
+
+    /// <summary>
+    /// computes the integral of a function over [a, b], where either limit may be infinite, choosing tanh-sinh,
+    /// exp-sinh or sinh-sinh quadrature from the limits
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated, which should accept a double and return a double
+    /// </typeparam>
+    /// <param name="a">
+    /// lower limit of the integral, may be -infinity
+    /// </param>
+    /// <param name="b">
+    /// upper limit of the integral, may be +infinity
+    /// </param>
+    /// <param name="func">
+    /// function to be integrated
+    /// </param>
+    /// <param name="absTol">
+    /// absolute error tolerance
+    /// </param>
+    /// <param name="relTol">
+    /// relative error tolerance
+    /// </param>
+    /// <returns>
+    /// integral, error estimate, number of function evaluations and whether the tolerance was met
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if a is not less than b or both tolerances are non-positive
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    AdaptiveIntegrationResult doubleExponentialIntegral(double a, double b, Func func, double absTol = 1e-10, double relTol = 1e-10) {
+        if (!(a < b))
+            throw std::invalid_argument("Range start must be less than range end.");
+
+        const double inf = std::numeric_limits<double>::infinity();
+        if (a == -inf && b == inf) return sinhSinhIntegral(func, absTol, relTol);
+        if (b == inf) return expSinhIntegral(a, func, absTol, relTol);
+        if (a == -inf) return expSinhIntegral(-b, [&func](double x) { return func(-x); }, absTol, relTol);
+        return tanhSinhIntegral(a, b, func, absTol, relTol);
+    }
+
+} // namespace NumericLib
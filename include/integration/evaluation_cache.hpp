@@ -0,0 +1,230 @@
+#pragma once
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "integration/integrand.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// integrand wrapper that remembers every value it has computed, keyed by the exact node. Copies share one cache,
+    /// so the wrapper can be passed by value to several rules and each node is evaluated only once across all of them.
+    /// Lookups are thread-safe, so it can also be used with the parallel rules.
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the wrapped function, which should accept a double and return a double
+    /// </typeparam>
+    template <typename Func>
+    class MemoizedIntegrand
+    {
+        struct Cache {
+            std::shared_mutex mutex;
+            std::unordered_map<double, double> values;
+            std::atomic<std::size_t> evaluations{ 0 };
+            std::atomic<std::size_t> hits{ 0 };
+        };
+
+        Func func;
+        std::shared_ptr<Cache> cache;
+
+    public:
+        /// <summary>
+        /// wraps func with an empty cache
+        /// </summary>
+        explicit MemoizedIntegrand(Func func)
+            : func(func), cache(std::make_shared<Cache>())
+        {
+        }
+
+        /// <summary>
+        /// returns the cached value at x, evaluating and storing it on the first request
+        /// </summary>
+        double operator()(double x) const {
+            {
+                std::shared_lock<std::shared_mutex> lock(cache->mutex);
+                auto it = cache->values.find(x);
+                if (it != cache->values.end()) {
+                    cache->hits++;
+                    return it->second;
+                }
+            }
+
+            const double y = func(x);
+            std::unique_lock<std::shared_mutex> lock(cache->mutex);
+            if (cache->values.emplace(x, y).second) cache->evaluations++;
+            else cache->hits++;
+            return y;
+        }
+
+        /// <summary>
+        /// returns the number of distinct nodes at which the wrapped function was evaluated
+        /// </summary>
+        std::size_t Evaluations() const { return cache->evaluations; }
+
+        /// <summary>
+        /// returns the number of calls answered from the cache
+        /// </summary>
+        std::size_t Hits() const { return cache->hits; }
+
+        /// <summary>
+        /// forgets all cached values and resets the counters
+        /// </summary>
+        void Clear() {
+            std::unique_lock<std::shared_mutex> lock(cache->mutex);
+            cache->values.clear();
+            cache->evaluations = 0;
+            cache->hits = 0;
+        }
+    };
+
+    /// <summary>
+    /// wraps a function as a MemoizedIntegrand
+    /// </summary>
+    template <typename Func>
+    MemoizedIntegrand<Func> makeMemoizedIntegrand(Func func) {
+        return MemoizedIntegrand<Func>(func);
+    }
+
+    /// <summary>
+    /// sampling plan for several quadrature rules over the same range. The rules are registered first; the plan then
+    /// holds the sorted union of their nodes, which is evaluated once, and every estimate is computed from those values.
+    /// Each estimate equals the result of the corresponding standalone rule (Rect, Trapezoids, Simpson,
+    /// gaussLegendreIntegralSplit) because the nodes are computed with the same expressions and summed in the same order.
+    /// </summary>
+    class IntegrationPlan
+    {
+        enum class RuleKind {
+            Rect,
+            Trapezoids,
+            Simpson,
+            GaussLegendreSplit
+        };
+
+        struct Rule {
+            RuleKind kind;
+            std::size_t n;
+            double h;
+            int nodesPerPanel;
+        };
+
+        double a;
+        double b;
+        std::vector<Rule> rules;
+        std::vector<double> nodes;
+
+        // Nodes of a rule in the order the standalone rule sums them.
+        std::vector<double> RuleNodes(const Rule& rule) const;
+
+        std::size_t Add(const Rule& rule);
+
+    public:
+        /// <summary>
+        /// creates an empty plan over a range
+        /// </summary>
+        /// <param name="range">
+        /// vector of two doubles [a , b] representing the start and end of integration
+        /// </param>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if the range does not contain exactly two elements in the correct order
+        /// </exception>
+        explicit IntegrationPlan(const std::vector<double>& range);
+
+        /// <summary>
+        /// adds the rectangle rule with the given number of steps, see Rect
+        /// </summary>
+        /// <returns>
+        /// index of the estimate in the result of Evaluate
+        /// </returns>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if step is not positive
+        /// </exception>
+        std::size_t AddRect(double step);
+
+        /// <summary>
+        /// adds the trapezoid rule with the given number of steps, see Trapezoids
+        /// </summary>
+        /// <returns>
+        /// index of the estimate in the result of Evaluate
+        /// </returns>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if step is not positive
+        /// </exception>
+        std::size_t AddTrapezoids(double step);
+
+        /// <summary>
+        /// adds Simpson's rule with the given number of splits, see Simpson
+        /// </summary>
+        /// <returns>
+        /// index of the estimate in the result of Evaluate
+        /// </returns>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if split is not positive
+        /// </exception>
+        std::size_t AddSimpson(int split);
+
+        /// <summary>
+        /// adds the Gauss-Legendre rule with n nodes on each of splits subintervals, see gaussLegendreIntegralSplit
+        /// </summary>
+        /// <returns>
+        /// index of the estimate in the result of Evaluate
+        /// </returns>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if n or splits is not positive
+        /// </exception>
+        std::size_t AddGaussLegendreSplit(int n, int splits);
+
+        /// <summary>
+        /// returns the sorted, duplicate-free union of the nodes of all rules added so far
+        /// </summary>
+        const std::vector<double>& Nodes() const { return nodes; }
+
+        /// <summary>
+        /// returns the number of rules in the plan
+        /// </summary>
+        std::size_t Size() const { return rules.size(); }
+
+        /// <summary>
+        /// computes every estimate from the function values at Nodes()
+        /// </summary>
+        /// <param name="values">
+        /// values[i] is the function value at Nodes()[i]
+        /// </param>
+        /// <returns>
+        /// estimates in the order the rules were added
+        /// </returns>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if values and Nodes() differ in size
+        /// </exception>
+        std::vector<double> Estimates(const std::vector<double>& values) const;
+
+        /// <summary>
+        /// evaluates func once at every node of the plan, in blocks for a BatchIntegrand, and computes every estimate
+        /// </summary>
+        /// <typeparam name="Func">
+        /// callable double(double) or BatchIntegrand
+        /// </typeparam>
+        /// <returns>
+        /// estimates in the order the rules were added
+        /// </returns>
+        /// <exception cref="std::domain_error">
+        /// thrown if the function returns a non-finite value
+        /// </exception>
+        template <typename Func>
+        std::vector<double> Evaluate(Func func) const {
+            std::vector<double> values(nodes.size());
+            evaluateNodes(func, 0, nodes.size(), [this](std::size_t i) { return nodes[i]; }, [&values](std::size_t i, double y) {
+                if (!std::isfinite(y))
+                    throw std::domain_error("Function evaluation returned non-finite value.");
+                values[i] = y;
+                });
+            return Estimates(values);
+        }
+    };
+
+} // namespace NumericLib
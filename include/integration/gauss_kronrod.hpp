@@ -0,0 +1,267 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+namespace NumericLib {
+
+    /// <summary>
+    /// embedded Gauss-Kronrod pairs available to the adaptive integrator
+    /// </summary>
+    enum class KronrodRule {
+        G7K15,
+        G10K21
+    };
+
+    /// <summary>
+    /// nodes and weights of an embedded Gauss-Kronrod pair on [-1, 1]. Only the non-negative half is stored:
+    /// kronrodNodes[size - 1] is the center node, and every odd index holds a node shared with the Gauss rule.
+    /// </summary>
+    struct GaussKronrodTable {
+        const double* kronrodNodes;
+        const double* kronrodWeights;
+        const double* gaussWeights;
+        int size;
+    };
+
+    inline constexpr double K15Nodes[8] = {
+        0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+        0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+        0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+        0.207784955007898467600689403773245, 0.000000000000000000000000000000000
+    };
+    inline constexpr double K15Weights[8] = {
+        0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+        0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+        0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+        0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+    };
+    inline constexpr double G7Weights[4] = {
+        0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+        0.381830050505118944950369775488975, 0.417959183673469387755102040816327
+    };
+
+    inline constexpr double K21Nodes[11] = {
+        0.995657163025808080735527280689003, 0.973906528517171720077964012084452,
+        0.930157491355708226001207180059508, 0.865063366688984510732096688423493,
+        0.780817726586416897063717578345042, 0.679409568299024406234327365114874,
+        0.562757134668604683339000099272694, 0.433395394129247190799265943165784,
+        0.294392862701460198131126603103866, 0.148874338981631210884826001129720,
+        0.000000000000000000000000000000000
+    };
+    inline constexpr double K21Weights[11] = {
+        0.011694638867371874278064396062192, 0.032558162307964727478818972459390,
+        0.054755896574351996031381300244580, 0.075039674810919952767043140916190,
+        0.093125454583697605535065465083366, 0.109387158802297641899210590325805,
+        0.123491976262065851077208980221669, 0.134709217311473325928054001771707,
+        0.142775938577060080797094273138717, 0.147739104901338491374841515972068,
+        0.149445554002916905664936468389821
+    };
+    inline constexpr double G10Weights[5] = {
+        0.066671344308688137593568809893332, 0.149451349150580593145776339657697,
+        0.219086362515982043995534934228163, 0.269266719309996355091226921569469,
+        0.295524224714752870173892994651338
+    };
+
+    /// <summary>
+    /// returns the node and weight table of the requested Gauss-Kronrod pair
+    /// </summary>
+    inline GaussKronrodTable getGKTable(KronrodRule rule) {
+        switch (rule) {
+        case KronrodRule::G7K15:
+            return { K15Nodes, K15Weights, G7Weights, 8 };
+        case KronrodRule::G10K21:
+            return { K21Nodes, K21Weights, G10Weights, 11 };
+        default:
+            throw std::invalid_argument("Unknown Gauss-Kronrod rule");
+        }
+    }
+
+    /// <summary>
+    /// Kronrod estimate and error estimate of the integral over a single interval
+    /// </summary>
+    struct GaussKronrodEstimate {
+        double value;
+        double error;
+    };
+
+    /// <summary>
+    /// computes the integral of a function over [a, b] with an embedded Gauss-Kronrod pair.
+    /// The error is estimated from the difference between the Gauss and Kronrod results (QUADPACK scaling).
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated, which should accept a double and return a double
+    /// </typeparam>
+    /// <param name="a">
+    /// lower limit of the integral
+    /// </param>
+    /// <param name="b">
+    /// upper limit of the integral
+    /// </param>
+    /// <param name="func">
+    /// function to be integrated
+    /// </param>
+    /// <param name="rule">
+    /// Gauss-Kronrod pair to use
+    /// </param>
+    /// <returns>
+    /// Kronrod estimate of the integral and its error estimate
+    /// </returns>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    GaussKronrodEstimate gaussKronrodIntegral(double a, double b, Func func, KronrodRule rule = KronrodRule::G7K15) {
+        const GaussKronrodTable table = getGKTable(rule);
+        const int center = table.size - 1;
+        const double half = (b - a) / 2.0;
+        const double mid = (a + b) / 2.0;
+
+        double values[2 * 11 - 1];
+        const double fc = func(mid);
+        values[center] = fc;
+        double kronrod = table.kronrodWeights[center] * fc;
+        double gauss = (center % 2 == 1) ? table.gaussWeights[center / 2] * fc : 0.0;
+
+        for (int i = 0; i < center; i++) {
+            const double dx = half * table.kronrodNodes[i];
+            const double f1 = func(mid - dx);
+            const double f2 = func(mid + dx);
+            values[i] = f1;
+            values[2 * center - i] = f2;
+            kronrod += table.kronrodWeights[i] * (f1 + f2);
+            if (i % 2 == 1) gauss += table.gaussWeights[i / 2] * (f1 + f2);
+        }
+
+        if (!std::isfinite(kronrod))
+            throw std::domain_error("Function evaluation returned non-finite value.");
+
+        // resasc approximates the integral of |f - mean| and scales the raw |K - G| difference.
+        const double mean = kronrod / 2.0;
+        double resasc = table.kronrodWeights[center] * std::abs(fc - mean);
+        double resabs = table.kronrodWeights[center] * std::abs(fc);
+        for (int i = 0; i < center; i++) {
+            resasc += table.kronrodWeights[i] * (std::abs(values[i] - mean) + std::abs(values[2 * center - i] - mean));
+            resabs += table.kronrodWeights[i] * (std::abs(values[i]) + std::abs(values[2 * center - i]));
+        }
+
+        const double scale = std::abs(half);
+        double error = std::abs((kronrod - gauss) * half);
+        resasc *= scale;
+        resabs *= scale;
+        if (resasc != 0.0 && error != 0.0)
+            error = resasc * std::min(1.0, std::pow(200.0 * error / resasc, 1.5));
+        const double roundoff = 50.0 * std::numeric_limits<double>::epsilon();
+        if (resabs > std::numeric_limits<double>::min() / roundoff)
+            error = std::max(roundoff * resabs, error);
+
+        return { kronrod * half, error };
+    }
+
+    /// <summary>
+    /// result of an adaptive integration
+    /// </summary>
+    struct AdaptiveIntegrationResult {
+        double value = 0.0;
+        double error = 0.0;
+        int evaluations = 0;
+        int intervals = 0;
+        bool converged = false;
+    };
+
+    /// <summary>
+    /// computes the definite integral of a function over [a, b] with globally adaptive Gauss-Kronrod quadrature.
+    /// The subinterval with the largest error estimate is bisected until the total error estimate meets
+    /// max(absTol, relTol * |result|) or the interval limit is reached.
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated, which should accept a double and return a double
+    /// </typeparam>
+    /// <param name="a">
+    /// lower limit of the integral
+    /// </param>
+    /// <param name="b">
+    /// upper limit of the integral
+    /// </param>
+    /// <param name="func">
+    /// function to be integrated
+    /// </param>
+    /// <param name="absTol">
+    /// absolute error tolerance
+    /// </param>
+    /// <param name="relTol">
+    /// relative error tolerance
+    /// </param>
+    /// <param name="rule">
+    /// Gauss-Kronrod pair applied to every subinterval
+    /// </param>
+    /// <param name="maxIntervals">
+    /// maximum number of subintervals
+    /// </param>
+    /// <returns>
+    /// integral, error estimate, number of function evaluations and whether the tolerance was met
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if both tolerances are non-positive or maxIntervals is not positive
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    AdaptiveIntegrationResult gaussKronrodAdaptive(double a, double b, Func func, double absTol = 1e-10, double relTol = 1e-10,
+        KronrodRule rule = KronrodRule::G7K15, int maxIntervals = 1000) {
+        if (absTol <= 0 && relTol <= 0)
+            throw std::invalid_argument("At least one tolerance must be positive");
+        if (maxIntervals <= 0)
+            throw std::invalid_argument("Maximum number of intervals must be greater than 0");
+
+        struct Segment {
+            double a, b, value, error;
+            bool operator<(const Segment& other) const { return error < other.error; }
+        };
+
+        const int pointsPerRule = 2 * getGKTable(rule).size - 1;
+        AdaptiveIntegrationResult result;
+
+        GaussKronrodEstimate whole = gaussKronrodIntegral(a, b, func, rule);
+        std::priority_queue<Segment> segments;
+        segments.push({ a, b, whole.value, whole.error });
+        result.value = whole.value;
+        result.error = whole.error;
+        result.evaluations = pointsPerRule;
+
+        while (result.error > std::max(absTol, relTol * std::abs(result.value)) && static_cast<int>(segments.size()) < maxIntervals) {
+            Segment worst = segments.top();
+            const double mid = (worst.a + worst.b) / 2.0;
+            if (mid == worst.a || mid == worst.b) break;
+            segments.pop();
+
+            GaussKronrodEstimate left = gaussKronrodIntegral(worst.a, mid, func, rule);
+            GaussKronrodEstimate right = gaussKronrodIntegral(mid, worst.b, func, rule);
+            segments.push({ worst.a, mid, left.value, left.error });
+            segments.push({ mid, worst.b, right.value, right.error });
+
+            result.value += left.value + right.value - worst.value;
+            result.error += left.error + right.error - worst.error;
+            result.evaluations += 2 * pointsPerRule;
+        }
+
+        // Re-sum from the segments so the running updates do not leave cancellation residue in the result.
+        result.intervals = static_cast<int>(segments.size());
+        result.value = 0.0;
+        result.error = 0.0;
+        while (!segments.empty()) {
+            result.value += segments.top().value;
+            result.error += segments.top().error;
+            segments.pop();
+        }
+        result.converged = result.error <= std::max(absTol, relTol * std::abs(result.value));
+
+        return result;
+    }
+
+} // namespace NumericLib
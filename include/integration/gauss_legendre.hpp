@@ -3,6 +3,11 @@
 #include <vector>
 #include <stdexcept>
 #include <cmath>
+#include <numbers>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 namespace NumericLib {
 
@@ -15,31 +20,215 @@ namespace NumericLib {
     };
 
     /// <summary>
-	/// inline function to get the Gauss-Legendre quadrature rule for a given number of nodes
+	/// evaluates the Legendre polynomial P_n and its derivative at x using the three-term recurrence
+    /// </summary>
+    constexpr void legendreWithDerivative(int n, double x, double& p, double& dp) {
+        double p0 = 1.0, p1 = x;
+        for (int k = 2; k <= n; k++) {
+            double p2 = ((2 * k - 1) * x * p1 - (k - 1) * p0) / k;
+            p0 = p1;
+            p1 = p2;
+        }
+        p = (n == 0) ? 1.0 : p1;
+        dp = (n == 0) ? 0.0 : n * (x * p1 - p0) / (x * x - 1.0);
+    }
+
+    /// <summary>
+	/// cosine usable in constant expressions, accurate enough as a starting point for Newton's method on [0, pi]
+    /// </summary>
+    constexpr double constexprCos(double x) {
+        double sign = 1.0;
+        if (x > std::numbers::pi / 2) {
+            x = std::numbers::pi - x;
+            sign = -1.0;
+        }
+        double term = 1.0, sum = 1.0;
+        for (int k = 1; k < 15; k++) {
+            term *= -x * x / ((2 * k - 1) * (2 * k));
+            sum += term;
+        }
+        return sign * sum;
+    }
+
+    /// <summary>
+	/// computes the i-th largest node of the n-point Gauss-Legendre rule and its weight with Newton's method on P_n,
+	/// starting from Tricomi's asymptotic approximation. Usable in constant expressions for the compile-time tables;
+	/// the weight loses relative accuracy near x = 1 as n grows (about 1e-13 at n = 100), where legendreNodeTheta is exact.
+    /// </summary>
+    /// <param name="n">
+	/// number of nodes of the rule
+    /// </param>
+    /// <param name="i">
+	/// index of the node counted from the right end, 0 <= i < (n + 1) / 2
+    /// </param>
+    /// <param name="node">
+	/// receives the node
+    /// </param>
+    /// <param name="weight">
+	/// receives the weight of the node
+    /// </param>
+    constexpr void legendreNode(int n, int i, double& node, double& weight) {
+        double x = 0.0;
+        if (2 * i + 1 != n) {
+            x = (1.0 - 1.0 / (8.0 * n * n) + 1.0 / (8.0 * n * n * n)) * constexprCos(std::numbers::pi * (4 * i + 3) / (4 * n + 2));
+            for (int iter = 0; iter < 100; iter++) {
+                double p = 0.0, dp = 0.0;
+                legendreWithDerivative(n, x, p, dp);
+                double dx = p / dp;
+                x -= dx;
+                if (dx <= 1e-16 && dx >= -1e-16) break;
+            }
+        }
+        double p = 0.0, dp = 0.0;
+        legendreWithDerivative(n, x, p, dp);
+        node = x;
+        weight = 2.0 / ((1.0 - x * x) * dp * dp);
+    }
+
+    /// <summary>
+	/// evaluates P_n(cos theta) and its derivative with respect to theta. The recurrence runs on the differences
+	/// P_k - P_(k-1) in u = 1 - cos theta = 2 sin^2(theta / 2), so neither the values nor 1 - x^2 suffer from cancellation
+	/// near x = 1 (Reinsch's modification of the three-term recurrence)
+    /// </summary>
+    inline void legendreTheta(int n, double theta, double& p, double& dp) {
+        const double h = std::sin(theta / 2.0);
+        const double u = 2.0 * h * h;
+        double d = -u, pk = 1.0 - u;
+        for (int k = 2; k <= n; k++) {
+            d = ((k - 1) * d - (2 * k - 1) * u * pk) / k;
+            pk += d;
+        }
+        p = (n == 0) ? 1.0 : pk;
+        dp = (n == 0) ? 0.0 : n * (d - u * pk) / std::sin(theta);
+    }
+
+    /// <summary>
+	/// computes the i-th largest node of the n-point Gauss-Legendre rule and its weight with Newton's method in
+	/// theta = arccos x. The weight 2 / ((1 - x^2) P_n'(x)^2) equals 2 / (dP_n/dtheta)^2, which avoids forming 1 - x^2 from
+	/// a node close to 1, so the weights keep a relative accuracy of about 1e-14 up to thousands of nodes.
     /// </summary>
     /// <param name="n">
-	/// number of nodes for the Gauss-Legendre quadrature rule for 2, 3 and 4
+	/// number of nodes of the rule
+    /// </param>
+    /// <param name="i">
+	/// index of the node counted from the right end, 0 <= i < (n + 1) / 2
+    /// </param>
+    /// <param name="node">
+	/// receives the node
+    /// </param>
+    /// <param name="weight">
+	/// receives the weight of the node
+    /// </param>
+    inline void legendreNodeTheta(int n, int i, double& node, double& weight) {
+        double theta = std::numbers::pi / 2.0, p = 0.0, dp = 0.0;
+        if (2 * i + 1 != n) {
+            theta = std::acos((1.0 - 1.0 / (8.0 * n * n) + 1.0 / (8.0 * n * n * n)) * std::cos(std::numbers::pi * (4 * i + 3) / (4 * n + 2)));
+            for (int iter = 0; iter < 100; iter++) {
+                legendreTheta(n, theta, p, dp);
+                double step = p / dp;
+                theta -= step;
+                if (std::abs(step) <= 1e-15 * theta) break;
+            }
+        }
+        legendreTheta(n, theta, p, dp);
+        node = (2 * i + 1 == n) ? 0.0 : std::cos(theta);
+        weight = 2.0 / (dp * dp);
+    }
+
+    /// <summary>
+	/// nodes and weights of the N-point Gauss-Legendre rule computed at compile time, nodes in increasing order
+    /// </summary>
+    template <int N>
+    struct GaussLegendreTable {
+        double nodes[N];
+        double weights[N];
+    };
+
+    /// <summary>
+	/// builds the N-point Gauss-Legendre table in a constant expression
+    /// </summary>
+    template <int N>
+    constexpr GaussLegendreTable<N> makeGLTable() {
+        static_assert(N > 0, "Gauss-Legendre rule needs at least one node");
+        GaussLegendreTable<N> table{};
+        for (int i = 0; i < (N + 1) / 2; i++) {
+            double node = 0.0, weight = 0.0;
+            legendreNode(N, i, node, weight);
+            table.nodes[N - 1 - i] = node;
+            table.nodes[i] = -node;
+            table.weights[N - 1 - i] = weight;
+            table.weights[i] = weight;
+        }
+        return table;
+    }
+
+    /// <summary>
+	/// precomputed N-point Gauss-Legendre table; evaluated by the compiler, so using it costs nothing at run time
+    /// </summary>
+    template <int N>
+    inline constexpr GaussLegendreTable<N> glTable = makeGLTable<N>();
+
+    /// <summary>
+	/// computes the Gauss-Legendre rule with n nodes to full double precision, nodes in increasing order.
+	/// Nodes and weights are computed in theta = arccos x, see legendreNodeTheta.
+    /// </summary>
+    /// <param name="n">
+	/// number of nodes, must be positive
     /// </param>
     /// <returns>
 	/// struct containing the nodes and weights for the Gauss-Legendre quadrature rule
     /// </returns>
 	/// <exception cref="std::invalid_argument">
-	/// thrown if the input n is not one of the supported values: 2,3 or 4
+	/// thrown if n is not positive
     /// </exception>
-    inline GaussLegendreRule getGLRule(int n) {
-        switch (n) {
-        case 2:
-            return { {-0.5773502692, 0.5773502692}, {1.0, 1.0} };
-        case 3:
-            return { {-0.7745966692, 0.0, 0.7745966692}, {0.5555555556, 0.8888888889, 0.5555555556} };
-        case 4:
-            return {
-                {-0.8611363116, -0.3399810436, 0.3399810436, 0.8611363116},
-                {0.3478548451, 0.6521451549, 0.6521451549, 0.3478548451}
-            };
-        default:
-            throw std::invalid_argument("Only 2, 3 or 4 are valid values");
+    inline GaussLegendreRule computeGLRule(int n) {
+        if (n <= 0) {
+            throw std::invalid_argument("Number of Gauss-Legendre nodes must be greater than 0");
+        }
+
+        GaussLegendreRule rule{ std::vector<double>(n), std::vector<double>(n) };
+        for (int i = 0; i < (n + 1) / 2; i++) {
+            double node = 0.0, weight = 0.0;
+            legendreNodeTheta(n, i, node, weight);
+            rule.nodes[n - 1 - i] = node;
+            rule.nodes[i] = -node;
+            rule.weights[n - 1 - i] = weight;
+            rule.weights[i] = weight;
         }
+        return rule;
+    }
+
+    /// <summary>
+	/// inline function to get the Gauss-Legendre quadrature rule for a given number of nodes.
+	/// Rules are computed once and kept in a thread-safe table, so repeated calls only return a reference.
+    /// </summary>
+    /// <param name="n">
+	/// number of nodes for the Gauss-Legendre quadrature rule, any positive value
+    /// </param>
+    /// <returns>
+	/// reference to the cached struct containing the nodes and weights, valid for the lifetime of the program
+    /// </returns>
+	/// <exception cref="std::invalid_argument">
+	/// thrown if n is not positive
+    /// </exception>
+    inline const GaussLegendreRule& getGLRule(int n) {
+        if (n <= 0) {
+            throw std::invalid_argument("Number of Gauss-Legendre nodes must be greater than 0");
+        }
+
+        static std::shared_mutex mutex;
+        static std::map<int, std::unique_ptr<GaussLegendreRule>> rules;
+
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto it = rules.find(n);
+            if (it != rules.end()) return *it->second;
+        }
+
+        auto rule = std::make_unique<GaussLegendreRule>(computeGLRule(n));
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        auto inserted = rules.emplace(n, std::move(rule));
+        return *inserted.first->second;
     }
 
     /// <summary>
@@ -66,7 +255,7 @@ namespace NumericLib {
     template <typename Func>
     double gaussLegendreIntegral(double a, double b, Func func, int n) {
 
-        GaussLegendreRule rule = getGLRule(n);
+        const GaussLegendreRule& rule = getGLRule(n);
         double sum = 0.0;
 
         for (int i = 0; i < rule.nodes.size(); i++) {
@@ -77,6 +266,40 @@ namespace NumericLib {
         return ((b - a) / 2.0) * sum;
     }
 
+    /// <summary>
+	/// computes the definite integral of a function over [a, b] with the compile-time N-point Gauss-Legendre table
+    /// </summary>
+    /// <typeparam name="N">
+	/// number of nodes
+    /// </typeparam>
+    /// <typeparam name="Func">
+	/// template type for the function to be integrated, which should accept a double and return a double
+    /// </typeparam>
+    /// <param name="a">
+	/// lower limit of the integral
+    /// </param>
+    /// <param name="b">
+	/// upper limit of the integral
+    /// </param>
+    /// <param name="func">
+    /// funtion to be integrated
+    /// </param>
+    /// <returns>
+    /// approximate value of the definite integral
+    /// </returns>
+    template <int N, typename Func>
+    double gaussLegendreIntegral(double a, double b, Func func) {
+        const double half = (b - a) / 2.0;
+        const double mid = (a + b) / 2.0;
+        double sum = 0.0;
+
+        for (int i = 0; i < N; i++) {
+            sum += glTable<N>.weights[i] * func(half * glTable<N>.nodes[i] + mid);
+        }
+
+        return half * sum;
+    }
+
     /// <summary>
 	/// computes the definite integral of a function using the Gauss-Legendre quadrature method over the interval [a, b] with n nodes, splitting the interval into smaller segments
     /// </summary>
@@ -107,16 +330,21 @@ namespace NumericLib {
 				throw std::invalid_argument("Number of splits must be greater than 0");
 			}
 
+            const GaussLegendreRule& rule = getGLRule(n);
+            const int nodes = static_cast<int>(rule.nodes.size());
             double h = (b - a) / splits;
             double sum = 0.0;
 
             for (int i = 0; i < splits; ++i) {
-                double ai = a + i * h;
-                double bi = ai + h;
-                sum += gaussLegendreIntegral(ai, bi, func, n);
+                double mid = a + (i + 0.5) * h;
+                double part = 0.0;
+                for (int k = 0; k < nodes; k++) {
+                    part += rule.weights[k] * func(mid + (h / 2.0) * rule.nodes[k]);
+                }
+                sum += part;
             }
 
-            return sum;
+            return (h / 2.0) * sum;
         }
 
 } // namespace NumericLib
@@ -0,0 +1,93 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include "parallel.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// integrand evaluated in bulk: the wrapped callable receives an array of nodes and fills an array of values,
+    /// so vectorized implementations and lookup tables can process a whole block of nodes per call
+    /// </summary>
+    /// <typeparam name="BatchFunc">
+    /// callable with signature void(const double* x, double* y, std::size_t count)
+    /// </typeparam>
+    template <typename BatchFunc>
+    struct BatchIntegrand {
+        BatchFunc func;
+
+        /// <summary>
+        /// evaluates the integrand at count nodes
+        /// </summary>
+        void operator()(const double* x, double* y, std::size_t count) const {
+            func(x, y, count);
+        }
+
+        /// <summary>
+        /// evaluates the integrand at a single node, so batch integrands also work with the scalar rules
+        /// </summary>
+        double operator()(double x) const {
+            double y = 0.0;
+            func(&x, &y, 1);
+            return y;
+        }
+    };
+
+    /// <summary>
+    /// wraps a bulk evaluation callable as a BatchIntegrand
+    /// </summary>
+    /// <typeparam name="BatchFunc">
+    /// callable with signature void(const double* x, double* y, std::size_t count)
+    /// </typeparam>
+    template <typename BatchFunc>
+    BatchIntegrand<BatchFunc> makeBatchIntegrand(BatchFunc func) {
+        return BatchIntegrand<BatchFunc>{ func };
+    }
+
+    /// <summary>
+    /// true for BatchIntegrand types
+    /// </summary>
+    template <typename T>
+    struct isBatchIntegrand : std::false_type {};
+
+    template <typename BatchFunc>
+    struct isBatchIntegrand<BatchIntegrand<BatchFunc>> : std::true_type {};
+
+    /// <summary>
+    /// evaluates func at the nodes nodeAt(i) for i in [first, last) and passes every value to consume(i, value).
+    /// Batch integrands are called once per block of parallel::BlockSize nodes, other callables once per node.
+    /// </summary>
+    /// <typeparam name="Func">
+    /// scalar callable double(double) or BatchIntegrand
+    /// </typeparam>
+    /// <typeparam name="NodeAt">
+    /// callable returning the i-th node, computed from the index so no error accumulates
+    /// </typeparam>
+    /// <typeparam name="Consume">
+    /// callable receiving the node index and the function value
+    /// </typeparam>
+    template <typename Func, typename NodeAt, typename Consume>
+    void evaluateNodes(const Func& func, std::size_t first, std::size_t last, NodeAt nodeAt, Consume consume) {
+        if constexpr (isBatchIntegrand<Func>::value) {
+            double x[parallel::BlockSize];
+            double y[parallel::BlockSize];
+            for (std::size_t start = first; start < last; start += parallel::BlockSize) {
+                std::size_t count = std::min(parallel::BlockSize, last - start);
+                for (std::size_t k = 0; k < count; k++) {
+                    x[k] = nodeAt(start + k);
+                }
+                func(x, y, count);
+                for (std::size_t k = 0; k < count; k++) {
+                    consume(start + k, y[k]);
+                }
+            }
+        }
+        else {
+            for (std::size_t i = first; i < last; i++) {
+                consume(i, func(nodeAt(i)));
+            }
+        }
+    }
+
+} // namespace NumericLib
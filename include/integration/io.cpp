@@ -70,7 +70,7 @@ void PrintMatrix(vector<vector<double>>& A)
         {
             cout << setw(10) << A[i][j] << " ";
         }
-        cout << endl;
+        cout << '\n';
     }
     cout << endl;
 }
@@ -86,7 +86,7 @@ void PrintMatrix(vector<vector<double>>& A, vector<double>& b)
             cout << setw(10) << A[i][j] << " ";
         }
 
-        cout << "| " << b[i] << endl;
+        cout << "| " << b[i] << '\n';
     }
     cout << endl;
 }
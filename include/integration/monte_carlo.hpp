@@ -0,0 +1,352 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "parallel.hpp"
+#include "summation.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// Philox4x32-10 counter-based random number generator (Salmon et al., Random123). Every 128-bit counter maps to
+    /// four independent 32-bit words, so any element of any stream can be generated directly without shared state.
+    /// </summary>
+    /// <param name="counter">
+    /// 128-bit counter as four 32-bit words
+    /// </param>
+    /// <param name="key">
+    /// 64-bit key (the seed) as two 32-bit words
+    /// </param>
+    /// <returns>
+    /// four random 32-bit words
+    /// </returns>
+    std::array<std::uint32_t, 4> Philox4x32(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key);
+
+    /// <summary>
+    /// point sets available to monteCarloIntegral
+    /// </summary>
+    enum class PointSet {
+        Philox,
+        Sobol,
+        Lattice
+    };
+
+    /// <summary>
+    /// generator of points in the unit cube [0, 1)^dim. Fill writes a block of points in dimension-major order
+    /// (out[d * count + k] is coordinate d of point first + k), so every coordinate is a contiguous array and the
+    /// loops generating and consuming it can be vectorized. Points depend only on their index, never on the block split.
+    /// </summary>
+    class UnitCubePoints
+    {
+    public:
+        virtual ~UnitCubePoints() = default;
+
+        /// <summary>
+        /// returns the dimension of the points
+        /// </summary>
+        virtual std::size_t dimension() const = 0;
+
+        /// <summary>
+        /// writes points first .. first + count - 1 to out, which must hold dimension() * count values
+        /// </summary>
+        virtual void Fill(std::uint64_t first, std::size_t count, double* out) const = 0;
+    };
+
+    /// <summary>
+    /// pseudo-random points: coordinate d of point i is taken from the Philox counter (i, d / 2, stream), so every
+    /// point can be generated independently of all others
+    /// </summary>
+    class PhiloxPoints : public UnitCubePoints
+    {
+        std::size_t dim;
+        std::array<std::uint32_t, 2> key;
+        std::uint32_t stream;
+
+    public:
+        /// <summary>
+        /// creates the point stream of a seed
+        /// </summary>
+        /// <param name="dimension">
+        /// dimension of the points
+        /// </param>
+        /// <param name="seed">
+        /// seed of the generator
+        /// </param>
+        /// <param name="streamId">
+        /// independent stream selected within the seed
+        /// </param>
+        PhiloxPoints(std::size_t dimension, std::uint64_t seed, std::uint32_t streamId = 0);
+
+        std::size_t dimension() const override { return dim; }
+        void Fill(std::uint64_t first, std::size_t count, double* out) const override;
+    };
+
+    /// <summary>
+    /// Sobol low-discrepancy sequence with optional random linear scrambling and digital shift (Matousek).
+    /// Directions are built from primitive polynomials over GF(2) taken in order of degree; the initial direction
+    /// numbers are drawn from a fixed Philox stream, so any dimension is supported without a precomputed table.
+    /// </summary>
+    class SobolPoints : public UnitCubePoints
+    {
+        std::size_t dim;
+        std::vector<std::uint32_t> directions;
+        std::vector<std::uint32_t> shifts;
+
+    public:
+        /// <summary>
+        /// creates the sequence
+        /// </summary>
+        /// <param name="dimension">
+        /// dimension of the points
+        /// </param>
+        /// <param name="scramble">
+        /// if true the sequence is randomized with the seed, otherwise the plain sequence is produced
+        /// </param>
+        /// <param name="seed">
+        /// seed of the scrambling
+        /// </param>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if dimension is 0
+        /// </exception>
+        SobolPoints(std::size_t dimension, bool scramble = true, std::uint64_t seed = 0);
+
+        std::size_t dimension() const override { return dim; }
+        void Fill(std::uint64_t first, std::size_t count, double* out) const override;
+    };
+
+    /// <summary>
+    /// extensible rank-1 lattice sequence with an optional random shift. Point i is frac(phi(i) * z + shift), where phi is
+    /// the base-2 radical inverse, so the first 2^m points always form a complete lattice with 2^m points.
+    /// The generating vector is a Korobov vector (1, a, a^2, ...) whose parameter a minimizes the weighted P2
+    /// criterion over a fixed set of candidates.
+    /// </summary>
+    class LatticePoints : public UnitCubePoints
+    {
+        std::size_t dim;
+        std::vector<std::uint32_t> generator;
+        std::vector<std::uint32_t> shifts;
+
+    public:
+        /// <summary>
+        /// creates the lattice sequence
+        /// </summary>
+        /// <param name="dimension">
+        /// dimension of the points
+        /// </param>
+        /// <param name="shift">
+        /// if true the lattice is shifted randomly with the seed
+        /// </param>
+        /// <param name="seed">
+        /// seed of the shift
+        /// </param>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if dimension is 0
+        /// </exception>
+        LatticePoints(std::size_t dimension, bool shift = true, std::uint64_t seed = 0);
+
+        std::size_t dimension() const override { return dim; }
+        void Fill(std::uint64_t first, std::size_t count, double* out) const override;
+
+        /// <summary>
+        /// returns the generating vector z
+        /// </summary>
+        const std::vector<std::uint32_t>& GeneratingVector() const { return generator; }
+    };
+
+    /// <summary>
+    /// creates the randomized generator of one replication
+    /// </summary>
+    /// <param name="set">
+    /// type of point set
+    /// </param>
+    /// <param name="dimension">
+    /// dimension of the points
+    /// </param>
+    /// <param name="seed">
+    /// seed shared by all replications
+    /// </param>
+    /// <param name="replication">
+    /// index of the replication; different replications are independent randomizations
+    /// </param>
+    std::unique_ptr<UnitCubePoints> MakeUnitCubePoints(PointSet set, std::size_t dimension, std::uint64_t seed, std::uint32_t replication);
+
+    /// <summary>
+    /// settings of monteCarloIntegral
+    /// </summary>
+    struct MonteCarloOptions {
+        /// <summary>
+        /// point set used by every replication
+        /// </summary>
+        PointSet points = PointSet::Sobol;
+
+        /// <summary>
+        /// seed of the randomization; equal seeds give bit-identical results for any thread count
+        /// </summary>
+        std::uint64_t seed = 0;
+
+        /// <summary>
+        /// number of independent randomizations; the spread of their estimates gives the error estimate
+        /// </summary>
+        int replications = 8;
+
+        /// <summary>
+        /// points per replication in the first round, rounded up to a power of two
+        /// </summary>
+        std::size_t minPoints = 1024;
+
+        /// <summary>
+        /// maximum points per replication; the point count doubles every round until the tolerance is met, and the last
+        /// round uses the largest power of two not above maxPoints, or the rounded minPoints if that is larger
+        /// </summary>
+        std::size_t maxPoints = std::size_t(1) << 20;
+
+        /// <summary>
+        /// absolute error tolerance for early stopping
+        /// </summary>
+        double absTol = 1e-4;
+
+        /// <summary>
+        /// relative error tolerance for early stopping
+        /// </summary>
+        double relTol = 0.0;
+
+        /// <summary>
+        /// maximum number of threads, 0 uses all threads of the shared pool
+        /// </summary>
+        unsigned threads = 0;
+    };
+
+    /// <summary>
+    /// result of a Monte Carlo integration
+    /// </summary>
+    struct MonteCarloResult {
+        double value = 0.0;
+        double error = 0.0;
+        double variance = 0.0;
+        std::size_t evaluations = 0;
+        bool converged = false;
+    };
+
+    /// <summary>
+    /// computes the integral of a function over a box with (quasi-)Monte Carlo sampling.
+    /// Several independently randomized replications of the point set are evaluated in parallel blocks; the integral is
+    /// the mean of the replication estimates and the error is their standard error. The number of points per replication
+    /// doubles, continuing the sequences, until the error meets max(absTol, relTol * |result|) or maxPoints is reached.
+    /// Block sums are reduced in a fixed order, so the result depends only on the seed and not on the thread count.
+    /// </summary>
+    /// <typeparam name="Func">
+    /// callable double(const std::vector<double>&) taking a point of the box; it is called from several threads at once
+    /// </typeparam>
+    /// <param name="lower">
+    /// lower corner of the box
+    /// </param>
+    /// <param name="upper">
+    /// upper corner of the box
+    /// </param>
+    /// <param name="func">
+    /// function to be integrated
+    /// </param>
+    /// <param name="options">
+    /// point set, seed, replications, point counts, tolerances and thread count
+    /// </param>
+    /// <returns>
+    /// integral, standard error, variance of the replication estimates, number of evaluations and whether the tolerance was met
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if the box is malformed, fewer than two replications are requested, minPoints is 0 or maxPoints is less
+    /// than minPoints
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    MonteCarloResult monteCarloIntegral(const std::vector<double>& lower, const std::vector<double>& upper, Func func, const MonteCarloOptions& options = {}) {
+        if (lower.empty() || lower.size() != upper.size())
+            throw std::invalid_argument("Lower and upper bounds must have the same non-zero dimension.");
+        if (options.replications < 2)
+            throw std::invalid_argument("At least two replications are needed for an error estimate");
+        if (options.minPoints == 0)
+            throw std::invalid_argument("Minimum number of points must be greater than 0");
+        if (options.maxPoints < options.minPoints)
+            throw std::invalid_argument("Maximum number of points must not be less than the minimum number of points.");
+
+        const std::size_t dim = lower.size();
+        std::vector<double> width(dim);
+        double volume = 1.0;
+        for (std::size_t d = 0; d < dim; d++) {
+            if (lower[d] >= upper[d])
+                throw std::invalid_argument("Range start must be less than range end.");
+            width[d] = upper[d] - lower[d];
+            volume *= width[d];
+        }
+
+        const std::size_t replications = static_cast<std::size_t>(options.replications);
+        std::vector<std::unique_ptr<UnitCubePoints>> generators;
+        for (std::size_t r = 0; r < replications; r++) {
+            generators.push_back(MakeUnitCubePoints(options.points, dim, options.seed, static_cast<std::uint32_t>(r)));
+        }
+
+        // Point counts are powers of two so every round ends on a complete net or lattice.
+        std::size_t points = 1;
+        while (points < options.minPoints) points *= 2;
+        std::size_t maxPoints = points;
+        while (maxPoints <= options.maxPoints / 2) maxPoints *= 2;
+
+        std::vector<NeumaierSum> sums(replications);
+        MonteCarloResult result;
+        std::size_t done = 0;
+
+        while (true) {
+            const std::size_t blocksPerReplication = (points - done + parallel::BlockSize - 1) / parallel::BlockSize;
+            const std::size_t blocks = blocksPerReplication * replications;
+            std::vector<double> blockSums(blocks);
+
+            parallel::ForEachBlock(blocks, [&](std::size_t block) {
+                std::vector<double> buffer(dim * parallel::BlockSize);
+                std::vector<double> x(dim);
+                const std::size_t r = block / blocksPerReplication;
+                const std::size_t first = done + (block % blocksPerReplication) * parallel::BlockSize;
+                const std::size_t count = std::min(parallel::BlockSize, points - first);
+                generators[r]->Fill(first, count, buffer.data());
+
+                NeumaierSum sum;
+                for (std::size_t k = 0; k < count; k++) {
+                    for (std::size_t d = 0; d < dim; d++) {
+                        x[d] = lower[d] + width[d] * buffer[d * count + k];
+                    }
+                    const double y = func(x);
+                    if (!std::isfinite(y))
+                        throw std::domain_error("Function evaluation returned non-finite value.");
+                    sum.Add(y);
+                }
+                blockSums[block] = sum.Value();
+                }, options.threads);
+
+            for (std::size_t r = 0; r < replications; r++) {
+                sums[r].Add(pairwiseSum(blockSums.data() + r * blocksPerReplication, blocksPerReplication));
+            }
+            done = points;
+
+            RunningVariance estimates;
+            for (std::size_t r = 0; r < replications; r++) {
+                estimates.Add(volume * sums[r].Value() / static_cast<double>(points));
+            }
+            result.value = estimates.mean;
+            result.variance = estimates.Variance();
+            result.error = std::sqrt(result.variance / static_cast<double>(replications));
+            result.evaluations = points * replications;
+            result.converged = result.error <= std::max(options.absTol, options.relTol * std::abs(result.value));
+
+            if (result.converged || points >= maxPoints) break;
+            points *= 2;
+        }
+
+        return result;
+    }
+
+} // namespace NumericLib
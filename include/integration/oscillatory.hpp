@@ -0,0 +1,365 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numbers>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+#include "integration/integrand.hpp"
+#include "integration/gauss_kronrod.hpp"
+#include "integration/gauss_legendre.hpp"
+#include "interpolation/chebyshev.hpp"
+#include "liniear_systems/gauss_elimination.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// oscillatory factor multiplying the smooth part of the integrand
+    /// </summary>
+    enum class OscillatoryKernel {
+        Sine,
+        Cosine
+    };
+
+    /// <summary>
+    /// degree of the Chebyshev interpolant of the smooth part on every Filon panel; the error estimate compares it with
+    /// the interpolant of half the degree on every other node. It must be a power of two for ChebyshevTransform.
+    /// </summary>
+    constexpr int FilonPanelDegree = 32;
+
+    /// <summary>
+    /// degree of the Levin collocation polynomial on every panel, a power of two
+    /// </summary>
+    constexpr int LevinPanelDegree = 16;
+
+    /// <summary>
+    /// computes the modified moments integral of T_k(t) exp(i kappa t) over [-1, 1] for k = 0..n.
+    /// While |kappa| > n the three-term recurrence obtained by integrating T_k by parts is stable in the forward direction;
+    /// for slower oscillation the moments are computed with a Gauss-Legendre rule that resolves the whole product.
+    /// </summary>
+    inline std::vector<std::complex<double>> chebyshevFourierMoments(int n, double kappa) {
+        const std::complex<double> i(0.0, 1.0);
+        std::vector<std::complex<double>> moments(n + 1);
+
+        if (std::abs(kappa) <= n) {
+            const GaussLegendreRule& rule = getGLRule(n + static_cast<int>(std::abs(kappa)) + 16);
+            for (std::size_t j = 0; j < rule.nodes.size(); j++) {
+                const double t = rule.nodes[j];
+                const std::complex<double> weight = rule.weights[j] * std::exp(i * kappa * t);
+                double previous = 1.0, current = t;
+                moments[0] += weight;
+                if (n > 0) moments[1] += weight * t;
+                for (int k = 2; k <= n; k++) {
+                    const double next = 2.0 * t * current - previous;
+                    previous = current;
+                    current = next;
+                    moments[k] += weight * current;
+                }
+            }
+            return moments;
+        }
+
+        // B[m] = [T_m(t) exp(i kappa t)] between -1 and 1, the boundary term of integrating T_m' by parts.
+        const std::complex<double> upper = std::exp(i * kappa), lower = std::exp(-i * kappa);
+        auto boundary = [&](int m) { return m % 2 == 0 ? upper - lower : upper + lower; };
+
+        moments[0] = 2.0 * std::sin(kappa) / kappa;
+        if (n > 0) moments[1] = 2.0 * i * (std::sin(kappa) - kappa * std::cos(kappa)) / (kappa * kappa);
+        if (n > 1) moments[2] = (boundary(2) - 4.0 * moments[1]) / (i * kappa);
+        for (int k = 2; k < n; k++) {
+            // T_k = T'_(k+1) / (2 (k + 1)) - T'_(k-1) / (2 (k - 1)), integrated against exp(i kappa t).
+            const std::complex<double> lowerTerm = (boundary(k - 1) - i * kappa * moments[k - 1]) / (2.0 * (k - 1));
+            moments[k + 1] = (boundary(k + 1) - 2.0 * (k + 1) * (moments[k] + lowerTerm)) / (i * kappa);
+        }
+        return moments;
+    }
+
+    /// <summary>
+    /// samples func at the Chebyshev extrema of [a, b], ordered as t_j = cos(j pi / n)
+    /// </summary>
+    template <typename Func>
+    std::vector<double> sampleChebyshevExtrema(const Func& func, double a, double b, int n) {
+        const double half = (b - a) / 2.0, mid = (a + b) / 2.0;
+        std::vector<double> values(n + 1);
+        evaluateNodes(func, 0, values.size(), [&](std::size_t j) { return mid + half * std::cos(std::numbers::pi * static_cast<double>(j) / n); },
+            [&](std::size_t j, double y) {
+                if (!std::isfinite(y))
+                    throw std::domain_error("Function evaluation returned non-finite value.");
+                values[j] = y;
+            });
+        return values;
+    }
+
+    /// <summary>
+    /// globally adaptive bisection driven by a panel rule returning a GaussKronrodEstimate; the panel with the largest
+    /// error estimate is split until the total meets max(absTol, relTol * |result|) or maxIntervals is reached
+    /// </summary>
+    template <typename Panel>
+    AdaptiveIntegrationResult oscillatoryAdaptive(double a, double b, Panel panel, int pointsPerPanel, double absTol, double relTol,
+        int maxIntervals) {
+        if (absTol <= 0 && relTol <= 0)
+            throw std::invalid_argument("At least one tolerance must be positive");
+        if (maxIntervals <= 0)
+            throw std::invalid_argument("Maximum number of intervals must be greater than 0");
+
+        struct Segment {
+            double a, b, value, error;
+            bool operator<(const Segment& other) const { return error < other.error; }
+        };
+
+        AdaptiveIntegrationResult result;
+        const GaussKronrodEstimate whole = panel(a, b);
+        std::priority_queue<Segment> segments;
+        segments.push({ a, b, whole.value, whole.error });
+        result.value = whole.value;
+        result.error = whole.error;
+        result.evaluations = pointsPerPanel;
+
+        while (result.error > std::max(absTol, relTol * std::abs(result.value)) && static_cast<int>(segments.size()) < maxIntervals) {
+            const Segment worst = segments.top();
+            const double mid = (worst.a + worst.b) / 2.0;
+            if (mid == worst.a || mid == worst.b) break;
+            segments.pop();
+
+            const GaussKronrodEstimate left = panel(worst.a, mid);
+            const GaussKronrodEstimate right = panel(mid, worst.b);
+            segments.push({ worst.a, mid, left.value, left.error });
+            segments.push({ mid, worst.b, right.value, right.error });
+
+            result.value += left.value + right.value - worst.value;
+            result.error += left.error + right.error - worst.error;
+            result.evaluations += 2 * pointsPerPanel;
+        }
+
+        result.intervals = static_cast<int>(segments.size());
+        result.value = 0.0;
+        result.error = 0.0;
+        while (!segments.empty()) {
+            result.value += segments.top().value;
+            result.error += segments.top().error;
+            segments.pop();
+        }
+        result.converged = result.error <= std::max(absTol, relTol * std::abs(result.value));
+        return result;
+    }
+
+    /// <summary>
+    /// computes the integral of f(x) sin(omega x) or f(x) cos(omega x) over [a, b] with adaptive Filon-Clenshaw-Curtis
+    /// quadrature. On every panel f is interpolated at the Chebyshev extrema and the product of the interpolant with the
+    /// oscillatory factor is integrated exactly, so only the smooth part is sampled and the number of function
+    /// evaluations does not grow with omega.
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the smooth part of the integrand: callable double(double) or BatchIntegrand
+    /// </typeparam>
+    /// <param name="a">
+    /// lower limit of the integral
+    /// </param>
+    /// <param name="b">
+    /// upper limit of the integral
+    /// </param>
+    /// <param name="func">
+    /// smooth part f of the integrand
+    /// </param>
+    /// <param name="omega">
+    /// angular frequency of the oscillatory factor, any value including 0
+    /// </param>
+    /// <param name="kernel">
+    /// oscillatory factor, sin(omega x) or cos(omega x)
+    /// </param>
+    /// <param name="absTol">
+    /// absolute error tolerance
+    /// </param>
+    /// <param name="relTol">
+    /// relative error tolerance
+    /// </param>
+    /// <param name="maxIntervals">
+    /// maximum number of panels
+    /// </param>
+    /// <returns>
+    /// integral, error estimate, number of function evaluations and whether the tolerance was met
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if both tolerances are non-positive or maxIntervals is not positive
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    AdaptiveIntegrationResult filonIntegral(double a, double b, Func func, double omega, OscillatoryKernel kernel = OscillatoryKernel::Sine,
+        double absTol = 1e-10, double relTol = 1e-10, int maxIntervals = 100) {
+        auto panel = [&](double left, double right) -> GaussKronrodEstimate {
+            const double half = (right - left) / 2.0, mid = (left + right) / 2.0;
+            const std::vector<double> values = sampleChebyshevExtrema(func, left, right, FilonPanelDegree);
+            const std::vector<std::complex<double>> moments = chebyshevFourierMoments(FilonPanelDegree, omega * half);
+            const std::complex<double> factor = half * std::exp(std::complex<double>(0.0, omega * mid));
+
+            double estimates[2];
+            for (int pass = 0; pass < 2; pass++) {
+                const std::vector<double> coefficients = ChebyshevTransform(values, pass == 0 ? 1 : 2);
+                std::complex<double> sum = 0.0;
+                for (std::size_t k = 0; k < coefficients.size(); k++) {
+                    sum += coefficients[k] * moments[k];
+                }
+                sum *= factor;
+                estimates[pass] = kernel == OscillatoryKernel::Sine ? sum.imag() : sum.real();
+            }
+            return { estimates[0], std::abs(estimates[0] - estimates[1]) };
+        };
+        return oscillatoryAdaptive(a, b, panel, FilonPanelDegree + 1, absTol, relTol, maxIntervals);
+    }
+
+    /// <summary>
+    /// solves the Levin collocation problem p'(x) + i omega g'(x) p(x) = f(x) on [a, b] at the Chebyshev extrema, using
+    /// every stride-th sample, and returns p(b) exp(i omega g(b)) - p(a) exp(i omega g(a)), which approximates the integral
+    /// of f(x) exp(i omega g(x)) over [a, b]
+    /// </summary>
+    inline std::complex<double> levinPanel(double a, double b, const std::vector<double>& values, const std::vector<double>& slopes,
+        double omega, double phaseA, double phaseB, std::size_t stride) {
+        const std::size_t n = (values.size() - 1) / stride;
+        const std::size_t size = 2 * (n + 1);
+        const double half = (b - a) / 2.0;
+
+        // Unknowns are the Chebyshev coefficients of the real part u and imaginary part v of p:
+        // u' - omega g' v = f and v' + omega g' u = 0 at every collocation point.
+        std::vector<std::vector<double>> A(size, std::vector<double>(size, 0.0));
+        std::vector<double> rhs(size, 0.0);
+        for (std::size_t j = 0; j <= n; j++) {
+            const double t = std::cos(std::numbers::pi * static_cast<double>(j) / n);
+            const double coupling = omega * slopes[j * stride];
+            double previous = 1.0, current = t;
+            double uPrevious = 0.0, uCurrent = 1.0;
+            for (std::size_t k = 0; k <= n; k++) {
+                // T_k(t) and T'_k(t) = k U_(k-1)(t), advanced by the Chebyshev recurrences.
+                double value, derivative;
+                if (k == 0) {
+                    value = 1.0;
+                    derivative = 0.0;
+                }
+                else {
+                    value = current;
+                    derivative = k * uCurrent / half;
+                    const double next = 2.0 * t * current - previous;
+                    previous = current;
+                    current = next;
+                    const double uNext = 2.0 * t * uCurrent - uPrevious;
+                    uPrevious = uCurrent;
+                    uCurrent = uNext;
+                }
+                A[j][k] = derivative;
+                A[j][n + 1 + k] = -coupling * value;
+                A[n + 1 + j][k] = coupling * value;
+                A[n + 1 + j][n + 1 + k] = derivative;
+            }
+            rhs[j] = values[j * stride];
+        }
+
+        const std::vector<double> solution = GaussElimination(A, rhs);
+        std::complex<double> atA = 0.0, atB = 0.0;
+        for (std::size_t k = 0; k <= n; k++) {
+            const std::complex<double> coefficient(solution[k], solution[n + 1 + k]);
+            atB += coefficient;
+            atA += k % 2 == 0 ? coefficient : -coefficient;
+        }
+        const std::complex<double> i(0.0, 1.0);
+        return atB * std::exp(i * omega * phaseB) - atA * std::exp(i * omega * phaseA);
+    }
+
+    /// <summary>
+    /// computes the integral of f(x) sin(omega g(x)) or f(x) cos(omega g(x)) over [a, b] with adaptive Levin collocation.
+    /// On every panel the antiderivative is sought in the form p(x) exp(i omega g(x)) with a Chebyshev polynomial p, so
+    /// only f and g' are sampled and the cost does not grow with omega. Panels over which the phase changes by less than
+    /// one radian are not oscillatory; there the product is integrated as a Chebyshev series instead.
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the smooth part of the integrand: callable double(double) or BatchIntegrand
+    /// </typeparam>
+    /// <typeparam name="Phase">
+    /// template type for the phase g and its derivative, which should accept a double and return a double
+    /// </typeparam>
+    /// <param name="a">
+    /// lower limit of the integral
+    /// </param>
+    /// <param name="b">
+    /// upper limit of the integral
+    /// </param>
+    /// <param name="func">
+    /// smooth part f of the integrand
+    /// </param>
+    /// <param name="phase">
+    /// smooth phase g; g' must not vanish on [a, b] (no stationary points)
+    /// </param>
+    /// <param name="phaseDerivative">
+    /// derivative g' of the phase
+    /// </param>
+    /// <param name="omega">
+    /// frequency multiplying the phase
+    /// </param>
+    /// <param name="kernel">
+    /// oscillatory factor, sin(omega g(x)) or cos(omega g(x))
+    /// </param>
+    /// <param name="absTol">
+    /// absolute error tolerance
+    /// </param>
+    /// <param name="relTol">
+    /// relative error tolerance
+    /// </param>
+    /// <param name="maxIntervals">
+    /// maximum number of panels
+    /// </param>
+    /// <returns>
+    /// integral, error estimate, number of evaluations of f and whether the tolerance was met
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if both tolerances are non-positive or maxIntervals is not positive
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func, typename Phase, typename PhaseDerivative>
+    AdaptiveIntegrationResult levinIntegral(double a, double b, Func func, Phase phase, PhaseDerivative phaseDerivative, double omega,
+        OscillatoryKernel kernel = OscillatoryKernel::Sine, double absTol = 1e-10, double relTol = 1e-10, int maxIntervals = 100) {
+        auto panel = [&](double left, double right) -> GaussKronrodEstimate {
+            const double half = (right - left) / 2.0, mid = (left + right) / 2.0;
+            auto node = [&](std::size_t j) { return mid + half * std::cos(std::numbers::pi * static_cast<double>(j) / LevinPanelDegree); };
+            const double phaseA = phase(left), phaseB = phase(right);
+            const std::vector<double> values = sampleChebyshevExtrema(func, left, right, LevinPanelDegree);
+
+            std::complex<double> estimates[2];
+            if (std::abs(omega * (phaseB - phaseA)) < 1.0) {
+                // Chebyshev series of f(x) exp(i omega g(x)), integrated term by term.
+                std::vector<double> re(values.size()), im(values.size());
+                for (std::size_t j = 0; j < values.size(); j++) {
+                    const double x = node(j);
+                    re[j] = values[j] * std::cos(omega * phase(x));
+                    im[j] = values[j] * std::sin(omega * phase(x));
+                }
+                for (int pass = 0; pass < 2; pass++) {
+                    const std::vector<double> cr = ChebyshevTransform(re, pass + 1), ci = ChebyshevTransform(im, pass + 1);
+                    std::complex<double> sum = 0.0;
+                    for (std::size_t k = 0; k < cr.size(); k += 2) {
+                        sum += std::complex<double>(cr[k], ci[k]) * (2.0 / (1.0 - static_cast<double>(k * k)));
+                    }
+                    estimates[pass] = half * sum;
+                }
+            }
+            else {
+                std::vector<double> slopes(values.size());
+                for (std::size_t j = 0; j < values.size(); j++) {
+                    slopes[j] = phaseDerivative(node(j));
+                }
+                for (int pass = 0; pass < 2; pass++) {
+                    estimates[pass] = levinPanel(left, right, values, slopes, omega, phaseA, phaseB, pass + 1);
+                }
+            }
+
+            const double fine = kernel == OscillatoryKernel::Sine ? estimates[0].imag() : estimates[0].real();
+            const double coarse = kernel == OscillatoryKernel::Sine ? estimates[1].imag() : estimates[1].real();
+            return { fine, std::abs(fine - coarse) };
+        };
+        return oscillatoryAdaptive(a, b, panel, LevinPanelDegree + 1, absTol, relTol, maxIntervals);
+    }
+
+} // namespace NumericLib
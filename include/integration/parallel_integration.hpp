@@ -0,0 +1,309 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "integration/integrand.hpp"
+#include "integration/gauss_legendre.hpp"
+#include "parallel.hpp"
+#include "summation.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// settings of the multithreaded integration rules
+    /// </summary>
+    struct ParallelIntegrationOptions {
+        /// <summary>
+        /// maximum number of threads, 0 uses all threads of the pool
+        /// </summary>
+        unsigned threads = 0;
+
+        /// <summary>
+        /// number of nodes evaluated per block, 0 selects it from the number of nodes
+        /// </summary>
+        std::size_t grainSize = 0;
+
+        /// <summary>
+        /// if true every block is summed separately and the block sums are reduced in a fixed order,
+        /// so the result is bit-identical for any number of threads
+        /// </summary>
+        bool deterministic = false;
+
+        /// <summary>
+        /// pool running the blocks, nullptr uses parallel::ThreadPool::Shared()
+        /// </summary>
+        parallel::ThreadPool* pool = nullptr;
+    };
+
+    /// <summary>
+    /// smallest number of nodes per block chosen by the grain heuristic
+    /// </summary>
+    constexpr std::size_t MinIntegrationGrain = 1024;
+
+    /// <summary>
+    /// largest number of blocks chosen by the grain heuristic
+    /// </summary>
+    constexpr std::size_t MaxIntegrationBlocks = 4096;
+
+    /// <summary>
+    /// minimum estimated work in seconds given to each thread; cheaper integrals run on fewer threads or serially
+    /// </summary>
+    constexpr double MinIntegrationTaskSeconds = 50e-6;
+
+    /// <summary>
+    /// computes sum(weightAt(i) * func(nodeAt(i))) for i in [0, n) on a thread pool.
+    /// The nodes are split into blocks; the first block is timed on the calling thread and the remaining blocks are
+    /// only spread over as many threads as the measured cost justifies. Every thread keeps a compensated partial sum,
+    /// and the partial sums are combined by pairwise summation.
+    /// </summary>
+    /// <typeparam name="Func">
+    /// scalar callable double(double) or BatchIntegrand; it is called from several threads at once
+    /// </typeparam>
+    /// <typeparam name="NodeAt">
+    /// callable returning the i-th node
+    /// </typeparam>
+    /// <typeparam name="WeightAt">
+    /// callable returning the weight of the i-th node
+    /// </typeparam>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func, typename NodeAt, typename WeightAt>
+    double parallelWeightedSum(const Func& func, std::size_t n, NodeAt nodeAt, WeightAt weightAt, const ParallelIntegrationOptions& options) {
+        if (n == 0) return 0.0;
+
+        // The grain depends only on n, so the blocks (and the deterministic result) do not change with the thread count.
+        const std::size_t grain = options.grainSize > 0 ? options.grainSize
+            : std::max(MinIntegrationGrain, (n + MaxIntegrationBlocks - 1) / MaxIntegrationBlocks);
+        const std::size_t blocks = (n + grain - 1) / grain;
+
+        auto sumBlock = [&](std::size_t block) {
+            NeumaierSum sum;
+            evaluateNodes(func, block * grain, std::min(n, (block + 1) * grain), nodeAt, [&](std::size_t i, double y) {
+                if (!std::isfinite(y))
+                    throw std::domain_error("Function evaluation returned non-finite value.");
+                sum.Add(weightAt(i) * y);
+                });
+            return sum;
+            };
+
+        const auto start = std::chrono::steady_clock::now();
+        const NeumaierSum first = sumBlock(0);
+        const double blockSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        parallel::ThreadPool& pool = options.pool ? *options.pool : parallel::ThreadPool::Shared();
+        const std::size_t remaining = blocks - 1;
+        std::size_t tasks = std::min<std::size_t>(options.threads > 0 ? options.threads : pool.size(), remaining);
+        tasks = std::min(tasks, static_cast<std::size_t>(blockSeconds * remaining / MinIntegrationTaskSeconds));
+        tasks = std::max<std::size_t>(tasks, 1);
+
+        std::atomic<std::size_t> nextBlock{ 1 };
+
+        if (options.deterministic) {
+            std::vector<double> blockSums(blocks);
+            blockSums[0] = first.Value();
+            auto work = [&](std::size_t) {
+                for (std::size_t block = nextBlock++; block < blocks; block = nextBlock++) {
+                    blockSums[block] = sumBlock(block).Value();
+                }
+                };
+            if (tasks == 1) work(0);
+            else pool.Run(tasks, work);
+            return pairwiseSum(blockSums.data(), blocks);
+        }
+
+        std::vector<NeumaierSum> partials(tasks);
+        partials[0] = first;
+        auto work = [&](std::size_t task) {
+            for (std::size_t block = nextBlock++; block < blocks; block = nextBlock++) {
+                partials[task].Merge(sumBlock(block));
+            }
+            };
+        if (tasks == 1) work(0);
+        else pool.Run(tasks, work);
+
+        std::vector<double> values(tasks);
+        for (std::size_t t = 0; t < tasks; t++) {
+            values[t] = partials[t].Value();
+        }
+        return pairwiseSum(values.data(), tasks);
+    }
+
+    /// <summary>
+    /// multithreaded counterpart of Rect
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated; it is called from several threads at once
+    /// </typeparam>
+    /// <param name="step">
+    /// number of rectangles,steps to use for the approximation
+    /// </param>
+    /// <param name="func">
+    /// callable double(double) to integrate, or a BatchIntegrand
+    /// </param>
+    /// <param name="range">
+    /// vector of two doubles [a , b] representing the start and end of integration
+    /// </param>
+    /// <param name="options">
+    /// thread count, grain size and reproducibility settings
+    /// </param>
+    /// <returns>
+    /// calculated approximation of the integral of the function over the specified range
+    /// </returns>
+    /// @exception std::invalid_argument thrown if the input range does not contain exactly two elements in the correct order
+    /// @exception std::domain_error thrown if the function returns a non-finite value
+    template <typename Func>
+    double RectParallel(double step, Func func, const std::vector<double>& range, const ParallelIntegrationOptions& options = {})
+    {
+        if (range.size() != 2)
+            throw std::invalid_argument("Range vector must have exactly two elements.");
+        if (step <= 0)
+            throw std::invalid_argument("Step size must be positive.");
+        if (range[0] >= range[1])
+            throw std::invalid_argument("Range start must be less than range end.");
+
+        const double a = range[0];
+        const std::size_t n = static_cast<std::size_t>(std::ceil(step));
+        const double h = (range[1] - range[0]) / n;
+
+        return h * parallelWeightedSum(func, n, [a, h](std::size_t i) { return a + i * h; }, [](std::size_t) { return 1.0; }, options);
+    }
+
+    /// <summary>
+    /// multithreaded counterpart of Trapezoids
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated; it is called from several threads at once
+    /// </typeparam>
+    /// <param name="step">
+    /// number of trapezoids to use for the approximation
+    /// </param>
+    /// <param name="func">
+    /// callable double(double) to integrate, or a BatchIntegrand
+    /// </param>
+    /// <param name="range">
+    /// vector of two doubles [a , b] representing the start and end of integration
+    /// </param>
+    /// <param name="options">
+    /// thread count, grain size and reproducibility settings
+    /// </param>
+    /// <returns>
+    /// calculated approximation of the integral of the function over the specified range
+    /// </returns>
+    /// @exception std::invalid_argument thrown if the input range does not contain exactly two elements in the correct order
+    /// @exception std::domain_error thrown if the function returns a non-finite value
+    template <typename Func>
+    double TrapezoidsParallel(double step, Func func, const std::vector<double>& range, const ParallelIntegrationOptions& options = {})
+    {
+        if (range.size() != 2)
+            throw std::invalid_argument("Range vector must have exactly two elements.");
+        if (step <= 0)
+            throw std::invalid_argument("Step size must be positive.");
+        if (range[0] >= range[1])
+            throw std::invalid_argument("Range start must be less than range end.");
+
+        const double a = range[0], b = range[1];
+        const std::size_t n = static_cast<std::size_t>(std::ceil(step));
+        const double h = (b - a) / n;
+
+        return h * parallelWeightedSum(func, n + 1, [a, b, h, n](std::size_t i) { return i == n ? b : a + i * h; },
+            [n](std::size_t i) { return (i == 0 || i == n) ? 0.5 : 1.0; }, options);
+    }
+
+    /// <summary>
+    /// multithreaded counterpart of Simpson
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated; it is called from several threads at once
+    /// </typeparam>
+    /// <param name="split">
+    /// number of subintervals, rounded up to an even number
+    /// </param>
+    /// <param name="func">
+    /// callable double(double) to integrate, or a BatchIntegrand
+    /// </param>
+    /// <param name="range">
+    /// vector of two doubles [a , b] representing the start and end of integration
+    /// </param>
+    /// <param name="options">
+    /// thread count, grain size and reproducibility settings
+    /// </param>
+    /// <returns>
+    /// calculated approximation of the integral of the function over the specified range
+    /// </returns>
+    /// @exception std::invalid_argument thrown if the input range does not contain exactly two elements in the correct order
+    /// @exception std::domain_error thrown if the function returns a non-finite value
+    template <typename Func>
+    double SimpsonParallel(int split, Func func, const std::vector<double>& range, const ParallelIntegrationOptions& options = {})
+    {
+        if (range.size() != 2)
+            throw std::invalid_argument("Range vector must have exactly two elements.");
+        if (split <= 0)
+            throw std::invalid_argument("Number of splits must be positive.");
+        if (range[0] >= range[1])
+            throw std::invalid_argument("Range start must be less than range end.");
+
+        if (split % 2 == 1) split++;
+
+        const double a = range[0], b = range[1];
+        const std::size_t n = static_cast<std::size_t>(split);
+        const double h = (b - a) / (double)split;
+
+        return h / 3 * parallelWeightedSum(func, n + 1, [a, b, h, n](std::size_t i) { return i == n ? b : a + i * h; },
+            [n](std::size_t i) { return (i == 0 || i == n) ? 1.0 : (i % 2 == 0 ? 2.0 : 4.0); }, options);
+    }
+
+    /// <summary>
+    /// multithreaded counterpart of gaussLegendreIntegralSplit
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated; it is called from several threads at once
+    /// </typeparam>
+    /// <param name="a">
+    /// lower limit of the integral
+    /// </param>
+    /// <param name="b">
+    /// upper limit of the integral
+    /// </param>
+    /// <param name="func">
+    /// callable double(double) to integrate, or a BatchIntegrand
+    /// </param>
+    /// <param name="n">
+    /// number of nodes of the Gauss-Legendre rule applied to every subinterval
+    /// </param>
+    /// <param name="splits">
+    /// number of subintervals
+    /// </param>
+    /// <param name="options">
+    /// thread count, grain size and reproducibility settings
+    /// </param>
+    /// <returns>
+    /// total approximate value of the definite integral over [a, b]
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if splits or n is not positive
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    double gaussLegendreIntegralSplitParallel(double a, double b, Func func, int n, int splits, const ParallelIntegrationOptions& options = {}) {
+        if (splits <= 0) {
+            throw std::invalid_argument("Number of splits must be greater than 0");
+        }
+
+        const GaussLegendreRule& rule = getGLRule(n);
+        const std::size_t nodes = rule.nodes.size();
+        const double h = (b - a) / splits;
+
+        // Node i is node i % nodes of subinterval i / nodes, so the whole rule is a single weighted sum.
+        return (h / 2.0) * parallelWeightedSum(func, nodes * static_cast<std::size_t>(splits),
+            [&rule, nodes, a, h](std::size_t i) { return a + (i / nodes + 0.5) * h + (h / 2.0) * rule.nodes[i % nodes]; },
+            [&rule, nodes](std::size_t i) { return rule.weights[i % nodes]; }, options);
+    }
+
+} // namespace NumericLib
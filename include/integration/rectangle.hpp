@@ -1,18 +1,22 @@
 #pragma once
 #include <vector>
 #include <stdexcept>
-#include <vector>
 #include <cmath>
+#include <cstddef>
+#include "integration/integrand.hpp"
 
 namespace NumericLib {
     /// <summary>
     /// approximates the integral of a function using the rectangle method
     /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated, inlined by the compiler
+    /// </typeparam>
     /// <param name="step">
     /// number of rectangles,steps to use for the approximation
     /// </param>
     /// <param name="func">
-    /// double pointer to a function to integrate
+    /// callable double(double) to integrate, or a BatchIntegrand evaluated in blocks of nodes
     /// </param>
     /// <param name="range">
     /// vector of two doubles [a , b] representing the start and end of integration
@@ -20,6 +24,29 @@ namespace NumericLib {
     /// <returns>
     /// calculated approximation of the integral of the function over the specified range using the rectangle method
     /// </returns>
-    /// @exception std::invalid_argument thrown if the input range does not contain exactly two elements in the correct order 
-	double Rect(double step, double (*func)(double), const std::vector<double>& range);
+    /// @exception std::invalid_argument thrown if the input range does not contain exactly two elements in the correct order
+    /// @exception std::domain_error thrown if the function returns a non-finite value
+    template <typename Func>
+    double Rect(double step, Func func, const std::vector<double>& range)
+    {
+        if (range.size() != 2)
+            throw std::invalid_argument("Range vector must have exactly two elements.");
+        if (step <= 0)
+            throw std::invalid_argument("Step size must be positive.");
+        if (range[0] >= range[1])
+            throw std::invalid_argument("Range start must be less than range end.");
+
+        const double a = range[0];
+        const std::size_t n = static_cast<std::size_t>(std::ceil(step));
+        const double h = (range[1] - range[0]) / n;
+
+        double sum = 0;
+        evaluateNodes(func, 0, n, [a, h](std::size_t i) { return a + i * h; }, [&sum](std::size_t, double y) {
+            if (!std::isfinite(y))
+                throw std::domain_error("Function evaluation returned non-finite value.");
+            sum += y;
+            });
+
+        return sum * h;
+    }
 } // namespace NumericLib
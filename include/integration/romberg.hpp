@@ -0,0 +1,199 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "integration/integrand.hpp"
+#include "integration/gauss_kronrod.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// incrementally refined Romberg estimate of the integral of a function over [a, b].
+    /// Every refinement halves the trapezoid step, evaluates the function only at the new midpoints and extends the
+    /// Richardson extrapolation tableau by one row, so an existing estimate can be improved without recomputation.
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated: callable double(double) or BatchIntegrand
+    /// </typeparam>
+    template <typename Func>
+    class RombergRefinement
+    {
+        Func func;
+        double a;
+        double b;
+        std::size_t panels = 1;
+        int evaluations = 0;
+        std::vector<double> previousRow;
+        std::vector<double> currentRow;
+
+        double Checked(double y) {
+            if (!std::isfinite(y))
+                throw std::domain_error("Function evaluation returned non-finite value.");
+            return y;
+        }
+
+    public:
+        /// <summary>
+        /// computes the initial single-panel trapezoid estimate
+        /// </summary>
+        /// <param name="function">
+        /// function to be integrated
+        /// </param>
+        /// <param name="lower">
+        /// lower limit of the integral
+        /// </param>
+        /// <param name="upper">
+        /// upper limit of the integral
+        /// </param>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if lower is not less than upper
+        /// </exception>
+        /// <exception cref="std::domain_error">
+        /// thrown if the function returns a non-finite value
+        /// </exception>
+        RombergRefinement(Func function, double lower, double upper)
+            : func(function), a(lower), b(upper)
+        {
+            if (a >= b)
+                throw std::invalid_argument("Range start must be less than range end.");
+
+            const double sum = Checked(func(a)) + Checked(func(b));
+            evaluations = 2;
+            currentRow.push_back((b - a) * sum / 2.0);
+        }
+
+        /// <summary>
+        /// halves the step: evaluates the function at the midpoints of the current panels and adds a tableau row
+        /// </summary>
+        /// <exception cref="std::domain_error">
+        /// thrown if the function returns a non-finite value
+        /// </exception>
+        void Refine() {
+            const double h = (b - a) / panels;
+            const double lower = a;
+            double sum = 0.0;
+            evaluateNodes(func, 0, panels, [lower, h](std::size_t i) { return lower + (i + 0.5) * h; }, [&](std::size_t, double y) {
+                sum += Checked(y);
+                });
+            evaluations += static_cast<int>(panels);
+            panels *= 2;
+
+            previousRow.swap(currentRow);
+            currentRow.assign(previousRow.size() + 1, 0.0);
+            currentRow[0] = previousRow[0] / 2.0 + h * sum / 2.0;
+
+            double factor = 1.0;
+            for (std::size_t j = 1; j < currentRow.size(); j++) {
+                factor *= 4.0;
+                currentRow[j] = currentRow[j - 1] + (currentRow[j - 1] - previousRow[j - 1]) / (factor - 1.0);
+            }
+        }
+
+        /// <summary>
+        /// returns the most extrapolated value of the tableau
+        /// </summary>
+        double Estimate() const { return currentRow.back(); }
+
+        /// <summary>
+        /// returns the difference between the last two diagonal entries of the tableau, or infinity before the first refinement
+        /// </summary>
+        double ErrorEstimate() const {
+            if (previousRow.empty()) return std::numeric_limits<double>::infinity();
+            return std::abs(currentRow.back() - previousRow.back());
+        }
+
+        /// <summary>
+        /// returns the plain trapezoid estimate on the current grid
+        /// </summary>
+        double Trapezoid() const { return currentRow[0]; }
+
+        /// <summary>
+        /// returns the number of refinements done so far
+        /// </summary>
+        int Level() const { return static_cast<int>(currentRow.size()) - 1; }
+
+        /// <summary>
+        /// returns the number of trapezoid panels of the current grid
+        /// </summary>
+        std::size_t Panels() const { return panels; }
+
+        /// <summary>
+        /// returns the total number of function evaluations
+        /// </summary>
+        int Evaluations() const { return evaluations; }
+    };
+
+    /// <summary>
+    /// creates a RombergRefinement, deducing the function type
+    /// </summary>
+    template <typename Func>
+    RombergRefinement<Func> makeRombergRefinement(Func func, double a, double b) {
+        return RombergRefinement<Func>(func, a, b);
+    }
+
+    /// <summary>
+    /// minimum number of refinements before rombergIntegral accepts an error estimate, so a few coincidentally equal
+    /// coarse estimates do not stop the iteration
+    /// </summary>
+    constexpr int RombergMinLevel = 3;
+
+    /// <summary>
+    /// computes the definite integral of a function over [a, b] with Romberg integration.
+    /// The trapezoid grid is doubled, reusing all previous evaluations, until the difference between successive
+    /// extrapolated values meets max(absTol, relTol * |result|).
+    /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated: callable double(double) or BatchIntegrand
+    /// </typeparam>
+    /// <param name="a">
+    /// lower limit of the integral
+    /// </param>
+    /// <param name="b">
+    /// upper limit of the integral
+    /// </param>
+    /// <param name="func">
+    /// function to be integrated
+    /// </param>
+    /// <param name="absTol">
+    /// absolute error tolerance
+    /// </param>
+    /// <param name="relTol">
+    /// relative error tolerance
+    /// </param>
+    /// <param name="maxLevel">
+    /// maximum number of grid doublings
+    /// </param>
+    /// <returns>
+    /// integral, error estimate, number of function evaluations, number of panels and whether the tolerance was met
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if both tolerances are non-positive, maxLevel is not positive or a is not less than b
+    /// </exception>
+    /// <exception cref="std::domain_error">
+    /// thrown if the function returns a non-finite value
+    /// </exception>
+    template <typename Func>
+    AdaptiveIntegrationResult rombergIntegral(double a, double b, Func func, double absTol = 1e-10, double relTol = 1e-10, int maxLevel = 20) {
+        if (absTol <= 0 && relTol <= 0)
+            throw std::invalid_argument("At least one tolerance must be positive");
+        if (maxLevel <= 0)
+            throw std::invalid_argument("Maximum level must be greater than 0");
+
+        RombergRefinement<Func> romberg(func, a, b);
+        AdaptiveIntegrationResult result;
+
+        do {
+            romberg.Refine();
+            result.value = romberg.Estimate();
+            result.error = romberg.ErrorEstimate();
+            result.converged = romberg.Level() >= RombergMinLevel && result.error <= std::max(absTol, relTol * std::abs(result.value));
+        } while (!result.converged && romberg.Level() < maxLevel);
+
+        result.evaluations = romberg.Evaluations();
+        result.intervals = static_cast<int>(romberg.Panels());
+        return result;
+    }
+
+} // namespace NumericLib
@@ -0,0 +1,195 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "summation.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// integrates uniformly spaced samples with the trapezoid rule
+    /// </summary>
+    /// <param name="y">
+    /// function values at x0, x0 + dx, x0 + 2 dx, ...
+    /// </param>
+    /// <param name="dx">
+    /// spacing of the samples
+    /// </param>
+    /// <returns>
+    /// approximation of the integral over the sampled range
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if there are fewer than two samples or dx is not positive
+    /// </exception>
+    double TrapezoidsSampled(const std::vector<double>& y, double dx);
+
+    /// <summary>
+    /// integrates samples at arbitrary increasing abscissae with the trapezoid rule
+    /// </summary>
+    /// <param name="x">
+    /// increasing sample positions
+    /// </param>
+    /// <param name="y">
+    /// function values at the positions x
+    /// </param>
+    /// <returns>
+    /// approximation of the integral over [x.front(), x.back()]
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if x and y differ in size or there are fewer than two samples
+    /// </exception>
+    double TrapezoidsSampled(const std::vector<double>& x, const std::vector<double>& y);
+
+    /// <summary>
+    /// integrates uniformly spaced samples with Simpson's rule. For an odd number of intervals the last interval
+    /// uses the three-point correction of Cartwright, so the result stays fourth order.
+    /// </summary>
+    /// <param name="y">
+    /// function values at x0, x0 + dx, x0 + 2 dx, ...
+    /// </param>
+    /// <param name="dx">
+    /// spacing of the samples
+    /// </param>
+    /// <returns>
+    /// approximation of the integral over the sampled range
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if there are fewer than two samples or dx is not positive
+    /// </exception>
+    double SimpsonSampled(const std::vector<double>& y, double dx);
+
+    /// <summary>
+    /// integrates samples at arbitrary increasing abscissae with the non-uniform Simpson rule, fitting a parabola
+    /// through every pair of consecutive intervals
+    /// </summary>
+    /// <param name="x">
+    /// increasing sample positions
+    /// </param>
+    /// <param name="y">
+    /// function values at the positions x
+    /// </param>
+    /// <returns>
+    /// approximation of the integral over [x.front(), x.back()]
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if x and y differ in size or there are fewer than two samples
+    /// </exception>
+    double SimpsonSampled(const std::vector<double>& x, const std::vector<double>& y);
+
+    /// <summary>
+    /// computes the running trapezoid integral of uniformly spaced samples
+    /// </summary>
+    /// <param name="y">
+    /// function values at x0, x0 + dx, x0 + 2 dx, ...
+    /// </param>
+    /// <param name="dx">
+    /// spacing of the samples
+    /// </param>
+    /// <returns>
+    /// vector of the same size as y whose element i is the integral from the first sample to sample i
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if dx is not positive
+    /// </exception>
+    std::vector<double> CumulativeTrapezoids(const std::vector<double>& y, double dx);
+
+    /// <summary>
+    /// computes the running trapezoid integral of samples at arbitrary increasing abscissae
+    /// </summary>
+    /// <param name="x">
+    /// increasing sample positions
+    /// </param>
+    /// <param name="y">
+    /// function values at the positions x
+    /// </param>
+    /// <returns>
+    /// vector of the same size as y whose element i is the integral from x[0] to x[i]
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if x and y differ in size
+    /// </exception>
+    std::vector<double> CumulativeTrapezoids(const std::vector<double>& x, const std::vector<double>& y);
+
+    /// <summary>
+    /// integrates a series of samples that arrives in chunks, keeping only running sums and the last three samples.
+    /// Trapezoid and Simpson estimates of everything added so far are available at any time.
+    /// </summary>
+    class StreamingIntegrator
+    {
+        double dx;
+        NeumaierSum trapezoid;
+        NeumaierSum simpson;
+        std::size_t count = 0;
+
+        // The last three samples, most recent last; used to join chunks and for the odd-interval correction.
+        double lastX[3] = { 0.0, 0.0, 0.0 };
+        double lastY[3] = { 0.0, 0.0, 0.0 };
+
+        // Samples after the end of the last complete Simpson pair, including the point where the next pair starts.
+        std::size_t pending = 0;
+
+        void Push(double x, double y);
+        void AddChunk(const double* x, const double* y, std::size_t n);
+
+    public:
+        /// <summary>
+        /// creates an integrator for uniformly spaced samples
+        /// </summary>
+        /// <param name="spacing">
+        /// spacing of the samples
+        /// </param>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if spacing is not positive
+        /// </exception>
+        explicit StreamingIntegrator(double spacing);
+
+        /// <summary>
+        /// creates an integrator for samples with explicit abscissae
+        /// </summary>
+        StreamingIntegrator();
+
+        /// <summary>
+        /// adds a chunk of uniformly spaced samples
+        /// </summary>
+        /// <exception cref="std::logic_error">
+        /// thrown if the integrator was created for explicit abscissae
+        /// </exception>
+        void Add(const double* y, std::size_t n);
+
+        /// <summary>
+        /// adds a chunk of samples at increasing abscissae that continue the previous chunks
+        /// </summary>
+        /// <exception cref="std::logic_error">
+        /// thrown if the integrator was created for uniform spacing
+        /// </exception>
+        void Add(const double* x, const double* y, std::size_t n);
+
+        /// <summary>
+        /// adds a chunk of uniformly spaced samples
+        /// </summary>
+        void Add(const std::vector<double>& y) { Add(y.data(), y.size()); }
+
+        /// <summary>
+        /// adds a chunk of samples at increasing abscissae
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if x and y differ in size
+        /// </exception>
+        void Add(const std::vector<double>& x, const std::vector<double>& y);
+
+        /// <summary>
+        /// returns the trapezoid integral of all samples added so far
+        /// </summary>
+        double Trapezoid() const { return trapezoid.Value(); }
+
+        /// <summary>
+        /// returns the Simpson integral of all samples added so far, equal up to rounding to SimpsonSampled on the whole series
+        /// </summary>
+        double Simpson() const;
+
+        /// <summary>
+        /// returns the number of samples added so far
+        /// </summary>
+        std::size_t Count() const { return count; }
+    };
+
+} // namespace NumericLib
@@ -1,18 +1,22 @@
 #pragma once
 #include <vector>
 #include <stdexcept>
-#include <vector>
 #include <cmath>
+#include <cstddef>
+#include "integration/integrand.hpp"
 
 namespace NumericLib {
     /// <summary>
     /// approximates the definite integral of a function over a given range using simpson's method
     /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated, inlined by the compiler
+    /// </typeparam>
     /// <param name="split">
     /// number of intervals to split the range into 
     /// </param>
     /// <param name="func">
-    /// double pointer to a function to integrate
+    /// callable double(double) to integrate, or a BatchIntegrand evaluated in blocks of nodes
     /// </param>
     /// <param name="range">
     /// vector of two doubles [a , b] representing the start and end of integration
@@ -21,5 +25,38 @@ namespace NumericLib {
     /// calculated approximation of the integral of the function over the specified range using simpsons's method
     /// </returns>
     /// @exception std::invalid_argument thrown if the input range does not contain exactly two elements in the correct order
-	double Simpson(int split, double (*func)(double), const std::vector<double>& range);
+    /// @exception std::domain_error thrown if the function returns a non-finite value
+    template <typename Func>
+    double Simpson(int split, Func func, const std::vector<double>& range)
+    {
+        if (range.size() != 2)
+            throw std::invalid_argument("Range vector must have exactly two elements.");
+        if (split <= 0)
+            throw std::invalid_argument("Number of splits must be positive.");
+        if (range[0] >= range[1])
+            throw std::invalid_argument("Range start must be less than range end.");
+
+        if (split % 2 == 1) split++;
+
+        const double a = range[0], b = range[1];
+        const std::size_t n = static_cast<std::size_t>(split);
+        const double h = (b - a) / (double)split;
+
+        double sum = 0;
+        evaluateNodes(func, 0, n + 1, [a, b, h, n](std::size_t i) { return i == n ? b : a + i * h; }, [&sum, n](std::size_t i, double y) {
+            if (!std::isfinite(y))
+                throw std::domain_error("Function evaluation returned non-finite value.");
+            if (i == 0 || i == n) {
+                sum += y;
+            }
+            else if (i % 2 == 0) {
+                sum += 2 * y;
+            }
+            else {
+                sum += 4 * y;
+            }
+            });
+
+        return sum * h / 3;
+    }
 } // namespace NumericLib
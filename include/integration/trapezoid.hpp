@@ -1,18 +1,22 @@
 #pragma once
 #include <vector>
 #include <stdexcept>
-#include <vector>
 #include <cmath>
+#include <cstddef>
+#include "integration/integrand.hpp"
 
 namespace NumericLib {
     /// <summary>
     /// approximates the definite integral of a function over a given range using trapezoids method
     /// </summary>
+    /// <typeparam name="Func">
+    /// template type for the function to be integrated, inlined by the compiler
+    /// </typeparam>
     /// <param name="step">
     /// number of rectangles,steps to use for the approximation
     /// </param>
     /// <param name="func">
-    /// double pointer to a function to integrate
+    /// callable double(double) to integrate, or a BatchIntegrand evaluated in blocks of nodes
     /// </param>
     /// <param name="range">
     /// vector of two doubles [a , b] representing the start and end of integration
@@ -21,5 +25,28 @@ namespace NumericLib {
     /// calculated approximation of the integral of the function over the specified range using the trapzoids method
     /// </returns>
     /// @exception std::invalid_argument thrown if the input range does not contain exactly two elements in the correct order
-	double Trapezoids(double step, double (*func)(double), const std::vector<double>& range);
+    /// @exception std::domain_error thrown if the function returns a non-finite value
+    template <typename Func>
+    double Trapezoids(double step, Func func, const std::vector<double>& range)
+    {
+        if (range.size() != 2)
+            throw std::invalid_argument("Range vector must have exactly two elements.");
+        if (step <= 0)
+            throw std::invalid_argument("Step size must be positive.");
+        if (range[0] >= range[1])
+            throw std::invalid_argument("Range start must be less than range end.");
+
+        const double a = range[0], b = range[1];
+        const std::size_t n = static_cast<std::size_t>(std::ceil(step));
+        const double h = (b - a) / n;
+
+        double sum = 0;
+        evaluateNodes(func, 0, n + 1, [a, b, h, n](std::size_t i) { return i == n ? b : a + i * h; }, [&sum, n](std::size_t i, double y) {
+            if (!std::isfinite(y))
+                throw std::domain_error("Function evaluation returned non-finite value.");
+            sum += (i == 0 || i == n) ? y / 2 : y;
+            });
+
+        return sum * h;
+    }
 } // namespace NumericLib
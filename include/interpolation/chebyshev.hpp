@@ -0,0 +1,237 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+namespace NumericLib {
+
+    /// <summary>
+    /// degree of the first sample of an adaptive Chebyshev proxy; the degree is doubled until the coefficients decay
+    /// </summary>
+    constexpr std::size_t ChebyshevInitialDegree = 16;
+
+    /// <summary>
+    /// default maximum degree of an adaptive Chebyshev proxy
+    /// </summary>
+    constexpr std::size_t ChebyshevMaxDegree = 65536;
+
+    /// <summary>
+    /// default relative tolerance below which trailing Chebyshev coefficients are dropped
+    /// </summary>
+    constexpr double ChebyshevDefaultTolerance = 1e-14;
+
+    /// <summary>
+    /// largest degree for which roots are computed directly from the colleague matrix; higher degrees are split first
+    /// </summary>
+    constexpr std::size_t ChebyshevRootsDirectDegree = 50;
+
+    /// <summary>
+    /// computes the Chebyshev coefficients of the polynomial interpolating values at the Chebyshev extrema
+    /// t_j = cos(j pi / n), j = 0..n, with a fast cosine transform (FFT of the even extension) in O(n log n)
+    /// </summary>
+    /// <param name="values">
+    /// values at the Chebyshev extrema in the order t_0 = 1, ..., t_n = -1
+    /// </param>
+    /// <param name="stride">
+    /// only every stride-th value is used, which gives the interpolant on the nested coarser set of extrema; n is
+    /// (values.size() - 1) / stride and must be a power of two
+    /// </param>
+    /// <returns>
+    /// n + 1 coefficients c_k of sum c_k T_k(t)
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if stride is 0 or does not divide values.size() - 1, or n is not a power of two
+    /// </exception>
+    std::vector<double> ChebyshevTransform(const std::vector<double>& values, std::size_t stride = 1);
+
+    /// <summary>
+    /// evaluates the Chebyshev series sum c_k T_k(t), t = scale * x + shift, at count points with the Clenshaw
+    /// recurrence. Points are processed in blocks with the coefficient loop outside the point loop.
+    /// </summary>
+    /// <param name="coefficients">
+    /// at least one coefficient c_k
+    /// </param>
+    /// <param name="scale">
+    /// slope of the map from x to t
+    /// </param>
+    /// <param name="shift">
+    /// offset of the map from x to t
+    /// </param>
+    /// <param name="x">
+    /// points at which to evaluate the series
+    /// </param>
+    /// <param name="y">
+    /// output array receiving count values
+    /// </param>
+    /// <param name="count">
+    /// number of points
+    /// </param>
+    void EvaluateChebyshevSeries(const std::vector<double>& coefficients, double scale, double shift, const double* x, double* y, std::size_t count);
+
+    /// <summary>
+    /// computes the Chebyshev coefficients of the derivative with respect to t of sum c_k T_k(t)
+    /// </summary>
+    /// <returns>
+    /// one coefficient fewer than given, or the single coefficient 0 for a constant
+    /// </returns>
+    std::vector<double> ChebyshevDerivative(const std::vector<double>& coefficients);
+
+    /// <summary>
+    /// smooth function on [a, b] replaced by its Chebyshev interpolant, a cheap surrogate that can be evaluated,
+    /// differentiated, integrated and searched for roots. The function is sampled at Chebyshev extrema, doubling the
+    /// degree until the coefficients have decayed below the tolerance, and the negligible tail is dropped.
+    /// </summary>
+    class ChebyshevProxy
+    {
+        std::vector<double> coeffs;
+        double a;
+        double b;
+        double tolerance;
+        bool resolved = true;
+
+        void CheckRange() const;
+
+        // Drops the trailing coefficients that have reached a plateau at the tolerance relative to max |c_k|, found with
+        // Chebfun's standardChop; returns false if they have not yet decayed.
+        bool Chop(std::vector<double>& coefficients) const;
+
+        void CollectRoots(const std::vector<double>& c, double lo, double hi, double scale, int depth, std::vector<double>& roots) const;
+
+    public:
+        /// <summary>
+        /// builds an adaptive proxy of a function over a range
+        /// </summary>
+        /// <typeparam name="Func">
+        /// callable double(double)
+        /// </typeparam>
+        /// <param name="func">
+        /// function to replace
+        /// </param>
+        /// <param name="range">
+        /// vector of two doubles [a, b] specifying the interval of the proxy
+        /// </param>
+        /// <param name="tol">
+        /// relative size below which trailing coefficients are negligible
+        /// </param>
+        /// <param name="maxDegree">
+        /// largest degree tried; if the coefficients have not decayed by then, Resolved() returns false
+        /// </param>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if the range is invalid or the tolerance is not positive
+        /// </exception>
+        /// <exception cref="std::domain_error">
+        /// thrown if the function returns a non-finite value
+        /// </exception>
+        template <typename Func>
+        ChebyshevProxy(Func func, const std::vector<double>& range, double tol = ChebyshevDefaultTolerance,
+            std::size_t maxDegree = ChebyshevMaxDegree)
+            : a(range.size() == 2 ? range[0] : 0.0), b(range.size() == 2 ? range[1] : 0.0), tolerance(tol)
+        {
+            if (range.size() != 2)
+                throw std::invalid_argument("Range vector must have exactly two elements.");
+            CheckRange();
+
+            auto sample = [&](std::size_t j, std::size_t n) {
+                const double y = func((a + b) / 2.0 + (b - a) / 2.0 * std::cos(std::numbers::pi * static_cast<double>(j) / static_cast<double>(n)));
+                if (!std::isfinite(y))
+                    throw std::domain_error("Function evaluation returned non-finite value.");
+                return y;
+            };
+
+            // The extrema of degree n are every other extremum of degree 2n, so each doubling samples only the new points.
+            std::size_t n = ChebyshevInitialDegree;
+            std::vector<double> values(n + 1);
+            for (std::size_t j = 0; j <= n; j++) values[j] = sample(j, n);
+            while (true) {
+                coeffs = ChebyshevTransform(values);
+                if (Chop(coeffs)) break;
+                if (2 * n > maxDegree) {
+                    resolved = false;
+                    break;
+                }
+
+                std::vector<double> refined(2 * n + 1);
+                for (std::size_t j = 0; j <= 2 * n; j++) {
+                    refined[j] = j % 2 == 0 ? values[j / 2] : sample(j, 2 * n);
+                }
+                values.swap(refined);
+                n *= 2;
+            }
+        }
+
+        /// <summary>
+        /// creates a proxy from known Chebyshev coefficients on [a, b]
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if the range is invalid or there are no coefficients
+        /// </exception>
+        ChebyshevProxy(std::vector<double> coefficients, const std::vector<double>& range, double tol = ChebyshevDefaultTolerance);
+
+        /// <summary>
+        /// evaluates the proxy at x with the Clenshaw recurrence
+        /// </summary>
+        double Evaluate(double x) const;
+
+        /// <summary>
+        /// evaluates the proxy at count points with EvaluateChebyshevSeries
+        /// </summary>
+        void Evaluate(const double* x, double* y, std::size_t count) const;
+
+        /// <summary>
+        /// evaluates the proxy at every element of x
+        /// </summary>
+        std::vector<double> Evaluate(const std::vector<double>& x) const;
+
+        /// <summary>
+        /// evaluates the proxy at x
+        /// </summary>
+        double operator()(double x) const { return Evaluate(x); }
+
+        /// <summary>
+        /// returns the proxy of the derivative, computed from the coefficient recurrence
+        /// </summary>
+        ChebyshevProxy Derivative() const;
+
+        /// <summary>
+        /// returns the proxy of the antiderivative that vanishes at a
+        /// </summary>
+        ChebyshevProxy Antiderivative() const;
+
+        /// <summary>
+        /// returns the integral of the proxy over [a, b]
+        /// </summary>
+        double Integral() const;
+
+        /// <summary>
+        /// returns the real roots of the proxy in [a, b], in increasing order. They are the real eigenvalues of the
+        /// colleague matrix; proxies of high degree are first split into pieces of degree at most ChebyshevRootsDirectDegree.
+        /// </summary>
+        /// <exception cref="std::runtime_error">
+        /// thrown if the eigenvalue iteration does not converge
+        /// </exception>
+        std::vector<double> Roots() const;
+
+        /// <summary>
+        /// returns the Chebyshev coefficients c_k of sum c_k T_k(t), t = (2x - a - b) / (b - a)
+        /// </summary>
+        const std::vector<double>& Coefficients() const { return coeffs; }
+
+        /// <summary>
+        /// returns the degree of the proxy
+        /// </summary>
+        std::size_t Degree() const { return coeffs.size() - 1; }
+
+        /// <summary>
+        /// returns false if the coefficients had not decayed below the tolerance at the maximum degree
+        /// </summary>
+        bool Resolved() const { return resolved; }
+
+        /// <summary>
+        /// returns the interval [a, b] of the proxy
+        /// </summary>
+        std::vector<double> Range() const { return { a, b }; }
+    };
+
+} // namespace NumericLib
@@ -0,0 +1,144 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "interpolation/uniform_axis.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// interpolation scheme of a GridInterpolant.
+    /// Linear is multilinear (bilinear, trilinear) on the 2^d corners of a cell; Cubic is the tensor product of cubic
+    /// Hermite pieces with finite-difference slopes on the 4^d surrounding nodes, which is Catmull-Rom on uniform axes
+    /// (bicubic, tricubic) and uses one-sided slopes at the grid boundary.
+    /// </summary>
+    enum class GridMethod {
+        Linear,
+        Cubic
+    };
+
+    /// <summary>
+    /// largest number of grid dimensions
+    /// </summary>
+    constexpr std::size_t GridMaxDimensions = 3;
+
+    /// <summary>
+    /// interpolant of values on a rectilinear grid in one to three dimensions. Values are stored in row-major order, the
+    /// last axis varying fastest, either in a vector owned by the interpolant or in external storage such as the data of a
+    /// memory-mapped MatrixView, which is read in place. Cells are found in O(1) on uniform axes and by binary search on
+    /// other axes; points outside the grid are extrapolated with the boundary cells.
+    /// </summary>
+    class GridInterpolant
+    {
+        struct GridAxis {
+            std::vector<double> nodes;
+            bool uniform = false;
+            UniformAxis cells;
+            std::size_t stride = 0;
+        };
+
+        std::vector<GridAxis> axes;
+        std::shared_ptr<const std::vector<double>> owned;
+        const double* values = nullptr;
+        GridMethod method;
+
+        // Optional per-cell coefficient tensors of the local polynomial in the cell coordinates t_d in [0, 1].
+        std::vector<double> cellCoefficients;
+        std::vector<std::size_t> cellStrides;
+
+        void Initialize(std::vector<std::vector<double>> nodes);
+        std::size_t Order() const { return method == GridMethod::Linear ? 2 : 4; }
+        std::size_t Stencil() const;
+
+        // Cell of x along an axis, and its local coordinate t; t lies outside [0, 1] only for extrapolated points.
+        static std::size_t Locate(const GridAxis& axis, double x, double& t);
+
+        // Indices of the stencil nodes along an axis for a cell, and weight[k * order + p], the coefficient of t^p in the
+        // weight of node k.
+        void StencilWeights(const GridAxis& axis, std::size_t cell, std::size_t* index, double* weight) const;
+
+        double EvaluatePrecomputed(const double* point) const;
+
+    public:
+        /// <summary>
+        /// creates an interpolant that owns its values
+        /// </summary>
+        /// <param name="nodes">
+        /// strictly increasing nodes of every axis, at least two per axis
+        /// </param>
+        /// <param name="gridValues">
+        /// values at the grid points in row-major order, the product of the axis sizes in total
+        /// </param>
+        /// <param name="gridMethod">
+        /// interpolation scheme
+        /// </param>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if there are no or more than GridMaxDimensions axes, an axis has fewer than two nodes or is not strictly
+        /// increasing, or the number of values does not match the grid
+        /// </exception>
+        GridInterpolant(std::vector<std::vector<double>> nodes, std::vector<double> gridValues, GridMethod gridMethod = GridMethod::Linear);
+
+        /// <summary>
+        /// creates an interpolant over external row-major storage, which must outlive the interpolant and its copies
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if there are no or more than GridMaxDimensions axes, an axis has fewer than two nodes or is not strictly
+        /// increasing, or gridValues is nullptr
+        /// </exception>
+        GridInterpolant(std::vector<std::vector<double>> nodes, const double* gridValues, GridMethod gridMethod = GridMethod::Linear);
+
+        /// <summary>
+        /// stores the polynomial coefficients of every cell, 2^d or 4^d per cell, so an evaluation reads one contiguous
+        /// block instead of gathering the stencil from the grid. This multiplies the memory of the grid by up to 4^d
+        /// (64 for tricubic) and is meant for grids that are small or evaluated very often.
+        /// </summary>
+        void PrecomputeCells();
+
+        /// <summary>
+        /// returns true if the cell coefficients have been precomputed
+        /// </summary>
+        bool Precomputed() const { return !cellCoefficients.empty(); }
+
+        /// <summary>
+        /// evaluates the interpolant at a point given by Dimensions() coordinates
+        /// </summary>
+        double Evaluate(const double* point) const;
+
+        /// <summary>
+        /// evaluates the interpolant at a point
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if the point does not have Dimensions() coordinates
+        /// </exception>
+        double Evaluate(const std::vector<double>& point) const;
+
+        /// <summary>
+        /// evaluates the interpolant at count points stored one after another, Dimensions() coordinates each. Every block
+        /// of points first computes its cells and stencil weights, then accumulates the stencil with the stencil loop
+        /// outside the point loop, so the inner loop is a gather the compiler can vectorize. Large inputs are split over
+        /// the shared thread pool.
+        /// </summary>
+        void Evaluate(const double* points, double* y, std::size_t count) const;
+
+        /// <summary>
+        /// evaluates the interpolant at a point
+        /// </summary>
+        double operator()(const std::vector<double>& point) const { return Evaluate(point); }
+
+        /// <summary>
+        /// returns the number of grid dimensions
+        /// </summary>
+        std::size_t Dimensions() const { return axes.size(); }
+
+        /// <summary>
+        /// returns the nodes of an axis
+        /// </summary>
+        const std::vector<double>& Nodes(std::size_t axis) const { return axes[axis].nodes; }
+
+        /// <summary>
+        /// returns the interpolation scheme
+        /// </summary>
+        GridMethod Method() const { return method; }
+    };
+
+} // namespace NumericLib
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <vector>
 
 namespace NumericLib {
@@ -25,4 +26,113 @@ namespace NumericLib {
     /// </exception>
 	double InterpolateLagrange(double x, const std::vector<double>& xi, const std::vector<double>& fxi, int prec);
 
+    /// <summary>
+    /// family of Chebyshev nodes on [a, b]: First are the roots of T_{n+1}, Second the extrema of T_n including the endpoints
+    /// </summary>
+    enum class ChebyshevNodeKind {
+        First,
+        Second
+    };
+
+    /// <summary>
+    /// Lagrange interpolating polynomial in the second barycentric form
+    /// p(x) = sum w_j y_j / (x - x_j) / sum w_j / (x - x_j).
+    /// The weights are computed once in O(n^2), or in O(n) from closed forms for Chebyshev and equispaced nodes; every
+    /// evaluation and every added node then costs O(n). The weights are kept scaled to a largest magnitude of 1, which
+    /// leaves the interpolant unchanged and keeps them from overflowing.
+    /// </summary>
+    class BarycentricInterpolant
+    {
+        std::vector<double> nodes;
+        std::vector<double> values;
+        std::vector<double> weights;
+
+        BarycentricInterpolant(std::vector<double> x, std::vector<double> y, std::vector<double> w);
+
+        void Normalize();
+
+    public:
+        /// <summary>
+        /// computes the barycentric weights w_j = 1 / prod_{k != j} (x_j - x_k) of arbitrary distinct nodes
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if x and y differ in size, are empty or x contains repeated points
+        /// </exception>
+        BarycentricInterpolant(std::vector<double> x, std::vector<double> y);
+
+        /// <summary>
+        /// returns count Chebyshev nodes of the given kind on [a, b], in decreasing order
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if count is 0, the range does not have two elements or a >= b
+        /// </exception>
+        static std::vector<double> ChebyshevNodes(std::size_t count, const std::vector<double>& range, ChebyshevNodeKind kind = ChebyshevNodeKind::Second);
+
+        /// <summary>
+        /// returns count equally spaced nodes on [a, b], in increasing order and including both endpoints (the midpoint if count is 1)
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if count is 0, the range does not have two elements or a >= b
+        /// </exception>
+        static std::vector<double> EquispacedNodes(std::size_t count, const std::vector<double>& range);
+
+        /// <summary>
+        /// creates the interpolant of values at ChebyshevNodes(y.size(), range, kind) with the closed-form weights
+        /// (-1)^j delta_j for the second kind, delta_j = 1/2 at the endpoints, and (-1)^j sin((2j + 1) pi / (2n + 2)) for
+        /// the first kind
+        /// </summary>
+        static BarycentricInterpolant Chebyshev(std::vector<double> y, const std::vector<double>& range, ChebyshevNodeKind kind = ChebyshevNodeKind::Second);
+
+        /// <summary>
+        /// creates the interpolant of values at EquispacedNodes(y.size(), range) with the closed-form weights (-1)^j C(n, j).
+        /// Equispaced interpolation is ill-conditioned beyond a few dozen nodes; the weights themselves stay finite.
+        /// </summary>
+        static BarycentricInterpolant Equispaced(std::vector<double> y, const std::vector<double>& range);
+
+        /// <summary>
+        /// adds the node (x, y) in O(n): every weight is divided by x_j - x and the new weight is found from the ratio of
+        /// its node polynomial to that of the first node
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if x is already a node
+        /// </exception>
+        void AddNode(double x, double y);
+
+        /// <summary>
+        /// evaluates the interpolant at x in O(n); at a node it returns the node's value
+        /// </summary>
+        double Evaluate(double x) const;
+
+        /// <summary>
+        /// evaluates the interpolant at count points, accumulating the barycentric numerator and denominator of a block of
+        /// points one node at a time
+        /// </summary>
+        void Evaluate(const double* x, double* y, std::size_t count) const;
+
+        /// <summary>
+        /// evaluates the interpolant at every element of x
+        /// </summary>
+        std::vector<double> Evaluate(const std::vector<double>& x) const;
+
+        /// <summary>
+        /// evaluates the interpolant at x
+        /// </summary>
+        double operator()(double x) const { return Evaluate(x); }
+
+        /// <summary>
+        /// returns the interpolation nodes
+        /// </summary>
+        const std::vector<double>& Nodes() const { return nodes; }
+
+        /// <summary>
+        /// returns the values at the nodes
+        /// </summary>
+        const std::vector<double>& Values() const { return values; }
+
+        /// <summary>
+        /// returns the barycentric weights, scaled to a largest magnitude of 1
+        /// </summary>
+        const std::vector<double>& Weights() const { return weights; }
+    };
+
 } // namespace NumericLib
\ No newline at end of file
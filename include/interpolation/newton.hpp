@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <vector>
 
 namespace NumericLib {
@@ -22,4 +23,117 @@ namespace NumericLib {
 	/// </exception>
 	double InterpolateNewton(double x_val, const std::vector<double>& x, const std::vector<double>& y);
 
+    /// <summary>
+    /// Newton interpolating polynomial through a fixed set of nodes. The divided differences are computed once, in place
+    /// with O(n) storage, and every evaluation costs O(n). The object is immutable after construction, so one instance
+    /// can be evaluated from several threads at once.
+    /// </summary>
+    class NewtonInterpolant
+    {
+        std::vector<double> nodes;
+        std::vector<double> coeffs;
+
+    public:
+        /// <summary>
+        /// computes the Newton coefficients of the polynomial through the points (x[i], y[i])
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if x and y differ in size, are empty or x contains repeated points
+        /// </exception>
+        NewtonInterpolant(std::vector<double> x, const std::vector<double>& y);
+
+        /// <summary>
+        /// evaluates the polynomial at x with the nested form a0 + (x - x0)(a1 + (x - x1)(a2 + ...))
+        /// </summary>
+        double Evaluate(double x) const;
+
+        /// <summary>
+        /// evaluates the polynomial at count points by the nested form, one block of points per task of the shared pool
+        /// </summary>
+        void Evaluate(const double* x, double* y, std::size_t count) const;
+
+        /// <summary>
+        /// evaluates the polynomial at every element of x
+        /// </summary>
+        std::vector<double> Evaluate(const std::vector<double>& x) const;
+
+        /// <summary>
+        /// evaluates the polynomial at x
+        /// </summary>
+        double operator()(double x) const { return Evaluate(x); }
+
+        /// <summary>
+        /// returns the Newton coefficients a0, a1, ..., an, the divided differences f[x0], f[x0, x1], ..., f[x0, ..., xn]
+        /// </summary>
+        const std::vector<double>& Coefficients() const { return coeffs; }
+
+        /// <summary>
+        /// returns the interpolation nodes x0, x1, ..., xn
+        /// </summary>
+        const std::vector<double>& Nodes() const { return nodes; }
+    };
+
+    /// <summary>
+    /// Newton interpolating polynomial over the last samples of a stream, held in a fixed ring buffer. The polynomial is
+    /// kept in the Newton form anchored at the newest sample, p(x) = d0 + d1 (x - x_n) + d2 (x - x_n)(x - x_{n-1}) + ...,
+    /// whose coefficients are the last diagonal of the divided difference table. Appending a sample computes the new
+    /// diagonal from the old one in O(k), evicting the oldest sample drops the last term, and nothing is allocated after
+    /// construction.
+    /// </summary>
+    class StreamingNewtonInterpolant
+    {
+        std::vector<double> nodes;
+        std::vector<double> diagonal;
+        std::size_t newest = 0;
+        std::size_t count = 0;
+
+        // i-th newest node, i = 0 for the latest sample.
+        double Node(std::size_t i) const { return nodes[(newest + nodes.size() - i) % nodes.size()]; }
+
+    public:
+        /// <summary>
+        /// creates an empty interpolator over a window of the given number of samples
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if the window is 0
+        /// </exception>
+        explicit StreamingNewtonInterpolant(std::size_t window);
+
+        /// <summary>
+        /// appends the sample (x, y), evicting the oldest sample once the window is full
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if x equals a node in the window; the window is left unchanged
+        /// </exception>
+        void Push(double x, double y);
+
+        /// <summary>
+        /// evaluates the polynomial through the samples in the window at x in O(k)
+        /// </summary>
+        /// <exception cref="std::runtime_error">
+        /// thrown if the window is empty
+        /// </exception>
+        double Evaluate(double x) const;
+
+        /// <summary>
+        /// evaluates the polynomial through the samples in the window at x
+        /// </summary>
+        double operator()(double x) const { return Evaluate(x); }
+
+        /// <summary>
+        /// removes all samples
+        /// </summary>
+        void Clear() { count = 0; }
+
+        /// <summary>
+        /// returns the number of samples in the window
+        /// </summary>
+        std::size_t Size() const { return count; }
+
+        /// <summary>
+        /// returns the largest number of samples kept
+        /// </summary>
+        std::size_t Window() const { return nodes.size(); }
+    };
+
 } // namespace NumericLib
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "interpolation/uniform_axis.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// piecewise interpolation scheme of a Spline.
+    /// Linear joins the points by straight lines; Natural, Clamped and NotAKnot are C2 cubic splines whose end conditions
+    /// are a zero second derivative, prescribed first derivatives and a continuous third derivative at the second and
+    /// second-to-last nodes; Monotone is the C1 shape-preserving PCHIP interpolant of Fritsch and Carlson.
+    /// </summary>
+    enum class SplineKind {
+        Linear,
+        Natural,
+        Clamped,
+        NotAKnot,
+        Monotone
+    };
+
+    /// <summary>
+    /// piecewise cubic interpolant of tabulated data, stored as the local coefficients
+    /// y = c0 + c1 t + c2 t^2 + c3 t^3, t = x - x_i, of every interval. The node slopes of the cubic splines come from a
+    /// tridiagonal system solved in O(n). Intervals are found in O(1) on uniform grids and by binary search otherwise.
+    /// Points outside the nodes are extrapolated with the first or last piece.
+    /// </summary>
+    class Spline
+    {
+        std::vector<double> nodes;
+        std::vector<double> c0, c1, c2, c3;
+        SplineKind kind;
+        bool uniform = false;
+        UniformAxis intervalAxis;
+
+        // Index of the interval containing x; hint is tried first, then its right neighbour, then a binary search.
+        std::size_t Locate(double x, std::size_t hint) const;
+
+    public:
+        /// <summary>
+        /// builds the interpolant of the points (x[i], y[i])
+        /// </summary>
+        /// <param name="x">
+        /// strictly increasing nodes, at least two
+        /// </param>
+        /// <param name="y">
+        /// values at the nodes
+        /// </param>
+        /// <param name="splineKind">
+        /// interpolation scheme; NotAKnot through three points is the interpolating parabola
+        /// </param>
+        /// <param name="startSlope">
+        /// first derivative at x[0], used by Clamped only
+        /// </param>
+        /// <param name="endSlope">
+        /// first derivative at the last node, used by Clamped only
+        /// </param>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if x and y differ in size, have fewer than two points or x is not strictly increasing
+        /// </exception>
+        Spline(std::vector<double> x, const std::vector<double>& y, SplineKind splineKind = SplineKind::Natural,
+            double startSlope = 0.0, double endSlope = 0.0);
+
+        /// <summary>
+        /// evaluates the interpolant at x
+        /// </summary>
+        double Evaluate(double x) const;
+
+        /// <summary>
+        /// evaluates the interpolant at x, trying the interval of the previous call first, which makes a sweep over
+        /// increasing points O(1) per point on any grid
+        /// </summary>
+        /// <param name="interval">
+        /// interval index of the previous call, updated to the interval of x; start with 0
+        /// </param>
+        double Evaluate(double x, std::size_t& interval) const;
+
+        /// <summary>
+        /// evaluates the interpolant at count points. Each block of points first finds its intervals, on uniform grids by a
+        /// clamped, branch-free index computation, then evaluates the local cubics in a loop without branches that the
+        /// compiler vectorizes.
+        /// </summary>
+        void Evaluate(const double* x, double* y, std::size_t count) const;
+
+        /// <summary>
+        /// evaluates the interpolant at every element of x
+        /// </summary>
+        std::vector<double> Evaluate(const std::vector<double>& x) const;
+
+        /// <summary>
+        /// evaluates the interpolant at x
+        /// </summary>
+        double operator()(double x) const { return Evaluate(x); }
+
+        /// <summary>
+        /// returns the first derivative of the interpolant at x
+        /// </summary>
+        double Derivative(double x) const;
+
+        /// <summary>
+        /// returns the interpolation nodes
+        /// </summary>
+        const std::vector<double>& Nodes() const { return nodes; }
+
+        /// <summary>
+        /// returns the interpolation scheme
+        /// </summary>
+        SplineKind Kind() const { return kind; }
+
+        /// <summary>
+        /// returns true if the nodes are equally spaced, so intervals are found without searching
+        /// </summary>
+        bool Uniform() const { return uniform; }
+    };
+
+} // namespace NumericLib
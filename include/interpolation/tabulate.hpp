@@ -0,0 +1,207 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "interpolation/uniform_axis.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// default degree of the polynomial on every segment of a tabulated function; with the segment's centre and scale a
+    /// segment then fills one 64-byte cache line
+    /// </summary>
+    constexpr int TabulateDefaultDegree = 5;
+
+    /// <summary>
+    /// default maximum number of segments of a tabulated function
+    /// </summary>
+    constexpr std::size_t TabulateMaxSegments = 1 << 16;
+
+    /// <summary>
+    /// number of points per segment, in addition to the interpolation nodes, at which the error bound is verified
+    /// </summary>
+    constexpr int TabulateCheckPoints = 32;
+
+    /// <summary>
+    /// expensive scalar function on [a, b] compiled into a table of low-degree polynomials. Segments are bisected until
+    /// the interpolant at Chebyshev points matches the function within the tolerance at every check point, so the
+    /// table can stand in for the function wherever it is called with arguments in the range.
+    /// </summary>
+    class TabulatedFunction
+    {
+        int degree;
+        double a;
+        double b;
+        double maxError = 0.0;
+        bool verified = true;
+
+        // Segment k occupies table[k * stride, (k + 1) * stride): centre, 2 / width, then the coefficients of
+        // sum c_i t^i in t = (x - centre) * 2 / width.
+        std::vector<double> table;
+        std::vector<double> breaks;
+
+        // cellStart[c] is the segment containing the start of cell c of a uniform grid over [a, b].
+        std::vector<std::size_t> cellStart;
+        UniformAxis cells;
+
+        std::size_t Stride() const { return static_cast<std::size_t>(degree) + 3; }
+
+        // Interpolation nodes and check points on [-1, 1].
+        static std::vector<double> FitNodes(int degree);
+        static std::vector<double> CheckNodes();
+
+        // Monomial coefficients in t of the interpolant of values at FitNodes(degree).
+        static std::vector<double> FitSegment(const std::vector<double>& values);
+
+        static double Horner(const double* coefficients, int degree, double t);
+
+        void AddSegment(double lo, double hi, const std::vector<double>& coefficients);
+        void BuildIndex();
+        std::size_t Locate(double x) const;
+
+    public:
+        /// <summary>
+        /// tabulates a function over a range
+        /// </summary>
+        /// <typeparam name="Func">
+        /// callable double(double)
+        /// </typeparam>
+        /// <param name="func">
+        /// function to tabulate
+        /// </param>
+        /// <param name="range">
+        /// vector of two doubles [a, b] specifying the interval of the table
+        /// </param>
+        /// <param name="tolerance">
+        /// largest absolute error allowed at the check points
+        /// </param>
+        /// <param name="polynomialDegree">
+        /// degree of the polynomial on every segment, between 0 and 16
+        /// </param>
+        /// <param name="maxSegments">
+        /// largest number of segments; if the tolerance is not met by then, Verified() returns false
+        /// </param>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if the range is invalid, the tolerance is not positive, the degree is out of range or maxSegments is 0
+        /// </exception>
+        /// <exception cref="std::domain_error">
+        /// thrown if the function returns a non-finite value
+        /// </exception>
+        template <typename Func>
+        TabulatedFunction(Func func, const std::vector<double>& range, double tolerance, int polynomialDegree = TabulateDefaultDegree,
+            std::size_t maxSegments = TabulateMaxSegments)
+            : degree(polynomialDegree), a(range.size() == 2 ? range[0] : 0.0), b(range.size() == 2 ? range[1] : 0.0)
+        {
+            if (range.size() != 2)
+                throw std::invalid_argument("Range vector must have exactly two elements.");
+            if (a >= b)
+                throw std::invalid_argument("Range start must be less than range end.");
+            if (!(tolerance > 0))
+                throw std::invalid_argument("Tolerance must be positive.");
+            if (degree < 0 || degree > 16)
+                throw std::invalid_argument("Polynomial degree must be between 0 and 16.");
+            if (maxSegments == 0)
+                throw std::invalid_argument("At least one segment is required.");
+
+            auto sample = [&](double x) {
+                const double y = func(x);
+                if (!std::isfinite(y))
+                    throw std::domain_error("Function evaluation returned non-finite value.");
+                return y;
+            };
+
+            const std::vector<double> fitNodes = FitNodes(degree);
+            const std::vector<double> checkNodes = CheckNodes();
+            std::vector<double> values(fitNodes.size());
+
+            // Segments are taken from the back of the stack with the left half pushed last, so they are emitted in order.
+            std::vector<std::pair<double, double>> pending = { { a, b } };
+            std::size_t accepted = 0;
+            while (!pending.empty()) {
+                const double lo = pending.back().first, hi = pending.back().second;
+                pending.pop_back();
+                const double centre = (lo + hi) / 2.0, half = (hi - lo) / 2.0;
+
+                for (std::size_t i = 0; i < fitNodes.size(); i++) values[i] = sample(centre + half * fitNodes[i]);
+                const std::vector<double> coefficients = FitSegment(values);
+
+                double error = 0.0;
+                for (double t : checkNodes) {
+                    error = std::max(error, std::abs(Horner(coefficients.data(), degree, t) - sample(centre + half * t)));
+                }
+
+                const bool canSplit = accepted + pending.size() + 2 <= maxSegments && lo < centre && centre < hi;
+                if (error > tolerance && canSplit) {
+                    pending.emplace_back(centre, hi);
+                    pending.emplace_back(lo, centre);
+                    continue;
+                }
+
+                verified = verified && error <= tolerance;
+                maxError = std::max(maxError, error);
+                AddSegment(lo, hi, coefficients);
+                accepted++;
+            }
+            BuildIndex();
+        }
+
+        /// <summary>
+        /// evaluates the table at x. The segment is found from a uniform cell index and a short forward scan, then its
+        /// polynomial is evaluated by Horner's scheme. Points outside [a, b] are extrapolated with the end segments.
+        /// </summary>
+        double Evaluate(double x) const;
+
+        /// <summary>
+        /// evaluates the table at count points, over blocks of points with the coefficient loop outside the point loop
+        /// </summary>
+        void Evaluate(const double* x, double* y, std::size_t count) const;
+
+        /// <summary>
+        /// evaluates the table at every element of x
+        /// </summary>
+        std::vector<double> Evaluate(const std::vector<double>& x) const;
+
+        /// <summary>
+        /// evaluates the table at x, so it can replace the tabulated function
+        /// </summary>
+        double operator()(double x) const { return Evaluate(x); }
+
+        /// <summary>
+        /// returns the number of segments
+        /// </summary>
+        std::size_t Segments() const { return breaks.size() - 1; }
+
+        /// <summary>
+        /// returns the segment boundaries a = x_0 < x_1 < ... < x_m = b
+        /// </summary>
+        const std::vector<double>& Breaks() const { return breaks; }
+
+        /// <summary>
+        /// returns the largest error found at the check points
+        /// </summary>
+        double MaxError() const { return maxError; }
+
+        /// <summary>
+        /// returns false if some segment missed the tolerance at the maximum number of segments
+        /// </summary>
+        bool Verified() const { return verified; }
+
+        /// <summary>
+        /// returns the interval [a, b] of the table
+        /// </summary>
+        std::vector<double> Range() const { return { a, b }; }
+    };
+
+    /// <summary>
+    /// compiles a function on a range into a TabulatedFunction whose error at the check points is at most tolerance
+    /// </summary>
+    template <typename Func>
+    TabulatedFunction tabulate(Func func, const std::vector<double>& range, double tolerance, int degree = TabulateDefaultDegree)
+    {
+        return TabulatedFunction(func, range, tolerance, degree);
+    }
+
+} // namespace NumericLib
@@ -0,0 +1,53 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace NumericLib {
+
+    /// <summary>
+    /// nodes count as equally spaced when every node is within this fraction of the span of its uniform position
+    /// </summary>
+    constexpr double UniformAxisTolerance = 1e-12;
+
+    /// <summary>
+    /// equal cells dividing an interval, with an O(1) lookup of the cell containing a point
+    /// </summary>
+    struct UniformAxis
+    {
+        double origin = 0.0;
+        double inverseStep = 0.0;
+        std::size_t last = 0;
+
+        UniformAxis() = default;
+
+        /// <summary>
+        /// divides [start, end] into cells equal cells
+        /// </summary>
+        UniformAxis(double start, double end, std::size_t cells)
+            : origin(start), inverseStep(static_cast<double>(cells) / (end - start)), last(cells - 1) {}
+
+        /// <summary>
+        /// returns the cell containing x; points outside the interval get the first or last cell and NaN gets cell 0
+        /// </summary>
+        std::size_t Cell(double x) const {
+            // max(0, u) maps NaN to 0, and min against last keeps the index valid without branches.
+            return static_cast<std::size_t>(std::min(static_cast<double>(last), std::max(0.0, (x - origin) * inverseStep)));
+        }
+    };
+
+    /// <summary>
+    /// returns true if the increasing nodes are equally spaced within UniformAxisTolerance, so the intervals between
+    /// them can be found with UniformAxis(nodes.front(), nodes.back(), nodes.size() - 1)
+    /// </summary>
+    inline bool isUniformAxis(const std::vector<double>& nodes) {
+        const double span = nodes.back() - nodes.front();
+        const double step = span / static_cast<double>(nodes.size() - 1);
+        for (std::size_t i = 1; i + 1 < nodes.size(); i++) {
+            if (!(std::abs(nodes[i] - (nodes.front() + step * static_cast<double>(i))) <= UniformAxisTolerance * span)) return false;
+        }
+        return true;
+    }
+
+} // namespace NumericLib
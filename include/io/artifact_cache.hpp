@@ -0,0 +1,203 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "io/binary_matrix.hpp"
+#include "integration/gauss_legendre.hpp"
+#include "liniear_systems/gauss_elimination.hpp"
+#include "approximation.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// version of the artifacts produced by the cached routines. It is part of every key, so increasing it when a routine
+    /// changes its results makes the cache miss on artifacts written by older code instead of returning them.
+    /// </summary>
+    constexpr std::uint32_t ArtifactFormatVersion = 3;
+
+    /// <summary>
+    /// builds a cache key from an artifact name and a hash of the data the artifact is derived from
+    /// </summary>
+    /// <param name="name">
+    /// name describing the artifact and its parameters, e.g. "gauss_legendre/4"
+    /// </param>
+    /// <param name="content">
+    /// input data of the artifact (e.g. the matrix that is factorized); may be empty
+    /// </param>
+    /// <returns>
+    /// key to be used with ArtifactCache, tagged with ArtifactFormatVersion and BinaryMatrixVersion
+    /// </returns>
+    std::string ArtifactKey(const std::string& name, const std::vector<std::vector<double>>& content = {});
+
+    /// <summary>
+    /// persistent cache of precomputed numerical artifacts stored in a directory.
+    /// Every artifact is a file in the binary matrix format named after the hash of its key; it is written once and
+    /// memory-mapped on later lookups. Files are validated by checksum when loaded, and the least recently used files
+    /// are evicted when the directory grows beyond the size limit.
+    /// </summary>
+    class ArtifactCache
+    {
+        std::string directory;
+        std::uint64_t maxBytes;
+        bool verify;
+        std::mutex mutex;
+
+        std::string PathFor(const std::string& key) const;
+        void Evict(const std::string& keep);
+
+    public:
+        /// <summary>
+        /// opens (and creates if needed) a cache directory
+        /// </summary>
+        /// <param name="dir">
+        /// directory holding the cached artifacts
+        /// </param>
+        /// <param name="sizeLimit">
+        /// maximum total size of the cached files in bytes
+        /// </param>
+        /// <param name="verifyChecksum">
+        /// if true the checksum of every artifact is verified when it is loaded
+        /// </param>
+        /// <exception cref="std::runtime_error">
+        /// thrown if the directory cannot be created
+        /// </exception>
+        explicit ArtifactCache(const std::string& dir, std::uint64_t sizeLimit = 1ull << 30, bool verifyChecksum = true);
+
+        /// <summary>
+        /// looks up an artifact and marks it as recently used. Files with an invalid header or checksum are removed;
+        /// files that cannot be opened or mapped are left in place and reported as a miss.
+        /// </summary>
+        /// <param name="key">
+        /// key of the artifact
+        /// </param>
+        /// <returns>
+        /// mapping of the cached artifact, or an empty optional on a miss
+        /// </returns>
+        std::optional<MappedMatrix> Find(const std::string& key);
+
+        /// <summary>
+        /// stores an artifact, replacing any previous one with the same key, and evicts least recently used artifacts
+        /// until the cache fits its size limit. The new artifact itself is never evicted.
+        /// </summary>
+        /// <param name="key">
+        /// key of the artifact
+        /// </param>
+        /// <param name="A">
+        /// matrix part of the artifact
+        /// </param>
+        /// <param name="b">
+        /// vector part of the artifact
+        /// </param>
+        /// <returns>
+        /// mapping of the stored artifact
+        /// </returns>
+        /// <exception cref="std::runtime_error">
+        /// thrown if the artifact cannot be written
+        /// </exception>
+        MappedMatrix Store(const std::string& key, const std::vector<std::vector<double>>& A, const std::vector<double>& b);
+
+        /// <summary>
+        /// returns the cached artifact, building and storing it on a miss
+        /// </summary>
+        /// <typeparam name="Build">
+        /// callable returning std::pair of the matrix and vector parts of the artifact
+        /// </typeparam>
+        /// <param name="key">
+        /// key of the artifact
+        /// </param>
+        /// <param name="build">
+        /// computes the artifact on a cache miss
+        /// </param>
+        /// <returns>
+        /// mapping of the cached artifact
+        /// </returns>
+        template <typename Build>
+        MappedMatrix GetOrCreate(const std::string& key, Build build) {
+            std::optional<MappedMatrix> cached = Find(key);
+            if (cached) return std::move(*cached);
+
+            std::pair<std::vector<std::vector<double>>, std::vector<double>> artifact = build();
+            return Store(key, artifact.first, artifact.second);
+        }
+
+        /// <summary>
+        /// returns the total size in bytes of the artifacts currently in the cache
+        /// </summary>
+        std::uint64_t Size();
+
+        /// <summary>
+        /// removes every artifact from the cache
+        /// </summary>
+        void Clear();
+    };
+
+    /// <summary>
+    /// returns the Gauss-Legendre rule with n nodes, loading it from the cache when available
+    /// </summary>
+    /// <param name="cache">
+    /// cache holding the rule
+    /// </param>
+    /// <param name="n">
+    /// number of nodes
+    /// </param>
+    /// <returns>
+    /// nodes and weights of the rule
+    /// </returns>
+    GaussLegendreRule CachedGLRule(ArtifactCache& cache, int n);
+
+    /// <summary>
+    /// performs the LU decomposition of matrix A, loading the factors from the cache when A has been decomposed before
+    /// </summary>
+    /// <param name="cache">
+    /// cache holding the factorization, keyed by the contents of A
+    /// </param>
+    /// <param name="A">
+    /// matrix A (n x n) to be decomposed
+    /// </param>
+    /// <param name="L">
+    /// lower triangular matrix L (n x n) to be filled with the decomposition result
+    /// </param>
+    /// <param name="U">
+    /// upper triangular matrix U (n x n) to be filled with the decomposition result
+    /// </param>
+    void CachedLuDecomposition(ArtifactCache& cache, const std::vector<std::vector<double>>& A,
+        std::vector<std::vector<double>>& L, std::vector<std::vector<double>>& U);
+
+    /// <summary>
+    /// constructs a least-squares approximation, loading its coefficients from the cache when available
+    /// </summary>
+    /// <typeparam name="Func">
+    /// callable object representing the function to approximate
+    /// </typeparam>
+    /// <param name="cache">
+    /// cache holding the coefficients
+    /// </param>
+    /// <param name="name">
+    /// name identifying the function; the degree and range are added to the key automatically
+    /// </param>
+    /// <param name="func">
+    /// function to approximate
+    /// </param>
+    /// <param name="deg">
+    /// degree of the approximating polynomial
+    /// </param>
+    /// <param name="r">
+    /// vector of two doubles [a, b] specifying the interval of the approximation
+    /// </param>
+    /// <returns>
+    /// approximation object with cached or freshly computed coefficients
+    /// </returns>
+    template <typename Func>
+    Approximation<Func> CachedApproximation(ArtifactCache& cache, const std::string& name, Func func, int deg, std::vector<double> r) {
+        std::string key = ArtifactKey("approximation/" + name + "/" + std::to_string(deg), { r });
+        MappedMatrix coeffs = cache.GetOrCreate(key, [&]() {
+            Approximation<Func> approx(func, deg, r);
+            return std::make_pair(std::vector<std::vector<double>>(), approx.Coefficients());
+            });
+        return Approximation<Func>(func, std::vector<double>(coeffs.vector(), coeffs.vector() + coeffs.vectorLength()), r);
+    }
+
+} // namespace NumericLib
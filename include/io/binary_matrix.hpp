@@ -0,0 +1,245 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+namespace NumericLib {
+
+    /// <summary>
+    /// current version of the binary matrix format written by WriteBinaryMatrix
+    /// </summary>
+    constexpr std::uint32_t BinaryMatrixVersion = 1;
+
+    /// <summary>
+    /// alignment in bytes of the header and of every payload block in the binary matrix format
+    /// </summary>
+    constexpr std::size_t BinaryMatrixAlignment = 64;
+
+    /// <summary>
+    /// error thrown when a file can be read but is not a valid binary matrix file: it is too short, its header is
+    /// invalid or its checksum does not match
+    /// </summary>
+    class BinaryMatrixFormatError : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    /// <summary>
+    /// element type stored in the payload of a binary matrix file
+    /// </summary>
+    enum class BinaryDType : std::uint32_t {
+        Float64 = 1
+    };
+
+    /// <summary>
+    /// storage order of the matrix block in a binary matrix file
+    /// </summary>
+    enum class BinaryLayout : std::uint32_t {
+        RowMajor = 0,
+        ColMajor = 1
+    };
+
+    /// <summary>
+    /// fixed 128 byte header at the beginning of every binary matrix file.
+    /// The payload holds the matrix block at matrixOffset followed by the vector block at vectorOffset,
+    /// both aligned to the value stored in alignment.
+    /// </summary>
+    struct BinaryMatrixHeader {
+        char magic[8];
+        std::uint32_t version;
+        BinaryDType dtype;
+        BinaryLayout layout;
+        std::uint32_t alignment;
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t vectorLength;
+        std::uint64_t matrixOffset;
+        std::uint64_t vectorOffset;
+        std::uint64_t checksum;
+        std::uint64_t reserved[7];
+    };
+
+    static_assert(sizeof(BinaryMatrixHeader) % BinaryMatrixAlignment == 0, "BinaryMatrixHeader must occupy whole aligned blocks");
+
+    /// <summary>
+    /// non-owning view of a dense matrix stored in contiguous memory with arbitrary row and column strides
+    /// </summary>
+    struct MatrixView {
+        const double* data = nullptr;
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+        std::size_t rowStride = 0;
+        std::size_t colStride = 1;
+
+        /// <summary>
+        /// returns the element in row i and column j
+        /// </summary>
+        double operator()(std::size_t i, std::size_t j) const {
+            return data[i * rowStride + j * colStride];
+        }
+
+        /// <summary>
+        /// copies the viewed matrix into the nested vector representation used by the solvers
+        /// </summary>
+        std::vector<std::vector<double>> ToMatrix() const {
+            std::vector<std::vector<double>> A(rows, std::vector<double>(cols));
+            for (std::size_t i = 0; i < rows; i++) {
+                for (std::size_t j = 0; j < cols; j++) {
+                    A[i][j] = (*this)(i, j);
+                }
+            }
+            return A;
+        }
+    };
+
+    /// <summary>
+    /// computes the 64-bit FNV-1a checksum of the payload, processed as 64-bit words
+    /// </summary>
+    /// <param name="data">
+    /// pointer to the first payload byte
+    /// </param>
+    /// <param name="size">
+    /// number of payload bytes
+    /// </param>
+    /// <returns>
+    /// checksum stored in BinaryMatrixHeader::checksum
+    /// </returns>
+    std::uint64_t BinaryChecksum(const void* data, std::size_t size);
+
+    /// <summary>
+    /// builds the complete header, including the payload checksum, for matrix A and vector b without writing anything.
+    /// Used by writers that cannot seek back to patch the header, such as BufferedWriter.
+    /// </summary>
+    /// <param name="A">
+    /// matrix to describe, every row must have the same length
+    /// </param>
+    /// <param name="b">
+    /// vector to describe
+    /// </param>
+    /// <returns>
+    /// header of a row-major float64 file holding A and b
+    /// </returns>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if the rows of A do not have the same length
+    /// </exception>
+    BinaryMatrixHeader MakeBinaryMatrixHeader(const std::vector<std::vector<double>>& A, const std::vector<double>& b);
+
+    /// <summary>
+    /// writes matrix A and vector b to a file in the binary matrix format (row-major, float64)
+    /// </summary>
+    /// <param name="target">
+    /// path of the file to create or overwrite
+    /// </param>
+    /// <param name="A">
+    /// matrix to store, every row must have the same length; may be empty for a vector-only file
+    /// </param>
+    /// <param name="b">
+    /// vector to store; may be empty for a matrix-only file
+    /// </param>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if the rows of A do not have the same length
+    /// </exception>
+    /// <exception cref="std::runtime_error">
+    /// thrown if the file cannot be written
+    /// </exception>
+    void WriteBinaryMatrix(const std::string& target, const std::vector<std::vector<double>>& A, const std::vector<double>& b);
+
+    /// <summary>
+    /// converts a file in the text format read by LoadMatrix into the binary matrix format
+    /// </summary>
+    /// <param name="source">
+    /// path to the text file ("header / n / b: / A:" layout)
+    /// </param>
+    /// <param name="target">
+    /// path of the binary file to create
+    /// </param>
+    /// <exception cref="std::runtime_error">
+    /// thrown if the text file cannot be read or the binary file cannot be written
+    /// </exception>
+    void ConvertTextToBinary(const std::string& source, const std::string& target);
+
+    /// <summary>
+    /// read-only memory mapping of a binary matrix file. The matrix and vector are accessed in place,
+    /// without copying the payload; the mapping is released when the object is destroyed.
+    /// </summary>
+    class MappedMatrix
+    {
+        const unsigned char* base = nullptr;
+        std::size_t size = 0;
+        BinaryMatrixHeader header{};
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+
+        void Release();
+
+    public:
+        /// <summary>
+        /// maps a binary matrix file into memory and validates its header
+        /// </summary>
+        /// <param name="source">
+        /// path to the binary matrix file
+        /// </param>
+        /// <param name="verifyChecksum">
+        /// if true the payload checksum is recomputed, which touches every page of the file
+        /// </param>
+        /// <exception cref="std::runtime_error">
+        /// thrown if the file cannot be opened or mapped
+        /// </exception>
+        /// <exception cref="BinaryMatrixFormatError">
+        /// thrown if the file is too short, the header is invalid or the checksum does not match
+        /// </exception>
+        explicit MappedMatrix(const std::string& source, bool verifyChecksum = false);
+        ~MappedMatrix();
+
+        MappedMatrix(const MappedMatrix&) = delete;
+        MappedMatrix& operator=(const MappedMatrix&) = delete;
+        MappedMatrix(MappedMatrix&& other) noexcept;
+        MappedMatrix& operator=(MappedMatrix&& other) noexcept;
+
+        std::size_t rows() const { return static_cast<std::size_t>(header.rows); }
+        std::size_t cols() const { return static_cast<std::size_t>(header.cols); }
+        std::size_t vectorLength() const { return static_cast<std::size_t>(header.vectorLength); }
+        BinaryLayout layout() const { return header.layout; }
+
+        /// <summary>
+        /// returns a zero-copy view of the mapped matrix
+        /// </summary>
+        MatrixView matrix() const;
+
+        /// <summary>
+        /// returns a pointer to the first element of the mapped vector, or nullptr if the file has no vector
+        /// </summary>
+        const double* vector() const;
+
+        /// <summary>
+        /// verifies the payload checksum stored in the header
+        /// </summary>
+        /// <returns>
+        /// true if the checksum matches the payload
+        /// </returns>
+        bool VerifyChecksum() const;
+    };
+
+    /// <summary>
+    /// loads matrix A and vector B from a binary matrix file, replacement for the text based LoadMatrix
+    /// </summary>
+    /// <param name="source">
+    /// path to the binary matrix file
+    /// </param>
+    /// <param name="A">
+    /// matrix A to be filled with the data from the file
+    /// </param>
+    /// <param name="B">
+    /// vector B to be filled with the data from the file
+    /// </param>
+    /// <exception cref="std::runtime_error">
+    /// thrown if the file cannot be mapped or is not a valid binary matrix file
+    /// </exception>
+    void LoadMatrixBinary(const std::string& source, std::vector<std::vector<double>>& A, std::vector<double>& B);
+
+} // namespace NumericLib
@@ -0,0 +1,132 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "liniear_systems/sparse_matrix.hpp"
+
+namespace NumericLib {
+
+    /// <summary>
+    /// storage format of a Matrix Market file: sparse "coordinate" or dense column-major "array"
+    /// </summary>
+    enum class MatrixMarketFormat {
+        Coordinate,
+        Array
+    };
+
+    /// <summary>
+    /// symmetry of a Matrix Market file; symmetric files store only the lower triangle
+    /// </summary>
+    enum class MatrixMarketSymmetry {
+        General,
+        Symmetric
+    };
+
+    /// <summary>
+    /// information read from the banner and size line of a Matrix Market file
+    /// </summary>
+    struct MatrixMarketInfo {
+        MatrixMarketFormat format = MatrixMarketFormat::Coordinate;
+        MatrixMarketSymmetry symmetry = MatrixMarketSymmetry::General;
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+        /// <summary>
+        /// number of entries stored in the file (before symmetric expansion)
+        /// </summary>
+        std::size_t entries = 0;
+    };
+
+    /// <summary>
+    /// reads only the banner and size line of a Matrix Market file
+    /// </summary>
+    /// <param name="source">
+    /// path to the .mtx file
+    /// </param>
+    /// <returns>
+    /// format, symmetry and dimensions of the stored matrix
+    /// </returns>
+    /// <exception cref="std::runtime_error">
+    /// thrown if the file cannot be opened or is not a real/integer general/symmetric Matrix Market matrix
+    /// </exception>
+    MatrixMarketInfo ReadMatrixMarketInfo(const std::string& source);
+
+    /// <summary>
+    /// reads a coordinate Matrix Market file directly into CSR storage, parsing the file in parallel chunks.
+    /// Entries of symmetric files are mirrored so the result holds the full matrix; duplicate entries are kept.
+    /// </summary>
+    /// <param name="source">
+    /// path to the .mtx file
+    /// </param>
+    /// <param name="threads">
+    /// number of parser threads, 0 selects the hardware concurrency
+    /// </param>
+    /// <returns>
+    /// sparse matrix with sorted column indices in every row
+    /// </returns>
+    /// <exception cref="std::runtime_error">
+    /// thrown if the file is not a coordinate Matrix Market file or contains malformed or out of range entries
+    /// </exception>
+    CsrMatrix ReadMatrixMarketSparse(const std::string& source, unsigned threads = 0);
+
+    /// <summary>
+    /// reads a coordinate or array Matrix Market file directly into dense storage, parsing the file in parallel chunks.
+    /// Duplicate coordinate entries are summed, as in CsrMatrix::ToDense.
+    /// </summary>
+    /// <param name="source">
+    /// path to the .mtx file
+    /// </param>
+    /// <param name="threads">
+    /// number of parser threads, 0 selects the hardware concurrency
+    /// </param>
+    /// <returns>
+    /// dense matrix in the nested vector representation used by the solvers
+    /// </returns>
+    /// <exception cref="std::runtime_error">
+    /// thrown if the file is not a supported Matrix Market file or contains malformed or out of range entries
+    /// </exception>
+    std::vector<std::vector<double>> ReadMatrixMarketDense(const std::string& source, unsigned threads = 0);
+
+    /// <summary>
+    /// writes a dense matrix in Matrix Market array format
+    /// </summary>
+    /// <param name="target">
+    /// path of the .mtx file to create or overwrite
+    /// </param>
+    /// <param name="A">
+    /// matrix to write, every row must have the same length
+    /// </param>
+    /// <param name="symmetry">
+    /// Symmetric writes only the lower triangle of the (square) matrix
+    /// </param>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if the rows of A differ in length or a symmetric matrix is not square
+    /// </exception>
+    /// <exception cref="std::runtime_error">
+    /// thrown if the file cannot be written
+    /// </exception>
+    void WriteMatrixMarket(const std::string& target, const std::vector<std::vector<double>>& A,
+        MatrixMarketSymmetry symmetry = MatrixMarketSymmetry::General);
+
+    /// <summary>
+    /// writes a sparse matrix in Matrix Market coordinate format
+    /// </summary>
+    /// <param name="target">
+    /// path of the .mtx file to create or overwrite
+    /// </param>
+    /// <param name="A">
+    /// matrix to write
+    /// </param>
+    /// <param name="symmetry">
+    /// Symmetric writes only the entries on or below the diagonal of the (square) matrix
+    /// </param>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if a symmetric matrix is not square
+    /// </exception>
+    /// <exception cref="std::runtime_error">
+    /// thrown if the file cannot be written
+    /// </exception>
+    void WriteMatrixMarket(const std::string& target, const CsrMatrix& A,
+        MatrixMarketSymmetry symmetry = MatrixMarketSymmetry::General);
+
+} // namespace NumericLib
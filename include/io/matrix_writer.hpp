@@ -0,0 +1,193 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace NumericLib {
+
+    /// <summary>
+    /// output formats supported by WriteMatrix, WriteVector and WriteIterations
+    /// </summary>
+    enum class OutputFormat {
+        Csv,
+        Tsv,
+        Aligned,
+        Binary
+    };
+
+    /// <summary>
+    /// output sink that collects text in a large buffer and hands it to a file descriptor or stream only when the buffer is full
+    /// or on Flush. Numbers are formatted with std::to_chars. With background writing enabled, full buffers are written by a
+    /// worker thread while the caller keeps formatting into a second buffer.
+    /// </summary>
+    class BufferedWriter
+    {
+        int fd = -1;
+        std::ostream* stream = nullptr;
+        std::unique_ptr<std::ostream> ownedStream;
+
+        std::vector<char> buffer;
+        std::size_t used = 0;
+        int precision = 0;
+
+        bool background = false;
+        std::thread worker;
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::vector<char> pending;
+        std::size_t pendingSize = 0;
+        bool hasPending = false;
+        bool stopping = false;
+        std::exception_ptr error;
+
+        void Start(std::size_t bufferSize, bool useBackground);
+        void Sink(const char* data, std::size_t size);
+        void Submit();
+        void WorkerLoop();
+
+    public:
+        /// <summary>
+        /// creates a writer on an open file descriptor; the descriptor is not closed by the writer
+        /// </summary>
+        /// <param name="fileDescriptor">
+        /// descriptor to write to, e.g. 1 for the standard output
+        /// </param>
+        /// <param name="bufferSize">
+        /// size of the buffer in bytes
+        /// </param>
+        /// <param name="useBackground">
+        /// if true full buffers are written by a background thread
+        /// </param>
+        explicit BufferedWriter(int fileDescriptor, std::size_t bufferSize = 1 << 20, bool useBackground = false);
+
+        /// <summary>
+        /// creates a writer on an output stream, which must outlive the writer
+        /// </summary>
+        explicit BufferedWriter(std::ostream& output, std::size_t bufferSize = 1 << 20, bool useBackground = false);
+
+        /// <summary>
+        /// creates a writer on a newly created file
+        /// </summary>
+        /// <exception cref="std::runtime_error">
+        /// thrown if the file cannot be opened
+        /// </exception>
+        explicit BufferedWriter(const std::string& target, std::size_t bufferSize = 1 << 20, bool useBackground = false);
+
+        /// <summary>
+        /// flushes the remaining data and stops the background thread; write errors are ignored here, call Flush to observe them
+        /// </summary>
+        ~BufferedWriter();
+
+        BufferedWriter(const BufferedWriter&) = delete;
+        BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+        /// <summary>
+        /// sets the number of significant digits used for doubles, 0 selects the shortest representation that round-trips
+        /// </summary>
+        void SetPrecision(int digits) { precision = digits; }
+
+        /// <summary>
+        /// appends raw bytes
+        /// </summary>
+        void Write(const char* data, std::size_t size);
+
+        /// <summary>
+        /// appends text
+        /// </summary>
+        void Write(std::string_view text) { Write(text.data(), text.size()); }
+
+        /// <summary>
+        /// appends a single character
+        /// </summary>
+        void Put(char c) {
+            if (used == buffer.size()) Submit();
+            buffer[used++] = c;
+        }
+
+        /// <summary>
+        /// appends a double, right-aligned in a field of the given width
+        /// </summary>
+        void WriteNumber(double value, int width = 0);
+
+        /// <summary>
+        /// appends an unsigned integer, right-aligned in a field of the given width
+        /// </summary>
+        void WriteNumber(std::size_t value, int width = 0);
+
+        /// <summary>
+        /// writes all buffered data to the underlying descriptor or stream and waits for the background thread
+        /// </summary>
+        /// <exception cref="std::runtime_error">
+        /// thrown if writing to the descriptor or stream failed
+        /// </exception>
+        void Flush();
+    };
+
+    /// <summary>
+    /// writes matrix A, one row per line (or the binary matrix format)
+    /// </summary>
+    /// <param name="out">
+    /// destination writer
+    /// </param>
+    /// <param name="A">
+    /// matrix to write
+    /// </param>
+    /// <param name="format">
+    /// CSV, TSV, aligned text or binary matrix format
+    /// </param>
+    void WriteMatrix(BufferedWriter& out, const std::vector<std::vector<double>>& A, OutputFormat format = OutputFormat::Csv);
+
+    /// <summary>
+    /// writes the augmented matrix [A | b]; in text formats b is the last column of every row
+    /// </summary>
+    /// <param name="out">
+    /// destination writer
+    /// </param>
+    /// <param name="A">
+    /// matrix to write
+    /// </param>
+    /// <param name="b">
+    /// right-hand side vector, one element per row of A
+    /// </param>
+    /// <param name="format">
+    /// CSV, TSV, aligned text or binary matrix format
+    /// </param>
+    /// <exception cref="std::invalid_argument">
+    /// thrown if b does not have one element per row of A
+    /// </exception>
+    void WriteMatrix(BufferedWriter& out, const std::vector<std::vector<double>>& A, const std::vector<double>& b, OutputFormat format = OutputFormat::Csv);
+
+    /// <summary>
+    /// writes a vector (e.g. a solution), one element per line (or the binary matrix format)
+    /// </summary>
+    void WriteVector(BufferedWriter& out, const std::vector<double>& x, OutputFormat format = OutputFormat::Csv);
+
+    /// <summary>
+    /// writes the iterations of a numerical method as rows of iteration number, value and error |x_n - root|,
+    /// the buffered counterpart of print_iterations
+    /// </summary>
+    /// <param name="out">
+    /// destination writer
+    /// </param>
+    /// <param name="values">
+    /// successive approximations
+    /// </param>
+    /// <param name="root">
+    /// root value for comparison
+    /// </param>
+    /// <param name="format">
+    /// CSV, TSV or aligned text
+    /// </param>
+    /// <exception cref="std::invalid_argument">
+    /// thrown for the binary format
+    /// </exception>
+    void WriteIterations(BufferedWriter& out, const std::vector<double>& values, double root, OutputFormat format = OutputFormat::Csv);
+
+} // namespace NumericLib
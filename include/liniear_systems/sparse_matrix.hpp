@@ -0,0 +1,67 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+
+namespace NumericLib {
+
+    /// <summary>
+    /// sparse matrix in compressed sparse row (CSR) storage. Column indices of every row are sorted in increasing order.
+    /// </summary>
+    struct CsrMatrix {
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+        /// <summary>
+        /// rows + 1 offsets into colIdx and values, row i occupies [rowPtr[i], rowPtr[i + 1])
+        /// </summary>
+        std::vector<std::size_t> rowPtr;
+        std::vector<std::size_t> colIdx;
+        std::vector<double> values;
+
+        /// <summary>
+        /// returns the number of stored entries
+        /// </summary>
+        std::size_t nonZeros() const { return values.size(); }
+
+        /// <summary>
+        /// computes the product y = A * x
+        /// </summary>
+        /// <param name="x">
+        /// vector of size cols
+        /// </param>
+        /// <returns>
+        /// vector of size rows
+        /// </returns>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if x does not have cols elements
+        /// </exception>
+        std::vector<double> Multiply(const std::vector<double>& x) const {
+            if (x.size() != cols)
+                throw std::invalid_argument("Vector size must match the number of matrix columns.");
+
+            std::vector<double> y(rows, 0.0);
+            for (std::size_t i = 0; i < rows; i++) {
+                double sum = 0.0;
+                for (std::size_t k = rowPtr[i]; k < rowPtr[i + 1]; k++) {
+                    sum += values[k] * x[colIdx[k]];
+                }
+                y[i] = sum;
+            }
+            return y;
+        }
+
+        /// <summary>
+        /// expands the matrix into the dense nested vector representation used by the solvers
+        /// </summary>
+        std::vector<std::vector<double>> ToDense() const {
+            std::vector<std::vector<double>> A(rows, std::vector<double>(cols, 0.0));
+            for (std::size_t i = 0; i < rows; i++) {
+                for (std::size_t k = rowPtr[i]; k < rowPtr[i + 1]; k++) {
+                    A[i][colIdx[k]] += values[k];
+                }
+            }
+            return A;
+        }
+    };
+
+} // namespace NumericLib
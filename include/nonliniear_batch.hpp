@@ -0,0 +1,325 @@
+#pragma once
+#include "parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace NumericLib {
+
+    /// <summary>
+    /// Outcome of one equation of a batched root search.
+    /// Converged: the residual or bracket fell below the tolerance. NoSignChange: the bracket does not change sign.
+    /// ZeroDerivative: Newton's method met a vanishing derivative. MaxIterations: the iteration limit was reached.
+    /// </summary>
+    enum class BatchRootStatus {
+        Converged,
+        NoSignChange,
+        ZeroDerivative,
+        MaxIterations
+    };
+
+    /// <summary>
+    /// Roots, statuses and iteration counts of a batched root search, one entry per equation.
+    /// Equations without a usable result have a NaN root.
+    /// </summary>
+    struct BatchRootResult {
+        std::vector<double> roots;
+        std::vector<BatchRootStatus> status;
+        std::vector<int> iterations;
+    };
+
+    /// <summary>
+    /// Number of equations iterated side by side by one thread; finished lanes are refilled with new equations.
+    /// </summary>
+    constexpr std::size_t BatchRootLanes = parallel::BlockSize;
+
+    /// <summary>
+    /// Below this many equations a batched root search stays on the calling thread.
+    /// </summary>
+    constexpr std::size_t ParallelBatchRootEquations = parallel::ParallelBlocks * BatchRootLanes;
+
+    /// <summary>
+    /// Working set of a batched root search in structure-of-arrays form, so every per-lane update is a loop
+    /// over contiguous arrays that the compiler can vectorize.
+    /// </summary>
+    struct BatchRootLaneSet {
+        std::vector<std::size_t> equation;
+        std::vector<double> a, b, fa, fb, x, fx, dfx, side;
+        std::vector<int> iterations;
+        std::vector<BatchRootStatus> status;
+        std::vector<unsigned char> done;
+        std::size_t active = 0;
+
+        BatchRootLaneSet()
+            : equation(BatchRootLanes), a(BatchRootLanes), b(BatchRootLanes), fa(BatchRootLanes), fb(BatchRootLanes),
+            x(BatchRootLanes), fx(BatchRootLanes), dfx(BatchRootLanes), side(BatchRootLanes), iterations(BatchRootLanes),
+            status(BatchRootLanes), done(BatchRootLanes) {}
+
+        /// <summary>
+        /// Copies the state of lane from into lane to.
+        /// </summary>
+        void Move(std::size_t from, std::size_t to) {
+            equation[to] = equation[from];
+            a[to] = a[from]; b[to] = b[from]; fa[to] = fa[from]; fb[to] = fb[from];
+            x[to] = x[from]; fx[to] = fx[from]; dfx[to] = dfx[from]; side[to] = side[from];
+            iterations[to] = iterations[from];
+        }
+
+        /// <summary>
+        /// Writes the root, status and iteration count of every finished lane into the result.
+        /// </summary>
+        void Finish(BatchRootResult& result) const {
+            for (std::size_t i = 0; i < active; i++) {
+                if (!done[i]) continue;
+                const std::size_t e = equation[i];
+                result.roots[e] = status[i] == BatchRootStatus::ZeroDerivative ? std::numeric_limits<double>::quiet_NaN() : x[i];
+                result.iterations[e] = iterations[i];
+                result.status[e] = status[i];
+            }
+        }
+    };
+
+    /// <summary>
+    /// Drives a batched root search: every thread keeps BatchRootLanes equations in flight, evaluates the function for
+    /// all active lanes in one call, lets the method update the lanes, then compacts the finished lanes away and
+    /// refills them with equations claimed from a shared counter. Large batches run on the shared thread pool, so the
+    /// callables must be safe to call from several threads at once.
+    /// </summary>
+    /// <typeparam name="Prepare">Callable void(std::size_t begin, std::size_t end), run once for every claimed block of equations.</typeparam>
+    /// <typeparam name="Load">Callable bool(BatchRootLaneSet&amp;, std::size_t lane, std::size_t equation); false if the equation finished on loading.</typeparam>
+    /// <typeparam name="Iterate">Callable void(BatchRootLaneSet&amp;), which evaluates and updates the active lanes and sets done.</typeparam>
+    /// <param name="count">Number of equations.</param>
+    template<typename Prepare, typename Load, typename Iterate>
+    void runBatchRootLanes(std::size_t count, Prepare prepare, Load load, Iterate iterate) {
+        // Not parallel::ForEachBlock: a lane set outlives the block it was loaded from, since lanes freed by converged
+        // equations are refilled from the next block instead of idling until the slowest equation of a block finishes.
+        std::atomic<std::size_t> next{ 0 };
+
+        auto worker = [&]() {
+            BatchRootLaneSet lanes;
+            std::size_t claimed = 0, claimedEnd = 0;
+            while (true) {
+                while (lanes.active < BatchRootLanes) {
+                    if (claimed == claimedEnd) {
+                        claimed = next.fetch_add(BatchRootLanes);
+                        if (claimed >= count) {
+                            claimed = claimedEnd = count;
+                            break;
+                        }
+                        claimedEnd = std::min(count, claimed + BatchRootLanes);
+                        prepare(claimed, claimedEnd);
+                    }
+                    if (load(lanes, lanes.active, claimed++)) lanes.active++;
+                }
+                if (lanes.active == 0) return;
+
+                iterate(lanes);
+
+                std::size_t kept = 0;
+                for (std::size_t i = 0; i < lanes.active; i++) {
+                    if (lanes.done[i]) continue;
+                    if (kept != i) lanes.Move(i, kept);
+                    kept++;
+                }
+                lanes.active = kept;
+            }
+        };
+
+        if (count < ParallelBatchRootEquations) {
+            worker();
+            return;
+        }
+        parallel::ThreadPool& pool = parallel::ThreadPool::Shared();
+        const std::size_t workers = std::min<std::size_t>(pool.size(), (count + BatchRootLanes - 1) / BatchRootLanes);
+        pool.Run(workers, [&](std::size_t) { worker(); });
+    }
+
+    /// <summary>
+    /// Evaluates a batched function at the end points of a block of brackets and stores the values.
+    /// </summary>
+    template<typename Func>
+    void evaluateBatchBrackets(Func& f, const std::vector<double>& a, const std::vector<double>& b, std::vector<double>& fa,
+        std::vector<double>& fb, std::size_t begin, std::size_t end) {
+        std::size_t equations[BatchRootLanes];
+        for (std::size_t i = begin; i < end; i++) equations[i - begin] = i;
+        f(equations, a.data() + begin, fa.data() + begin, end - begin);
+        f(equations, b.data() + begin, fb.data() + begin, end - begin);
+    }
+
+    /// <summary>
+    /// Loads a bracket into a lane, or finishes the equation if an end point is a root or the bracket has no sign change.
+    /// </summary>
+    inline bool loadBatchBracket(BatchRootLaneSet& lanes, std::size_t lane, std::size_t i, const std::vector<double>& a,
+        const std::vector<double>& b, const std::vector<double>& fa, const std::vector<double>& fb, BatchRootResult& result) {
+        if (fa[i] == 0.0 || fb[i] == 0.0) {
+            result.roots[i] = fa[i] == 0.0 ? a[i] : b[i];
+            result.status[i] = BatchRootStatus::Converged;
+            return false;
+        }
+        if (!(fa[i] * fb[i] < 0.0)) {
+            result.status[i] = BatchRootStatus::NoSignChange;
+            return false;
+        }
+        lanes.equation[lane] = i;
+        lanes.a[lane] = a[i];
+        lanes.b[lane] = b[i];
+        lanes.fa[lane] = fa[i];
+        lanes.fb[lane] = fb[i];
+        lanes.side[lane] = 0.0;
+        lanes.iterations[lane] = 0;
+        return true;
+    }
+
+    /// <summary>
+    /// Allocates a result for count equations, with NaN roots and MaxIterations statuses.
+    /// </summary>
+    inline BatchRootResult makeBatchRootResult(std::size_t count) {
+        return BatchRootResult{ std::vector<double>(count, std::numeric_limits<double>::quiet_NaN()),
+            std::vector<BatchRootStatus>(count, BatchRootStatus::MaxIterations), std::vector<int>(count, 0) };
+    }
+
+    /// <summary>
+    /// Solves many independent equations f_i(x) = 0 by bisection. Every lane iterates on its own bracket, and lanes that
+    /// converge are refilled with the next equation, so slow equations do not hold up the others.
+    /// </summary>
+    /// <typeparam name="Func">Callable void(const std::size_t* equation, const double* x, double* y, std::size_t count) that sets y[k] = f_equation[k](x[k]).</typeparam>
+    /// <param name="f">Batched function.</param>
+    /// <param name="a">Left endpoints of the brackets.</param>
+    /// <param name="b">Right endpoints of the brackets.</param>
+    /// <param name="tol">Tolerance for the residual and the half-width of the bracket (default 1e-8).</param>
+    /// <param name="max_iter">Maximum number of iterations per equation (default 1000).</param>
+    /// <returns>Root, status and iteration count of every equation.</returns>
+    /// <exception cref="std::invalid_argument">Thrown if a and b differ in size.</exception>
+    template<typename Func>
+    BatchRootResult bisection_batch(Func f, const std::vector<double>& a, const std::vector<double>& b, double tol = 1e-8, int max_iter = 1000) {
+        if (a.size() != b.size()) throw std::invalid_argument("Vectors a and b must have the same size.");
+
+        const std::size_t count = a.size();
+        BatchRootResult result = makeBatchRootResult(count);
+        std::vector<double> fa(count), fb(count);
+
+        runBatchRootLanes(count,
+            [&](std::size_t begin, std::size_t end) { evaluateBatchBrackets(f, a, b, fa, fb, begin, end); },
+            [&](BatchRootLaneSet& lanes, std::size_t lane, std::size_t i) { return loadBatchBracket(lanes, lane, i, a, b, fa, fb, result); },
+            [&](BatchRootLaneSet& lanes) {
+                const std::size_t n = lanes.active;
+                for (std::size_t i = 0; i < n; i++) lanes.x[i] = (lanes.a[i] + lanes.b[i]) / 2;
+                f(lanes.equation.data(), lanes.x.data(), lanes.fx.data(), n);
+
+                for (std::size_t i = 0; i < n; i++) {
+                    const double x = lanes.x[i], fx = lanes.fx[i];
+                    const bool converged = std::abs(fx) < tol || (lanes.b[i] - lanes.a[i]) / 2 < tol;
+                    const bool left = lanes.fa[i] * fx < 0;
+                    lanes.b[i] = left ? x : lanes.b[i];
+                    lanes.a[i] = left ? lanes.a[i] : x;
+                    lanes.fa[i] = left ? lanes.fa[i] : fx;
+                    lanes.iterations[i]++;
+                    lanes.status[i] = converged ? BatchRootStatus::Converged : BatchRootStatus::MaxIterations;
+                    lanes.done[i] = converged || lanes.iterations[i] >= max_iter;
+                }
+                lanes.Finish(result);
+            });
+        return result;
+    }
+
+    /// <summary>
+    /// Solves many independent equations f_i(x) = 0 by regula falsi with the Illinois modification: when the same end
+    /// of a bracket is kept twice in a row its function value is halved, so the bracket shrinks from both sides instead of
+    /// stalling on one end point. Lanes iterate independently and are refilled as they finish.
+    /// </summary>
+    /// <typeparam name="Func">Callable void(const std::size_t* equation, const double* x, double* y, std::size_t count) that sets y[k] = f_equation[k](x[k]).</typeparam>
+    /// <param name="f">Batched function.</param>
+    /// <param name="a">Left endpoints of the brackets.</param>
+    /// <param name="b">Right endpoints of the brackets.</param>
+    /// <param name="tol">Tolerance for the residual and the width of the bracket (default 1e-8).</param>
+    /// <param name="max_iter">Maximum number of iterations per equation (default 1000).</param>
+    /// <returns>Root, status and iteration count of every equation.</returns>
+    /// <exception cref="std::invalid_argument">Thrown if a and b differ in size.</exception>
+    template<typename Func>
+    BatchRootResult falsi_batch(Func f, const std::vector<double>& a, const std::vector<double>& b, double tol = 1e-8, int max_iter = 1000) {
+        if (a.size() != b.size()) throw std::invalid_argument("Vectors a and b must have the same size.");
+
+        const std::size_t count = a.size();
+        BatchRootResult result = makeBatchRootResult(count);
+        std::vector<double> fa(count), fb(count);
+
+        runBatchRootLanes(count,
+            [&](std::size_t begin, std::size_t end) { evaluateBatchBrackets(f, a, b, fa, fb, begin, end); },
+            [&](BatchRootLaneSet& lanes, std::size_t lane, std::size_t i) { return loadBatchBracket(lanes, lane, i, a, b, fa, fb, result); },
+            [&](BatchRootLaneSet& lanes) {
+                const std::size_t n = lanes.active;
+                for (std::size_t i = 0; i < n; i++) {
+                    lanes.x[i] = (lanes.a[i] * lanes.fb[i] - lanes.b[i] * lanes.fa[i]) / (lanes.fb[i] - lanes.fa[i]);
+                }
+                f(lanes.equation.data(), lanes.x.data(), lanes.fx.data(), n);
+
+                // side is -1 after the right end was replaced, +1 after the left end was replaced.
+                for (std::size_t i = 0; i < n; i++) {
+                    const double x = lanes.x[i], fx = lanes.fx[i];
+                    const bool right = fx * lanes.fb[i] > 0;
+                    lanes.fa[i] = right ? (lanes.side[i] < 0 ? lanes.fa[i] / 2 : lanes.fa[i]) : fx;
+                    lanes.fb[i] = right ? fx : (lanes.side[i] > 0 ? lanes.fb[i] / 2 : lanes.fb[i]);
+                    lanes.b[i] = right ? x : lanes.b[i];
+                    lanes.a[i] = right ? lanes.a[i] : x;
+                    lanes.side[i] = right ? -1.0 : 1.0;
+                    lanes.iterations[i]++;
+                    const bool converged = std::abs(fx) < tol || std::abs(lanes.b[i] - lanes.a[i]) < tol;
+                    lanes.status[i] = converged ? BatchRootStatus::Converged : BatchRootStatus::MaxIterations;
+                    lanes.done[i] = converged || lanes.iterations[i] >= max_iter;
+                }
+                lanes.Finish(result);
+            });
+        return result;
+    }
+
+    /// <summary>
+    /// Solves many independent equations f_i(x) = 0 by Newton's method. Every lane iterates from its own initial guess;
+    /// a vanishing derivative ends that lane with ZeroDerivative instead of throwing, and an iterate that overflows ends it
+    /// with MaxIterations; either way the lane is refilled.
+    /// </summary>
+    /// <typeparam name="Func">Callable void(const std::size_t* equation, const double* x, double* y, std::size_t count) that sets y[k] = f_equation[k](x[k]).</typeparam>
+    /// <typeparam name="Derivative">Callable with the same signature that sets y[k] to the derivative of f_equation[k] at x[k].</typeparam>
+    /// <param name="f">Batched function.</param>
+    /// <param name="x0">Initial guesses.</param>
+    /// <param name="df">Batched derivative.</param>
+    /// <param name="tol">Tolerance for the residual (default 1e-8).</param>
+    /// <param name="max_iter">Maximum number of iterations per equation (default 1000).</param>
+    /// <returns>Root, status and iteration count of every equation.</returns>
+    template<typename Func, typename Derivative>
+    BatchRootResult newton_batch(Func f, const std::vector<double>& x0, Derivative df, double tol = 1e-8, int max_iter = 1000) {
+        const std::size_t count = x0.size();
+        BatchRootResult result = makeBatchRootResult(count);
+
+        runBatchRootLanes(count,
+            [](std::size_t, std::size_t) {},
+            [&](BatchRootLaneSet& lanes, std::size_t lane, std::size_t i) {
+                lanes.equation[lane] = i;
+                lanes.x[lane] = x0[i];
+                lanes.iterations[lane] = 0;
+                return true;
+            },
+            [&](BatchRootLaneSet& lanes) {
+                const std::size_t n = lanes.active;
+                f(lanes.equation.data(), lanes.x.data(), lanes.fx.data(), n);
+                df(lanes.equation.data(), lanes.x.data(), lanes.dfx.data(), n);
+
+                for (std::size_t i = 0; i < n; i++) {
+                    const bool converged = std::abs(lanes.fx[i]) < tol;
+                    const bool flat = !converged && std::abs(lanes.dfx[i]) < std::numeric_limits<double>::epsilon();
+                    const bool step = !converged && !flat;
+                    lanes.x[i] = step ? lanes.x[i] - lanes.fx[i] / lanes.dfx[i] : lanes.x[i];
+                    lanes.iterations[i] += step ? 1 : 0;
+                    lanes.status[i] = converged ? BatchRootStatus::Converged
+                        : (flat ? BatchRootStatus::ZeroDerivative : BatchRootStatus::MaxIterations);
+                    lanes.done[i] = !step || lanes.iterations[i] >= max_iter || !std::isfinite(lanes.x[i]);
+                }
+                lanes.Finish(result);
+            });
+        return result;
+    }
+
+} // namespace NumericLib
@@ -0,0 +1,235 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NumericLib {
+    namespace parallel {
+
+        /// <summary>
+        /// returns the number of threads used when the caller does not request a specific count
+        /// </summary>
+        inline unsigned DefaultThreadCount() {
+            unsigned count = std::thread::hardware_concurrency();
+            return count == 0 ? 1 : count;
+        }
+
+        /// <summary>
+        /// number of points per block of the batch evaluation loops: the scratch arrays of a block stay in the L1 cache,
+        /// and the loops over the points of a block are long enough for the compiler to vectorize
+        /// </summary>
+        constexpr std::size_t BlockSize = 256;
+
+        /// <summary>
+        /// smallest number of blocks ForEachBlock hands to the shared thread pool; fewer blocks run on the calling thread
+        /// </summary>
+        constexpr std::size_t ParallelBlocks = 16;
+
+        /// <summary>
+        /// runs fn(chunk) for every chunk in [0, chunks), each chunk on its own thread.
+        /// The calling thread processes chunk 0; the first exception thrown by any chunk is rethrown after all threads finish.
+        /// </summary>
+        /// <typeparam name="Func">
+        /// callable accepting the chunk index as std::size_t
+        /// </typeparam>
+        /// <param name="chunks">
+        /// number of chunks to process
+        /// </param>
+        /// <param name="fn">
+        /// work to run for every chunk
+        /// </param>
+        template <typename Func>
+        void RunChunks(std::size_t chunks, Func fn) {
+            if (chunks == 0) return;
+
+            std::vector<std::exception_ptr> errors(chunks);
+            std::vector<std::thread> workers;
+            workers.reserve(chunks - 1);
+
+            for (std::size_t c = 1; c < chunks; c++) {
+                workers.emplace_back([&fn, &errors, c]() {
+                    try { fn(c); }
+                    catch (...) { errors[c] = std::current_exception(); }
+                    });
+            }
+
+            try { fn(0); }
+            catch (...) { errors[0] = std::current_exception(); }
+
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            for (auto& error : errors) {
+                if (error) std::rethrow_exception(error);
+            }
+        }
+
+        /// <summary>
+        /// fixed set of worker threads that stay alive between calls, so short parallel loops do not pay for thread creation.
+        /// The calling thread always takes part in the work, which makes nested calls from inside a task safe.
+        /// </summary>
+        class ThreadPool
+        {
+            struct Batch {
+                std::function<void(std::size_t)> fn;
+                std::size_t count = 0;
+                std::atomic<std::size_t> next{ 0 };
+                std::size_t finished = 0;
+                std::exception_ptr error;
+            };
+
+            std::vector<std::thread> workers;
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::condition_variable done;
+            std::deque<std::shared_ptr<Batch>> queue;
+            bool stopping = false;
+
+            // Runs tasks of the batch until none are left; must be called with the lock held.
+            void Drain(const std::shared_ptr<Batch>& batch, std::unique_lock<std::mutex>& lock) {
+                for (std::size_t task = batch->next++; task < batch->count; task = batch->next++) {
+                    lock.unlock();
+                    std::exception_ptr error;
+                    try { batch->fn(task); }
+                    catch (...) { error = std::current_exception(); }
+                    lock.lock();
+
+                    if (error && !batch->error) batch->error = error;
+                    if (++batch->finished == batch->count) done.notify_all();
+                }
+                auto it = std::find(queue.begin(), queue.end(), batch);
+                if (it != queue.end()) queue.erase(it);
+            }
+
+            void WorkerLoop() {
+                std::unique_lock<std::mutex> lock(mutex);
+                while (true) {
+                    wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+                    if (queue.empty()) return;
+                    std::shared_ptr<Batch> batch = queue.front();
+                    Drain(batch, lock);
+                }
+            }
+
+        public:
+            /// <summary>
+            /// starts the worker threads
+            /// </summary>
+            /// <param name="threads">
+            /// total number of threads working on a call, including the calling thread
+            /// </param>
+            explicit ThreadPool(unsigned threads = DefaultThreadCount()) {
+                for (unsigned t = 1; t < threads; t++) {
+                    workers.emplace_back([this]() { WorkerLoop(); });
+                }
+            }
+
+            /// <summary>
+            /// finishes the queued work and joins the worker threads
+            /// </summary>
+            ~ThreadPool() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stopping = true;
+                }
+                wake.notify_all();
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+            }
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            /// <summary>
+            /// returns the number of threads working on a call, including the calling thread
+            /// </summary>
+            unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+            /// <summary>
+            /// runs fn(task) for every task in [0, tasks) on the pool and the calling thread and waits for all of them.
+            /// The first exception thrown by any task is rethrown after all tasks finish.
+            /// </summary>
+            /// <typeparam name="Func">
+            /// callable accepting the task index as std::size_t
+            /// </typeparam>
+            /// <param name="tasks">
+            /// number of tasks to run
+            /// </param>
+            /// <param name="fn">
+            /// work to run for every task
+            /// </param>
+            template <typename Func>
+            void Run(std::size_t tasks, Func fn) {
+                if (tasks == 0) return;
+
+                auto batch = std::make_shared<Batch>();
+                batch->fn = std::ref(fn);
+                batch->count = tasks;
+
+                std::unique_lock<std::mutex> lock(mutex);
+                if (tasks > 1 && !workers.empty()) {
+                    queue.push_back(batch);
+                    wake.notify_all();
+                }
+                Drain(batch, lock);
+                done.wait(lock, [&batch]() { return batch->finished == batch->count; });
+
+                if (batch->error) std::rethrow_exception(batch->error);
+            }
+
+            /// <summary>
+            /// returns the process-wide pool with DefaultThreadCount threads, created on first use
+            /// </summary>
+            static ThreadPool& Shared() {
+                static ThreadPool pool;
+                return pool;
+            }
+        };
+
+        /// <summary>
+        /// runs fn(block) for every block in [0, blocks), on the shared thread pool when there are at least ParallelBlocks
+        /// blocks and on the calling thread otherwise
+        /// </summary>
+        /// <typeparam name="Func">
+        /// callable accepting the block index as std::size_t; it is called from several threads at once
+        /// </typeparam>
+        /// <param name="blocks">
+        /// number of blocks
+        /// </param>
+        /// <param name="fn">
+        /// work to run for every block
+        /// </param>
+        /// <param name="threads">
+        /// maximum number of threads, 0 uses all threads of the shared pool
+        /// </param>
+        template <typename Func>
+        void ForEachBlock(std::size_t blocks, Func fn, unsigned threads = 0) {
+            if (blocks < ParallelBlocks || threads == 1) {
+                for (std::size_t block = 0; block < blocks; block++) fn(block);
+                return;
+            }
+
+            ThreadPool& pool = ThreadPool::Shared();
+            if (threads == 0 || threads >= pool.size()) {
+                pool.Run(blocks, fn);
+                return;
+            }
+
+            // Fewer tasks than pool threads, each taking blocks until none are left.
+            std::atomic<std::size_t> next{ 0 };
+            pool.Run(threads, [&](std::size_t) {
+                for (std::size_t block = next++; block < blocks; block = next++) fn(block);
+                });
+        }
+
+    } // namespace parallel
+} // namespace NumericLib
@@ -0,0 +1,166 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace NumericLib {
+
+    /// <summary>
+    /// degree of the smaller factor above which polynomial products and divisions switch to FFT-based algorithms
+    /// </summary>
+    constexpr std::size_t PolynomialFFTThreshold = 64;
+
+    /// <summary>
+    /// number of points per leaf of the subproduct trees; leaves are evaluated and interpolated directly
+    /// </summary>
+    constexpr std::size_t SubproductLeafSize = 16;
+
+    /// <summary>
+    /// largest residual at the points, relative to max |y|, accepted from Polynomial::Interpolate
+    /// </summary>
+    constexpr double SubproductCheckTolerance = 1e-8;
+
+    /// <summary>
+    /// largest number of iterative refinement steps of Polynomial::Interpolate
+    /// </summary>
+    constexpr std::size_t SubproductRefinementSteps = 3;
+
+    /// <summary>
+    /// lowest degree at which Polynomial::EvaluateMultipoint uses the subproduct tree instead of the batch Evaluate
+    /// </summary>
+    constexpr std::size_t SubproductMinDegree = 16384;
+
+    /// <summary>
+    /// largest (degree + 1) max |x| for which Polynomial::EvaluateMultipoint uses the subproduct tree; the rounding
+    /// errors of its remainders grow about exponentially in this product
+    /// </summary>
+    constexpr double SubproductMaxSpread = 128.0;
+
+    /// <summary>
+    /// polynomial in the monomial basis, sum c_i x^i, with FFT-based multiplication and division and subproduct-tree
+    /// multipoint evaluation and interpolation. Trailing zero coefficients are removed, so the zero polynomial has the
+    /// single coefficient 0.
+    /// </summary>
+    class Polynomial
+    {
+        std::vector<double> coeffs;
+
+        void Trim();
+
+    public:
+        /// <summary>
+        /// creates the zero polynomial
+        /// </summary>
+        Polynomial();
+
+        /// <summary>
+        /// creates a polynomial from its coefficients, where coefficients[i] is the coefficient for x^i
+        /// </summary>
+        explicit Polynomial(std::vector<double> coefficients);
+
+        /// <summary>
+        /// builds the monic polynomial prod (x - roots[i]) with a product tree of FFT multiplications
+        /// </summary>
+        static Polynomial FromRoots(const std::vector<double>& roots);
+
+        /// <summary>
+        /// computes the polynomial of degree below x.size() through the points (x[i], y[i]) in O(n log^2 n) operations.
+        /// The interpolant is built as a Chebyshev series on [min x, max x] with a subproduct tree in the Chebyshev basis
+        /// whose nodes take interleaved subsets of the sorted points, so that every node spreads over the interval and
+        /// stays well-conditioned, and is improved by up to SubproductRefinementSteps steps of iterative refinement.
+        /// Coefficients at the rounding level are then dropped and the rest converted to monomials, which amplifies
+        /// errors by up to (1 + sqrt 2)^k at degree k. The result is therefore accurate only for data whose Chebyshev
+        /// coefficients decay quickly, such as samples of an analytic function: thousands of points clustered at the
+        /// ends of the interval like Chebyshev points, but only about 50 equispaced or random points, beyond which the
+        /// interpolation problem itself is too ill-conditioned. BarycentricInterpolant is the stable alternative when
+        /// the monomial coefficients are not needed.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if x and y differ in size, are empty or x contains repeated points
+        /// </exception>
+        /// <exception cref="std::domain_error">
+        /// thrown if the interpolant misses the data at a point by more than SubproductCheckTolerance relative to max |y|,
+        /// or its Chebyshev coefficients decay too slowly for that to be possible in the monomial basis
+        /// </exception>
+        static Polynomial Interpolate(const std::vector<double>& x, const std::vector<double>& y);
+
+        /// <summary>
+        /// returns the degree; the zero polynomial has degree 0
+        /// </summary>
+        std::size_t Degree() const { return coeffs.size() - 1; }
+
+        /// <summary>
+        /// returns the coefficients, where the i-th element is the coefficient for x^i
+        /// </summary>
+        const std::vector<double>& Coefficients() const { return coeffs; }
+
+        /// <summary>
+        /// returns the coefficient for x^i, or 0 above the degree
+        /// </summary>
+        double operator[](std::size_t i) const { return i < coeffs.size() ? coeffs[i] : 0.0; }
+
+        /// <summary>
+        /// evaluates the polynomial at x with a second-order Horner scheme: the even and odd coefficients are two
+        /// independent Horner chains in x^2, which halves the dependency chain of the plain scheme
+        /// </summary>
+        double Evaluate(double x) const;
+
+        /// <summary>
+        /// evaluates the polynomial at count points, running Horner's scheme on a block of points per coefficient
+        /// </summary>
+        void Evaluate(const double* x, double* y, std::size_t count) const;
+
+        /// <summary>
+        /// evaluates the polynomial at every element of x
+        /// </summary>
+        std::vector<double> Evaluate(const std::vector<double>& x) const;
+
+        /// <summary>
+        /// evaluates the polynomial at x
+        /// </summary>
+        double operator()(double x) const { return Evaluate(x); }
+
+        /// <summary>
+        /// evaluates the polynomial at every element of x by successive remainders down subproduct trees over chunks of
+        /// Degree() + 1 points, in O(n log^2 n) operations for n points and degree n. Rounding errors grow with the
+        /// coefficients of the products of (x - x_i), about exponentially in (Degree() + 1) max |x|, and the tree is only
+        /// faster than the batch Evaluate from high degrees on. The batch Evaluate is therefore used unless the degree
+        /// is at least SubproductMinDegree and (Degree() + 1) max |x| at most SubproductMaxSpread.
+        /// </summary>
+        std::vector<double> EvaluateMultipoint(const std::vector<double>& x) const;
+
+        /// <summary>
+        /// returns the derivative
+        /// </summary>
+        Polynomial Derivative() const;
+
+        /// <summary>
+        /// returns the composition p(inner(x)), computed with Horner's scheme on polynomials
+        /// </summary>
+        Polynomial Compose(const Polynomial& inner) const;
+
+        /// <summary>
+        /// divides by a non-zero polynomial. Large divisions use the reversed divisor's inverse power series, computed by
+        /// Newton iteration with FFT multiplications.
+        /// </summary>
+        /// <returns>
+        /// quotient and remainder, the remainder of lower degree than the divisor
+        /// </returns>
+        /// <exception cref="std::invalid_argument">
+        /// thrown if the divisor is the zero polynomial
+        /// </exception>
+        std::pair<Polynomial, Polynomial> DivMod(const Polynomial& divisor) const;
+
+        Polynomial operator+(const Polynomial& other) const;
+        Polynomial operator-(const Polynomial& other) const;
+
+        /// <summary>
+        /// multiplies two polynomials, by the FFT in O(n log n) once both degrees exceed PolynomialFFTThreshold.
+        /// FFT products have absolute errors of the order of machine precision times the largest coefficients.
+        /// </summary>
+        Polynomial operator*(const Polynomial& other) const;
+
+        Polynomial operator*(double scalar) const;
+    };
+
+} // namespace NumericLib
@@ -0,0 +1,105 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+
+namespace NumericLib {
+
+    /// <summary>
+    /// compensated (Kahan-Babuska-Neumaier) running sum. The low-order bits lost by every addition are collected
+    /// in a separate correction term, so the error does not grow with the number of terms.
+    /// </summary>
+    struct NeumaierSum {
+        double sum = 0.0;
+        double correction = 0.0;
+
+        /// <summary>
+        /// adds a term to the sum
+        /// </summary>
+        void Add(double value) {
+            const double t = sum + value;
+            if (std::abs(sum) >= std::abs(value)) {
+                correction += (sum - t) + value;
+            }
+            else {
+                correction += (value - t) + sum;
+            }
+            sum = t;
+        }
+
+        /// <summary>
+        /// adds another partial sum, including its correction term
+        /// </summary>
+        void Merge(const NeumaierSum& other) {
+            Add(other.sum);
+            correction += other.correction;
+        }
+
+        /// <summary>
+        /// returns the compensated value of the sum
+        /// </summary>
+        double Value() const { return sum + correction; }
+    };
+
+    /// <summary>
+    /// running mean and variance of a stream of values (Welford's algorithm); partial results of several threads
+    /// can be combined with Merge (Chan et al.)
+    /// </summary>
+    struct RunningVariance {
+        std::size_t count = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+
+        /// <summary>
+        /// adds a value to the statistics
+        /// </summary>
+        void Add(double value) {
+            count++;
+            const double delta = value - mean;
+            mean += delta / static_cast<double>(count);
+            m2 += delta * (value - mean);
+        }
+
+        /// <summary>
+        /// adds the statistics of another stream
+        /// </summary>
+        void Merge(const RunningVariance& other) {
+            if (other.count == 0) return;
+            const double total = static_cast<double>(count + other.count);
+            const double delta = other.mean - mean;
+            mean += delta * static_cast<double>(other.count) / total;
+            m2 += other.m2 + delta * delta * static_cast<double>(count) * static_cast<double>(other.count) / total;
+            count += other.count;
+        }
+
+        /// <summary>
+        /// returns the sample variance, or 0 for fewer than two values
+        /// </summary>
+        double Variance() const { return count > 1 ? m2 / static_cast<double>(count - 1) : 0.0; }
+    };
+
+    /// <summary>
+    /// sums an array by recursive halving, so the rounding error grows with log(n) instead of n.
+    /// The order of additions depends only on n, which makes the result reproducible.
+    /// </summary>
+    /// <param name="values">
+    /// pointer to the first term
+    /// </param>
+    /// <param name="n">
+    /// number of terms
+    /// </param>
+    /// <returns>
+    /// sum of the terms
+    /// </returns>
+    inline double pairwiseSum(const double* values, std::size_t n) {
+        if (n <= 8) {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < n; i++) {
+                sum += values[i];
+            }
+            return sum;
+        }
+        const std::size_t half = n / 2;
+        return pairwiseSum(values, half) + pairwiseSum(values + half, n - half);
+    }
+
+} // namespace NumericLib
@@ -16,9 +16,9 @@ namespace NumericLib {
 	/// </summary>
 	/// <param name="x">The point at which to evaluate the polynomial.</param>
 	/// <param name="ai">Coefficients of the polynomial, where ai[i] is the coefficient for x^i.</param>
-	/// <param name="n">Degree of the polynomial (number of coefficients - 1).</param>
+	/// <param name="n">Degree of the polynomial (number of coefficients - 1); a negative value uses all coefficients.</param>
 	/// <returns>The value of the polynomial at point x.</returns>
-	double GetValueHorner(double x, std::vector<double>& ai, int n = 3);
+	double GetValueHorner(double x, const std::vector<double>& ai, int n = -1);
 	/// <summary>
 	/// Prints a matrix to the standard output.
 	/// </summary>
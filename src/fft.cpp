@@ -0,0 +1,56 @@
+#include "fft.hpp"
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+
+namespace NumericLib {
+
+    void FFT(std::vector<std::complex<double>>& data, bool inverse)
+    {
+        const std::size_t n = data.size();
+        if (n == 0 || (n & (n - 1)) != 0)
+            throw std::invalid_argument("FFT length must be a power of two.");
+
+        // Bit-reversal permutation
+        for (std::size_t i = 1, j = 0; i < n; i++) {
+            std::size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) std::swap(data[i], data[j]);
+        }
+
+        // Butterflies; every twiddle factor is computed directly so rounding errors do not accumulate along a stage
+        const double sign = inverse ? 1.0 : -1.0;
+        std::vector<std::complex<double>> twiddles(n / 2);
+        for (std::size_t k = 0; k < n / 2; k++) {
+            twiddles[k] = std::polar(1.0, sign * 2.0 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(n));
+        }
+        for (std::size_t length = 2; length <= n; length <<= 1) {
+            const std::size_t half = length / 2;
+            const std::size_t stride = n / length;
+            for (std::size_t start = 0; start < n; start += length) {
+                for (std::size_t k = 0; k < half; k++) {
+                    const std::complex<double> odd = twiddles[k * stride] * data[start + k + half];
+                    data[start + k + half] = data[start + k] - odd;
+                    data[start + k] += odd;
+                }
+            }
+        }
+
+        if (inverse) {
+            for (std::complex<double>& value : data) {
+                value /= static_cast<double>(n);
+            }
+        }
+    }
+
+    std::size_t NextPowerOfTwo(std::size_t n)
+    {
+        std::size_t power = 1;
+        while (power < n) power <<= 1;
+        return power;
+    }
+
+} // namespace NumericLib
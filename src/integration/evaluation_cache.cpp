@@ -0,0 +1,151 @@
+#include "integration/evaluation_cache.hpp"
+#include "integration/gauss_legendre.hpp"
+#include <algorithm>
+
+namespace NumericLib {
+
+    IntegrationPlan::IntegrationPlan(const std::vector<double>& range)
+    {
+        if (range.size() != 2)
+            throw std::invalid_argument("Range vector must have exactly two elements.");
+        if (range[0] >= range[1])
+            throw std::invalid_argument("Range start must be less than range end.");
+        a = range[0];
+        b = range[1];
+    }
+
+    std::vector<double> IntegrationPlan::RuleNodes(const Rule& rule) const
+    {
+        std::vector<double> x;
+        if (rule.kind == RuleKind::GaussLegendreSplit) {
+            const GaussLegendreRule& gauss = getGLRule(rule.nodesPerPanel);
+            x.reserve(rule.n * gauss.nodes.size());
+            for (std::size_t i = 0; i < rule.n; ++i) {
+                double mid = a + (i + 0.5) * rule.h;
+                for (double node : gauss.nodes) {
+                    x.push_back(mid + (rule.h / 2.0) * node);
+                }
+            }
+            return x;
+        }
+
+        // Rect uses the left endpoints only; the other rules end exactly at b.
+        const std::size_t count = rule.kind == RuleKind::Rect ? rule.n : rule.n + 1;
+        x.reserve(count);
+        for (std::size_t i = 0; i < count; i++) {
+            x.push_back(i == rule.n ? b : a + i * rule.h);
+        }
+        return x;
+    }
+
+    std::size_t IntegrationPlan::Add(const Rule& rule)
+    {
+        const std::vector<double> added = RuleNodes(rule);
+        const std::size_t previous = nodes.size();
+        nodes.insert(nodes.end(), added.begin(), added.end());
+        std::sort(nodes.begin() + previous, nodes.end());
+        std::inplace_merge(nodes.begin(), nodes.begin() + previous, nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+        rules.push_back(rule);
+        return rules.size() - 1;
+    }
+
+    std::size_t IntegrationPlan::AddRect(double step)
+    {
+        if (step <= 0)
+            throw std::invalid_argument("Step size must be positive.");
+        const std::size_t n = static_cast<std::size_t>(std::ceil(step));
+        return Add({ RuleKind::Rect, n, (b - a) / n, 0 });
+    }
+
+    std::size_t IntegrationPlan::AddTrapezoids(double step)
+    {
+        if (step <= 0)
+            throw std::invalid_argument("Step size must be positive.");
+        const std::size_t n = static_cast<std::size_t>(std::ceil(step));
+        return Add({ RuleKind::Trapezoids, n, (b - a) / n, 0 });
+    }
+
+    std::size_t IntegrationPlan::AddSimpson(int split)
+    {
+        if (split <= 0)
+            throw std::invalid_argument("Number of splits must be positive.");
+        if (split % 2 == 1) split++;
+        return Add({ RuleKind::Simpson, static_cast<std::size_t>(split), (b - a) / (double)split, 0 });
+    }
+
+    std::size_t IntegrationPlan::AddGaussLegendreSplit(int n, int splits)
+    {
+        if (splits <= 0)
+            throw std::invalid_argument("Number of splits must be greater than 0");
+        if (n <= 0)
+            throw std::invalid_argument("Number of Gauss-Legendre nodes must be greater than 0");
+        return Add({ RuleKind::GaussLegendreSplit, static_cast<std::size_t>(splits), (b - a) / splits, n });
+    }
+
+    std::vector<double> IntegrationPlan::Estimates(const std::vector<double>& values) const
+    {
+        if (values.size() != nodes.size())
+            throw std::invalid_argument("Number of values must match the number of plan nodes.");
+
+        std::vector<double> estimates;
+        estimates.reserve(rules.size());
+        for (const Rule& rule : rules) {
+            const std::vector<double> x = RuleNodes(rule);
+
+            // The rule's nodes are looked up with a moving binary search; runs of increasing nodes only move forward.
+            auto position = nodes.begin();
+            auto valueAt = [&](double node) {
+                if (position == nodes.end() || *position > node) position = nodes.begin();
+                position = std::lower_bound(position, nodes.end(), node);
+                return values[position - nodes.begin()];
+            };
+
+            double sum = 0.0;
+            switch (rule.kind) {
+            case RuleKind::Rect:
+                for (double node : x) sum += valueAt(node);
+                estimates.push_back(sum * rule.h);
+                break;
+            case RuleKind::Trapezoids:
+                for (std::size_t i = 0; i < x.size(); i++) {
+                    const double y = valueAt(x[i]);
+                    sum += (i == 0 || i == rule.n) ? y / 2 : y;
+                }
+                estimates.push_back(sum * rule.h);
+                break;
+            case RuleKind::Simpson:
+                for (std::size_t i = 0; i < x.size(); i++) {
+                    const double y = valueAt(x[i]);
+                    if (i == 0 || i == rule.n) {
+                        sum += y;
+                    }
+                    else if (i % 2 == 0) {
+                        sum += 2 * y;
+                    }
+                    else {
+                        sum += 4 * y;
+                    }
+                }
+                estimates.push_back(sum * rule.h / 3);
+                break;
+            case RuleKind::GaussLegendreSplit: {
+                const GaussLegendreRule& gauss = getGLRule(rule.nodesPerPanel);
+                const std::size_t perPanel = gauss.nodes.size();
+                for (std::size_t i = 0; i < rule.n; ++i) {
+                    double part = 0.0;
+                    for (std::size_t k = 0; k < perPanel; k++) {
+                        part += gauss.weights[k] * valueAt(x[i * perPanel + k]);
+                    }
+                    sum += part;
+                }
+                estimates.push_back((rule.h / 2.0) * sum);
+                break;
+            }
+            }
+        }
+        return estimates;
+    }
+
+} // namespace NumericLib
@@ -0,0 +1,316 @@
+#include "integration/monte_carlo.hpp"
+#include <map>
+#include <mutex>
+#include <numbers>
+
+namespace NumericLib {
+
+    namespace {
+
+        // 2^-32, the spacing of the 32-bit digital and lattice points.
+        const double Inverse32 = 1.0 / 4294967296.0;
+
+        // Key of the Philox stream providing the fixed parts of the point sets (Sobol initial directions, Korobov candidates).
+        const std::array<std::uint32_t, 2> ConstructionKey = { 0x5EED5EEDu, 0x0B01A5EDu };
+
+        std::array<std::uint32_t, 2> KeyFromSeed(std::uint64_t seed) {
+            return { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+        }
+
+        std::uint32_t Parity(std::uint32_t value) {
+            value ^= value >> 16;
+            value ^= value >> 8;
+            value ^= value >> 4;
+            value ^= value >> 2;
+            value ^= value >> 1;
+            return value & 1u;
+        }
+
+        std::uint32_t ReverseBits(std::uint32_t value) {
+            value = ((value >> 1) & 0x55555555u) | ((value & 0x55555555u) << 1);
+            value = ((value >> 2) & 0x33333333u) | ((value & 0x33333333u) << 2);
+            value = ((value >> 4) & 0x0F0F0F0Fu) | ((value & 0x0F0F0F0Fu) << 4);
+            value = ((value >> 8) & 0x00FF00FFu) | ((value & 0x00FF00FFu) << 8);
+            return (value >> 16) | (value << 16);
+        }
+
+        void CheckRange(std::uint64_t first, std::size_t count) {
+            if (first + count > (std::uint64_t(1) << 32))
+                throw std::invalid_argument("Point index exceeds 2^32.");
+        }
+
+        // Product of two polynomials over GF(2) modulo a polynomial of the given degree.
+        std::uint64_t MultiplyModulo(std::uint64_t a, std::uint64_t b, std::uint64_t modulus, int degree) {
+            std::uint64_t result = 0;
+            while (b) {
+                if (b & 1) result ^= a;
+                b >>= 1;
+                a <<= 1;
+                if (a & (std::uint64_t(1) << degree)) a ^= modulus;
+            }
+            return result;
+        }
+
+        std::uint64_t PowerOfX(std::uint64_t exponent, std::uint64_t modulus, int degree) {
+            std::uint64_t result = 1, base = 2;
+            if (base & (std::uint64_t(1) << degree)) base ^= modulus;
+            while (exponent) {
+                if (exponent & 1) result = MultiplyModulo(result, base, modulus, degree);
+                base = MultiplyModulo(base, base, modulus, degree);
+                exponent >>= 1;
+            }
+            return result;
+        }
+
+        // A polynomial of degree d is primitive if x has multiplicative order 2^d - 1 modulo it.
+        bool IsPrimitive(std::uint64_t poly, int degree) {
+            const std::uint64_t order = (std::uint64_t(1) << degree) - 1;
+            if (PowerOfX(order, poly, degree) != 1) return false;
+
+            std::uint64_t rest = order;
+            for (std::uint64_t q = 2; q * q <= rest; q++) {
+                if (rest % q != 0) continue;
+                if (PowerOfX(order / q, poly, degree) == 1) return false;
+                while (rest % q == 0) rest /= q;
+            }
+            return rest == 1 || PowerOfX(order / rest, poly, degree) != 1;
+        }
+
+        // Returns the first count primitive polynomials over GF(2), ordered by degree.
+        std::vector<std::uint32_t> PrimitivePolynomials(std::size_t count) {
+            std::vector<std::uint32_t> polys;
+            for (int degree = 1; polys.size() < count && degree < 32; degree++) {
+                const std::uint32_t top = 1u << degree;
+                for (std::uint32_t low = 1; low < top && polys.size() < count; low += 2) {
+                    if (IsPrimitive(top | low, degree)) polys.push_back(top | low);
+                }
+            }
+            return polys;
+        }
+
+        int Degree(std::uint32_t poly) {
+            int degree = 0;
+            while (poly >> (degree + 1)) degree++;
+            return degree;
+        }
+
+        // Weighted P2 worst-case error of the Korobov lattice with parameter a and 2^m points, weights 1 / (j + 1)^2.
+        double KorobovCriterion(std::uint32_t a, std::size_t dim, int m) {
+            std::vector<std::uint32_t> z(dim);
+            std::vector<double> gamma(dim);
+            std::uint32_t power = 1;
+            for (std::size_t j = 0; j < dim; j++, power *= a) {
+                z[j] = power;
+                gamma[j] = 2.0 * std::numbers::pi * std::numbers::pi / ((j + 1.0) * (j + 1.0));
+            }
+
+            const std::uint32_t points = 1u << m;
+            double sum = 0.0;
+            for (std::uint32_t k = 0; k < points; k++) {
+                double product = 1.0;
+                for (std::size_t j = 0; j < dim; j++) {
+                    const double x = static_cast<std::uint32_t>((k << (32 - m)) * z[j]) * Inverse32;
+                    product *= 1.0 + gamma[j] * (x * x - x + 1.0 / 6.0);
+                }
+                sum += product;
+            }
+            return sum / points - 1.0;
+        }
+
+        // Chooses the Korobov parameter for a dimension; the choice is cached because the search is relatively expensive.
+        std::uint32_t KorobovParameter(std::size_t dim) {
+            static std::map<std::size_t, std::uint32_t> cache;
+            static std::mutex mutex;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto found = cache.find(dim);
+            if (found != cache.end()) return found->second;
+
+            // The criterion is checked on two lattice sizes so the vector is good for short and long runs alike.
+            std::uint32_t best = 1;
+            double bestScore = 0.0;
+            for (std::uint32_t candidate = 0; candidate < 32; candidate++) {
+                const std::uint32_t a = Philox4x32({ candidate, 0, 2, 0 }, ConstructionKey)[0] | 1u;
+                const double score = std::log(KorobovCriterion(a, dim, 10)) + std::log(KorobovCriterion(a, dim, 13));
+                if (candidate == 0 || score < bestScore) {
+                    best = a;
+                    bestScore = score;
+                }
+            }
+            cache[dim] = best;
+            return best;
+        }
+
+    } // namespace
+
+    std::array<std::uint32_t, 4> Philox4x32(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key)
+    {
+        for (int round = 0; round < 10; round++) {
+            const std::uint64_t product0 = std::uint64_t(0xD2511F53u) * counter[0];
+            const std::uint64_t product1 = std::uint64_t(0xCD9E8D57u) * counter[2];
+            counter = {
+                static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                static_cast<std::uint32_t>(product1),
+                static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                static_cast<std::uint32_t>(product0)
+            };
+            key[0] += 0x9E3779B9u;
+            key[1] += 0xBB67AE85u;
+        }
+        return counter;
+    }
+
+    PhiloxPoints::PhiloxPoints(std::size_t dimension, std::uint64_t seed, std::uint32_t streamId)
+        : dim(dimension), key(KeyFromSeed(seed)), stream(streamId)
+    {
+        if (dim == 0)
+            throw std::invalid_argument("Dimension must be greater than 0");
+    }
+
+    void PhiloxPoints::Fill(std::uint64_t first, std::size_t count, double* out) const
+    {
+        // Every Philox block yields two 53-bit uniforms; the half step keeps the points away from 0.
+        const double scale = 1.0 / 9007199254740992.0;
+        for (std::size_t d = 0; d < dim; d += 2) {
+            double* row = out + d * count;
+            for (std::size_t k = 0; k < count; k++) {
+                const std::uint64_t i = first + k;
+                const auto words = Philox4x32({ static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(i >> 32),
+                    static_cast<std::uint32_t>(d / 2), stream }, key);
+                row[k] = ((std::uint64_t(words[0]) << 21 | words[1] >> 11) + 0.5) * scale;
+                if (d + 1 < dim) row[count + k] = ((std::uint64_t(words[2]) << 21 | words[3] >> 11) + 0.5) * scale;
+            }
+        }
+    }
+
+    SobolPoints::SobolPoints(std::size_t dimension, bool scramble, std::uint64_t seed)
+        : dim(dimension), directions(dimension * 32), shifts(dimension, 0)
+    {
+        if (dim == 0)
+            throw std::invalid_argument("Dimension must be greater than 0");
+
+        const std::vector<std::uint32_t> polys = PrimitivePolynomials(dim - 1);
+        const std::array<std::uint32_t, 2> key = KeyFromSeed(seed);
+
+        for (std::size_t d = 0; d < dim; d++) {
+            std::uint32_t m[33];
+            if (d == 0) {
+                // The first coordinate is the van der Corput sequence.
+                for (int k = 1; k <= 32; k++) m[k] = 1;
+            }
+            else {
+                const std::uint32_t poly = polys[d - 1];
+                const int s = Degree(poly);
+                for (int k = 1; k <= s; k++) {
+                    const std::uint32_t random = Philox4x32({ static_cast<std::uint32_t>(d), static_cast<std::uint32_t>(k), 1, 0 }, ConstructionKey)[0];
+                    m[k] = (k == 32 ? random : random & ((1u << k) - 1)) | 1u;
+                }
+                for (int k = s + 1; k <= 32; k++) {
+                    std::uint32_t value = m[k - s] ^ (m[k - s] << s);
+                    for (int i = 1; i < s; i++) {
+                        if ((poly >> (s - i)) & 1u) value ^= m[k - i] << i;
+                    }
+                    m[k] = value;
+                }
+            }
+
+            for (int k = 1; k <= 32; k++) {
+                directions[d * 32 + k - 1] = m[k] << (32 - k);
+            }
+
+            if (!scramble) continue;
+
+            // Random lower-triangular linear scrambling: output bit r depends on input bit r and the more significant bits.
+            std::uint32_t rows[32];
+            for (int r = 0; r < 32; r++) {
+                const std::uint32_t random = Philox4x32({ static_cast<std::uint32_t>(d), static_cast<std::uint32_t>(r), 3, 0 }, key)[0];
+                rows[r] = (r == 0 ? 0u : random & (~0u << (32 - r))) | (1u << (31 - r));
+            }
+            for (int k = 0; k < 32; k++) {
+                std::uint32_t scrambled = 0;
+                for (int r = 0; r < 32; r++) {
+                    scrambled |= Parity(rows[r] & directions[d * 32 + k]) << (31 - r);
+                }
+                directions[d * 32 + k] = scrambled;
+            }
+            shifts[d] = Philox4x32({ static_cast<std::uint32_t>(d), 0, 4, 0 }, key)[0];
+        }
+    }
+
+    void SobolPoints::Fill(std::uint64_t first, std::size_t count, double* out) const
+    {
+        if (count == 0) return;
+        CheckRange(first, count);
+
+        for (std::size_t d = 0; d < dim; d++) {
+            const std::uint32_t* v = directions.data() + d * 32;
+            std::uint32_t x = 0;
+            for (int k = 0; k < 32; k++) {
+                if ((first >> k) & 1u) x ^= v[k];
+            }
+
+            double* row = out + d * count;
+            row[0] = ((x ^ shifts[d]) + 0.5) * Inverse32;
+            for (std::size_t k = 1; k < count; k++) {
+                // Going from i - 1 to i flips the trailing ones of i - 1 and the bit above them.
+                const std::uint64_t i = first + k;
+                std::uint64_t changed = i ^ (i - 1);
+                for (int bit = 0; changed; bit++, changed >>= 1) {
+                    x ^= v[bit];
+                }
+                row[k] = ((x ^ shifts[d]) + 0.5) * Inverse32;
+            }
+        }
+    }
+
+    LatticePoints::LatticePoints(std::size_t dimension, bool shift, std::uint64_t seed)
+        : dim(dimension), generator(dimension), shifts(dimension, 0)
+    {
+        if (dim == 0)
+            throw std::invalid_argument("Dimension must be greater than 0");
+
+        const std::uint32_t a = KorobovParameter(dim);
+        std::uint32_t power = 1;
+        for (std::size_t d = 0; d < dim; d++, power *= a) {
+            generator[d] = power;
+        }
+
+        if (!shift) return;
+        const std::array<std::uint32_t, 2> key = KeyFromSeed(seed);
+        for (std::size_t d = 0; d < dim; d++) {
+            shifts[d] = Philox4x32({ static_cast<std::uint32_t>(d), 0, 5, 0 }, key)[0];
+        }
+    }
+
+    void LatticePoints::Fill(std::uint64_t first, std::size_t count, double* out) const
+    {
+        CheckRange(first, count);
+
+        // Unsigned 32-bit arithmetic computes frac(phi(i) * z + shift) exactly.
+        for (std::size_t d = 0; d < dim; d++) {
+            double* row = out + d * count;
+            for (std::size_t k = 0; k < count; k++) {
+                const std::uint32_t x = ReverseBits(static_cast<std::uint32_t>(first + k)) * generator[d] + shifts[d];
+                row[k] = (x + 0.5) * Inverse32;
+            }
+        }
+    }
+
+    std::unique_ptr<UnitCubePoints> MakeUnitCubePoints(PointSet set, std::size_t dimension, std::uint64_t seed, std::uint32_t replication)
+    {
+        const auto words = Philox4x32({ replication, 0, 6, 0 }, KeyFromSeed(seed));
+        const std::uint64_t replicationSeed = std::uint64_t(words[0]) | std::uint64_t(words[1]) << 32;
+
+        switch (set) {
+        case PointSet::Philox:
+            return std::make_unique<PhiloxPoints>(dimension, seed, replication);
+        case PointSet::Sobol:
+            return std::make_unique<SobolPoints>(dimension, true, replicationSeed);
+        case PointSet::Lattice:
+            return std::make_unique<LatticePoints>(dimension, true, replicationSeed);
+        default:
+            throw std::invalid_argument("Unknown point set");
+        }
+    }
+
+} // namespace NumericLib
@@ -0,0 +1,246 @@
+#include "integration/sampled.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace NumericLib {
+
+    namespace {
+
+        // Terms summed per block; block sums are combined pairwise, so results do not depend on the thread count.
+        const std::size_t SampleBlockSize = 4096;
+
+        // Sums term(i) over [start, end) with four independent accumulators, which lets the compiler vectorize the loop.
+        template <typename Term>
+        double SumRange(std::size_t start, std::size_t end, Term term) {
+            double lanes[4] = { 0.0, 0.0, 0.0, 0.0 };
+            std::size_t i = start;
+            for (; i + 4 <= end; i += 4) {
+                lanes[0] += term(i);
+                lanes[1] += term(i + 1);
+                lanes[2] += term(i + 2);
+                lanes[3] += term(i + 3);
+            }
+            for (; i < end; i++) {
+                lanes[0] += term(i);
+            }
+            return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        }
+
+        // Sums term(i) for i in [0, count) block by block, reducing the block sums pairwise.
+        template <typename Term>
+        double ReduceTerms(std::size_t count, Term term) {
+            const std::size_t blocks = (count + SampleBlockSize - 1) / SampleBlockSize;
+            std::vector<double> sums(blocks);
+            parallel::ForEachBlock(blocks, [&](std::size_t block) {
+                sums[block] = SumRange(block * SampleBlockSize, std::min(count, (block + 1) * SampleBlockSize), term);
+                });
+            return pairwiseSum(sums.data(), blocks);
+        }
+
+        // Sum of the trapezoids of n samples; x == nullptr means uniform spacing dx.
+        double TrapezoidSum(const double* x, const double* y, std::size_t n, double dx) {
+            if (n < 2) return 0.0;
+            if (x == nullptr) {
+                return dx * (ReduceTerms(n, [y](std::size_t i) { return y[i]; }) - (y[0] + y[n - 1]) / 2.0);
+            }
+            return ReduceTerms(n - 1, [x, y](std::size_t i) { return (x[i + 1] - x[i]) * (y[i] + y[i + 1]); }) / 2.0;
+        }
+
+        // Simpson's rule on the parabola through three samples; x == nullptr means uniform spacing dx.
+        double SimpsonPair(const double* x, const double* y, double dx) {
+            if (x == nullptr) return dx / 3.0 * (y[0] + 4.0 * y[1] + y[2]);
+
+            const double h0 = x[1] - x[0], h1 = x[2] - x[1];
+            return (h0 + h1) / 6.0 * ((2.0 - h1 / h0) * y[0] + (h0 + h1) * (h0 + h1) / (h0 * h1) * y[1] + (2.0 - h0 / h1) * y[2]);
+        }
+
+        // Sum of Simpson's rule over the pairs of intervals (0, 1, 2), (2, 3, 4), ... of n samples.
+        double SimpsonPairs(const double* x, const double* y, std::size_t n, double dx) {
+            if (n < 3) return 0.0;
+            return ReduceTerms((n - 1) / 2, [x, y, dx](std::size_t p) { return SimpsonPair(x ? x + 2 * p : nullptr, y + 2 * p, dx); });
+        }
+
+        // Integral over the last of three samples' intervals from the parabola through all three (Cartwright's correction).
+        double LastInterval(const double* x, const double* y, double dx) {
+            const double h1 = x ? x[1] - x[0] : dx;
+            const double h2 = x ? x[2] - x[1] : dx;
+            const double alpha = (2.0 * h2 * h2 + 3.0 * h1 * h2) / (6.0 * (h1 + h2));
+            const double beta = (h2 * h2 + 3.0 * h1 * h2) / (6.0 * h1);
+            const double eta = h2 * h2 * h2 / (6.0 * h1 * (h1 + h2));
+            return alpha * y[2] + beta * y[1] - eta * y[0];
+        }
+
+        double SimpsonSum(const double* x, const double* y, std::size_t n, double dx) {
+            if (n == 2) return TrapezoidSum(x, y, n, dx);
+            if ((n - 1) % 2 == 0) return SimpsonPairs(x, y, n, dx);
+            return SimpsonPairs(x, y, n - 1, dx) + LastInterval(x ? x + n - 3 : nullptr, y + n - 3, dx);
+        }
+
+        std::vector<double> CumulativeSum(const double* x, const double* y, std::size_t n, double dx) {
+            std::vector<double> result(n, 0.0);
+            if (n < 2) return result;
+
+            auto interval = [x, y, dx](std::size_t i) { return (x ? x[i + 1] - x[i] : dx) * (y[i] + y[i + 1]) / 2.0; };
+
+            // The block totals are computed in parallel, scanned serially, and then every block is scanned from its offset.
+            const std::size_t intervals = n - 1;
+            const std::size_t blocks = (intervals + SampleBlockSize - 1) / SampleBlockSize;
+            std::vector<double> offsets(blocks + 1, 0.0);
+            parallel::ForEachBlock(blocks, [&](std::size_t block) {
+                offsets[block + 1] = SumRange(block * SampleBlockSize, std::min(intervals, (block + 1) * SampleBlockSize), interval);
+                });
+            for (std::size_t block = 0; block < blocks; block++) {
+                offsets[block + 1] += offsets[block];
+            }
+            parallel::ForEachBlock(blocks, [&](std::size_t block) {
+                double running = offsets[block];
+                const std::size_t end = std::min(intervals, (block + 1) * SampleBlockSize);
+                for (std::size_t i = block * SampleBlockSize; i < end; i++) {
+                    running += interval(i);
+                    result[i + 1] = running;
+                }
+                });
+            return result;
+        }
+
+        void CheckSamples(const std::vector<double>& x, const std::vector<double>& y) {
+            if (x.size() != y.size())
+                throw std::invalid_argument("Sample positions and values must have the same size.");
+            if (y.size() < 2)
+                throw std::invalid_argument("At least two samples are required.");
+        }
+
+        void CheckSamples(const std::vector<double>& y, double dx) {
+            if (dx <= 0)
+                throw std::invalid_argument("Sample spacing must be positive.");
+            if (y.size() < 2)
+                throw std::invalid_argument("At least two samples are required.");
+        }
+
+    } // namespace
+
+    double TrapezoidsSampled(const std::vector<double>& y, double dx)
+    {
+        CheckSamples(y, dx);
+        return TrapezoidSum(nullptr, y.data(), y.size(), dx);
+    }
+
+    double TrapezoidsSampled(const std::vector<double>& x, const std::vector<double>& y)
+    {
+        CheckSamples(x, y);
+        return TrapezoidSum(x.data(), y.data(), y.size(), 0.0);
+    }
+
+    double SimpsonSampled(const std::vector<double>& y, double dx)
+    {
+        CheckSamples(y, dx);
+        return SimpsonSum(nullptr, y.data(), y.size(), dx);
+    }
+
+    double SimpsonSampled(const std::vector<double>& x, const std::vector<double>& y)
+    {
+        CheckSamples(x, y);
+        return SimpsonSum(x.data(), y.data(), y.size(), 0.0);
+    }
+
+    std::vector<double> CumulativeTrapezoids(const std::vector<double>& y, double dx)
+    {
+        if (dx <= 0)
+            throw std::invalid_argument("Sample spacing must be positive.");
+        return CumulativeSum(nullptr, y.data(), y.size(), dx);
+    }
+
+    std::vector<double> CumulativeTrapezoids(const std::vector<double>& x, const std::vector<double>& y)
+    {
+        if (x.size() != y.size())
+            throw std::invalid_argument("Sample positions and values must have the same size.");
+        return CumulativeSum(x.data(), y.data(), y.size(), 0.0);
+    }
+
+    StreamingIntegrator::StreamingIntegrator(double spacing)
+        : dx(spacing)
+    {
+        if (dx <= 0)
+            throw std::invalid_argument("Sample spacing must be positive.");
+    }
+
+    StreamingIntegrator::StreamingIntegrator()
+        : dx(0.0)
+    {
+    }
+
+    void StreamingIntegrator::Push(double x, double y)
+    {
+        lastX[0] = lastX[1];
+        lastX[1] = lastX[2];
+        lastX[2] = x;
+        lastY[0] = lastY[1];
+        lastY[1] = lastY[2];
+        lastY[2] = y;
+    }
+
+    void StreamingIntegrator::AddChunk(const double* x, const double* y, std::size_t n)
+    {
+        if (n == 0) return;
+
+        // The interval joining the previous chunk to this one, then the intervals inside the chunk.
+        if (count > 0) {
+            trapezoid.Add((x ? x[0] - lastX[2] : dx) * (lastY[2] + y[0]) / 2.0);
+        }
+        trapezoid.Add(TrapezoidSum(x, y, n, dx));
+
+        // Complete a Simpson pair that started in an earlier chunk, one sample at a time.
+        std::size_t i = 0;
+        while (i < n && !(pending == 1 && i > 0)) {
+            Push(x ? x[i] : 0.0, y[i]);
+            count++;
+            i++;
+            if (++pending == 3) {
+                simpson.Add(SimpsonPair(x ? lastX : nullptr, lastY, dx));
+                pending = 1;
+            }
+        }
+        if (i == n) return;
+
+        // The remaining pairs start at sample i - 1 and lie entirely inside the chunk.
+        const std::size_t start = i - 1;
+        const std::size_t pairs = (n - start - 1) / 2;
+        simpson.Add(SimpsonPairs(x ? x + start : nullptr, y + start, 2 * pairs + 1, dx));
+        pending = n - (start + 2 * pairs);
+
+        for (std::size_t k = std::max(i, n >= 3 ? n - 3 : 0); k < n; k++) {
+            Push(x ? x[k] : 0.0, y[k]);
+        }
+        count += n - i;
+    }
+
+    void StreamingIntegrator::Add(const double* y, std::size_t n)
+    {
+        if (dx <= 0)
+            throw std::logic_error("Integrator expects sample positions.");
+        AddChunk(nullptr, y, n);
+    }
+
+    void StreamingIntegrator::Add(const double* x, const double* y, std::size_t n)
+    {
+        if (dx > 0)
+            throw std::logic_error("Integrator expects uniformly spaced samples.");
+        AddChunk(x, y, n);
+    }
+
+    void StreamingIntegrator::Add(const std::vector<double>& x, const std::vector<double>& y)
+    {
+        if (x.size() != y.size())
+            throw std::invalid_argument("Sample positions and values must have the same size.");
+        Add(x.data(), y.data(), y.size());
+    }
+
+    double StreamingIntegrator::Simpson() const
+    {
+        if (count < 3) return trapezoid.Value();
+        if (pending == 1) return simpson.Value();
+        return simpson.Value() + LastInterval(dx > 0 ? nullptr : lastX, lastY, dx);
+    }
+
+} // namespace NumericLib
@@ -0,0 +1,498 @@
+#include "interpolation/chebyshev.hpp"
+#include "fft.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <numbers>
+
+namespace NumericLib {
+
+    namespace {
+
+        // Split point of the root finder, slightly off center so that roots at simple rational points are not hit exactly.
+        const double RootSplitPoint = -0.004849834917525;
+
+        double Clenshaw(const std::vector<double>& c, double t)
+        {
+            double b1 = 0.0, b2 = 0.0;
+            for (std::size_t k = c.size() - 1; k >= 1; k--) {
+                const double b0 = c[k] + 2.0 * t * b1 - b2;
+                b2 = b1;
+                b1 = b0;
+            }
+            return c[0] + t * b1 - b2;
+        }
+
+        // Balances a matrix by diagonal similarity with powers of two, which makes the eigenvalues less sensitive to rounding.
+        void Balance(std::vector<std::vector<double>>& A)
+        {
+            const std::size_t n = A.size();
+            bool done = false;
+            while (!done) {
+                done = true;
+                for (std::size_t i = 0; i < n; i++) {
+                    double r = 0.0, c = 0.0;
+                    for (std::size_t j = 0; j < n; j++) {
+                        if (j == i) continue;
+                        c += std::abs(A[j][i]);
+                        r += std::abs(A[i][j]);
+                    }
+                    if (c == 0.0 || r == 0.0) continue;
+
+                    const double s = c + r;
+                    double f = 1.0, g = r / 2.0;
+                    while (c < g) {
+                        f *= 2.0;
+                        c *= 4.0;
+                    }
+                    g = r * 2.0;
+                    while (c > g) {
+                        f /= 2.0;
+                        c /= 4.0;
+                    }
+                    if ((c + r) / f < 0.95 * s) {
+                        done = false;
+                        for (std::size_t j = 0; j < n; j++) A[i][j] /= f;
+                        for (std::size_t j = 0; j < n; j++) A[j][i] *= f;
+                    }
+                }
+            }
+        }
+
+        // Eigenvalues of an upper Hessenberg matrix by the Francis double-shift QR iteration (EISPACK hqr).
+        std::vector<std::complex<double>> HessenbergEigenvalues(std::vector<std::vector<double>>& a)
+        {
+            const int n = static_cast<int>(a.size());
+            std::vector<std::complex<double>> eigenvalues(n);
+            double anorm = 0.0;
+            for (int i = 0; i < n; i++) {
+                for (int j = std::max(i - 1, 0); j < n; j++) anorm += std::abs(a[i][j]);
+            }
+
+            int nn = n - 1;
+            double t = 0.0;
+            while (nn >= 0) {
+                int its = 0, l;
+                do {
+                    // Look for a single small subdiagonal element
+                    for (l = nn; l >= 1; l--) {
+                        double s = std::abs(a[l - 1][l - 1]) + std::abs(a[l][l]);
+                        if (s == 0.0) s = anorm;
+                        if (std::abs(a[l][l - 1]) + s == s) {
+                            a[l][l - 1] = 0.0;
+                            break;
+                        }
+                    }
+
+                    double x = a[nn][nn];
+                    if (l == nn) {
+                        eigenvalues[nn--] = x + t;
+                    }
+                    else {
+                        double y = a[nn - 1][nn - 1];
+                        double w = a[nn][nn - 1] * a[nn - 1][nn];
+                        if (l == nn - 1) {
+                            // Two roots of the trailing 2 x 2 block
+                            const double p = 0.5 * (y - x);
+                            const double q = p * p + w;
+                            double z = std::sqrt(std::abs(q));
+                            x += t;
+                            if (q >= 0.0) {
+                                z = p + (p >= 0.0 ? z : -z);
+                                eigenvalues[nn - 1] = eigenvalues[nn] = x + z;
+                                if (z != 0.0) eigenvalues[nn] = x - w / z;
+                            }
+                            else {
+                                eigenvalues[nn - 1] = std::complex<double>(x + p, z);
+                                eigenvalues[nn] = std::complex<double>(x + p, -z);
+                            }
+                            nn -= 2;
+                        }
+                        else {
+                            if (its == 60)
+                                throw std::runtime_error("Eigenvalue iteration did not converge.");
+                            if (its == 10 || its == 20) {
+                                // Exceptional shift
+                                t += x;
+                                for (int i = 0; i <= nn; i++) a[i][i] -= x;
+                                const double s = std::abs(a[nn][nn - 1]) + std::abs(a[nn - 1][nn - 2]);
+                                y = x = 0.75 * s;
+                                w = -0.4375 * s * s;
+                            }
+                            ++its;
+
+                            // Look for two consecutive small subdiagonal elements
+                            int m;
+                            double p = 0.0, q = 0.0, r = 0.0, z;
+                            for (m = nn - 2; m >= l; m--) {
+                                z = a[m][m];
+                                r = x - z;
+                                double s = y - z;
+                                p = (r * s - w) / a[m + 1][m] + a[m][m + 1];
+                                q = a[m + 1][m + 1] - z - r - s;
+                                r = a[m + 2][m + 1];
+                                s = std::abs(p) + std::abs(q) + std::abs(r);
+                                p /= s;
+                                q /= s;
+                                r /= s;
+                                if (m == l) break;
+                                const double u = std::abs(a[m][m - 1]) * (std::abs(q) + std::abs(r));
+                                const double v = std::abs(p) * (std::abs(a[m - 1][m - 1]) + std::abs(z) + std::abs(a[m + 1][m + 1]));
+                                if (u + v == v) break;
+                            }
+                            for (int i = m + 2; i <= nn; i++) {
+                                a[i][i - 2] = 0.0;
+                                if (i != m + 2) a[i][i - 3] = 0.0;
+                            }
+
+                            // Double QR step on rows l..nn and columns m..nn
+                            for (int k = m; k <= nn - 1; k++) {
+                                if (k != m) {
+                                    p = a[k][k - 1];
+                                    q = a[k + 1][k - 1];
+                                    r = 0.0;
+                                    if (k != nn - 1) r = a[k + 2][k - 1];
+                                    if ((x = std::abs(p) + std::abs(q) + std::abs(r)) != 0.0) {
+                                        p /= x;
+                                        q /= x;
+                                        r /= x;
+                                    }
+                                }
+                                const double norm = std::sqrt(p * p + q * q + r * r);
+                                const double s = p >= 0.0 ? norm : -norm;
+                                if (s == 0.0) continue;
+
+                                if (k == m) {
+                                    if (l != m) a[k][k - 1] = -a[k][k - 1];
+                                }
+                                else {
+                                    a[k][k - 1] = -s * x;
+                                }
+                                p += s;
+                                x = p / s;
+                                y = q / s;
+                                z = r / s;
+                                q /= p;
+                                r /= p;
+                                for (int j = k; j <= nn; j++) {
+                                    p = a[k][j] + q * a[k + 1][j];
+                                    if (k != nn - 1) {
+                                        p += r * a[k + 2][j];
+                                        a[k + 2][j] -= p * z;
+                                    }
+                                    a[k + 1][j] -= p * y;
+                                    a[k][j] -= p * x;
+                                }
+                                const int last = std::min(nn, k + 3);
+                                for (int i = l; i <= last; i++) {
+                                    p = x * a[i][k] + y * a[i][k + 1];
+                                    if (k != nn - 1) {
+                                        p += z * a[i][k + 2];
+                                        a[i][k + 2] -= p * r;
+                                    }
+                                    a[i][k + 1] -= p * q;
+                                    a[i][k] -= p;
+                                }
+                            }
+                        }
+                    }
+                } while (l < nn - 1);
+            }
+            return eigenvalues;
+        }
+
+        // Real roots in [-1, 1] of sum c_k T_k with c_n != 0, from the eigenvalues of the colleague matrix.
+        std::vector<double> ColleagueRoots(const std::vector<double>& c)
+        {
+            const std::size_t n = c.size() - 1;
+            if (n == 1) {
+                const double root = -c[0] / c[1];
+                return std::abs(root) <= 1.0 ? std::vector<double>{ root } : std::vector<double>();
+            }
+
+            // Transpose of the colleague matrix, which is upper Hessenberg: t T_k = (T_(k-1) + T_(k+1)) / 2 with
+            // T_n eliminated through the coefficients.
+            std::vector<std::vector<double>> H(n, std::vector<double>(n, 0.0));
+            H[1][0] = 1.0;
+            for (std::size_t k = 1; k + 1 < n; k++) {
+                H[k - 1][k] = 0.5;
+                H[k + 1][k] = 0.5;
+            }
+            H[n - 2][n - 1] = 0.5;
+            for (std::size_t k = 0; k < n; k++) {
+                H[k][n - 1] -= c[k] / (2.0 * c[n]);
+            }
+
+            Balance(H);
+            std::vector<double> roots;
+            for (const std::complex<double>& lambda : HessenbergEigenvalues(H)) {
+                if (std::abs(lambda.imag()) <= 1e-8 && std::abs(lambda.real()) <= 1.0 + 1e-8) {
+                    roots.push_back(std::max(-1.0, std::min(1.0, lambda.real())));
+                }
+            }
+            return roots;
+        }
+
+    } // namespace
+
+    std::vector<double> ChebyshevTransform(const std::vector<double>& values, std::size_t stride)
+    {
+        if (stride == 0 || values.empty() || (values.size() - 1) % stride != 0)
+            throw std::invalid_argument("Stride must divide the number of Chebyshev intervals.");
+        const std::size_t n = (values.size() - 1) / stride;
+        if (n == 0 || (n & (n - 1)) != 0)
+            throw std::invalid_argument("Number of Chebyshev values must be a power of two plus one.");
+
+        // The FFT of the even extension v_0, ..., v_n, v_(n-1), ..., v_1 is real and equals n c_k, with c_0 and c_n doubled.
+        std::vector<std::complex<double>> extended(2 * n);
+        for (std::size_t j = 0; j <= n; j++) extended[j] = values[j * stride];
+        for (std::size_t j = 1; j < n; j++) extended[2 * n - j] = values[j * stride];
+        FFT(extended);
+
+        std::vector<double> coefficients(n + 1);
+        for (std::size_t k = 0; k <= n; k++) {
+            coefficients[k] = extended[k].real() / static_cast<double>(n);
+        }
+        coefficients[0] /= 2.0;
+        coefficients[n] /= 2.0;
+        return coefficients;
+    }
+
+    void EvaluateChebyshevSeries(const std::vector<double>& coefficients, double scale, double shift, const double* x, double* y, std::size_t count)
+    {
+        const std::size_t degree = coefficients.size() - 1;
+        double t[parallel::BlockSize];
+        double b1[parallel::BlockSize];
+        double b2[parallel::BlockSize];
+
+        for (std::size_t start = 0; start < count; start += parallel::BlockSize) {
+            const std::size_t n = std::min(parallel::BlockSize, count - start);
+            for (std::size_t i = 0; i < n; i++) {
+                t[i] = scale * x[start + i] + shift;
+                b1[i] = 0.0;
+                b2[i] = 0.0;
+            }
+            for (std::size_t k = degree; k >= 1; k--) {
+                const double c = coefficients[k];
+                for (std::size_t i = 0; i < n; i++) {
+                    const double b0 = c + 2.0 * t[i] * b1[i] - b2[i];
+                    b2[i] = b1[i];
+                    b1[i] = b0;
+                }
+            }
+            for (std::size_t i = 0; i < n; i++) {
+                y[start + i] = coefficients[0] + t[i] * b1[i] - b2[i];
+            }
+        }
+    }
+
+    std::vector<double> ChebyshevDerivative(const std::vector<double>& coefficients)
+    {
+        const std::size_t n = coefficients.size() - 1;
+        if (n == 0) return { 0.0 };
+
+        // d_(k-1) = d_(k+1) + 2 k c_k, downwards from d_n = d_(n+1) = 0, with d_0 halved
+        std::vector<double> d(n + 1, 0.0);
+        for (std::size_t k = n; k >= 1; k--) {
+            d[k - 1] = (k + 1 <= n ? d[k + 1] : 0.0) + 2.0 * k * coefficients[k];
+        }
+        d[0] /= 2.0;
+        d.pop_back();
+        return d;
+    }
+
+    ChebyshevProxy::ChebyshevProxy(std::vector<double> coefficients, const std::vector<double>& range, double tol)
+        : coeffs(std::move(coefficients)), a(range.size() == 2 ? range[0] : 0.0), b(range.size() == 2 ? range[1] : 0.0), tolerance(tol)
+    {
+        if (range.size() != 2)
+            throw std::invalid_argument("Range vector must have exactly two elements.");
+        CheckRange();
+        if (coeffs.empty())
+            throw std::invalid_argument("At least one coefficient is required.");
+    }
+
+    void ChebyshevProxy::CheckRange() const
+    {
+        if (a >= b)
+            throw std::invalid_argument("Range start must be less than range end.");
+        if (tolerance <= 0)
+            throw std::invalid_argument("Tolerance must be positive.");
+    }
+
+    bool ChebyshevProxy::Chop(std::vector<double>& coefficients) const
+    {
+        // Plateau test of Aurentz and Trefethen ("Chopping a Chebyshev series", Chebfun's standardChop) on the
+        // monotone envelope of the coefficients, normalized by its largest value.
+        const std::size_t n = coefficients.size();
+        if (n < 17) return false;
+
+        std::vector<double> envelope(n);
+        envelope[n - 1] = std::abs(coefficients[n - 1]);
+        for (std::size_t j = n - 1; j-- > 0; ) envelope[j] = std::max(std::abs(coefficients[j]), envelope[j + 1]);
+        if (envelope[0] == 0.0) {
+            coefficients.assign(1, 0.0);
+            return true;
+        }
+        for (double& e : envelope) e /= envelope[0];
+
+        // The plateau starts where the envelope stops decreasing: over the next quarter of the coefficients it falls
+        // by less than a factor that shrinks as the envelope approaches the tolerance.
+        const double logTolerance = std::log(tolerance);
+        std::size_t plateau = 0, j2 = 0;
+        for (std::size_t j = 2; j <= n; j++) {
+            j2 = static_cast<std::size_t>(std::lround(1.25 * static_cast<double>(j) + 5.0));
+            if (j2 > n) return false;
+            const double e1 = envelope[j - 1], e2 = envelope[j2 - 1];
+            const double r = 3.0 * (1.0 - std::log(e1) / logTolerance);
+            if (e1 == 0.0 || e2 / e1 > r) {
+                plateau = j - 1;
+                break;
+            }
+        }
+        if (plateau == 0) return false;
+
+        // Cut where log10 of the envelope plus a ramp rising by log10(1 / tolerance) / 3 over the plateau is smallest,
+        // which places the cut at the start of the noise rather than somewhere inside it.
+        std::size_t cutoff = plateau;
+        if (envelope[plateau - 1] != 0.0) {
+            const double floor = std::pow(tolerance, 7.0 / 6.0);
+            std::size_t j3 = 0;
+            for (double e : envelope) j3 += e >= floor ? 1 : 0;
+            if (j3 < j2) {
+                j2 = j3 + 1;
+                envelope[j2 - 1] = floor;
+            }
+
+            double best = std::numeric_limits<double>::infinity();
+            std::size_t d = 1;
+            for (std::size_t j = 1; j <= j2; j++) {
+                const double ramp = j2 == 1 ? 0.0 : -std::log10(tolerance) / 3.0 * static_cast<double>(j - 1) / static_cast<double>(j2 - 1);
+                const double value = std::log10(envelope[j - 1]) + ramp;
+                if (value < best) {
+                    best = value;
+                    d = j;
+                }
+            }
+            cutoff = std::max<std::size_t>(d - 1, 1);
+        }
+
+        coefficients.resize(cutoff);
+        return true;
+    }
+
+    double ChebyshevProxy::Evaluate(double x) const
+    {
+        double y = 0.0;
+        Evaluate(&x, &y, 1);
+        return y;
+    }
+
+    void ChebyshevProxy::Evaluate(const double* x, double* y, std::size_t count) const
+    {
+        EvaluateChebyshevSeries(coeffs, 2.0 / (b - a), -(a + b) / (b - a), x, y, count);
+    }
+
+    std::vector<double> ChebyshevProxy::Evaluate(const std::vector<double>& x) const
+    {
+        std::vector<double> y(x.size());
+        Evaluate(x.data(), y.data(), x.size());
+        return y;
+    }
+
+    ChebyshevProxy ChebyshevProxy::Derivative() const
+    {
+        std::vector<double> d = ChebyshevDerivative(coeffs);
+        const double scale = 2.0 / (b - a);
+        for (double& value : d) value *= scale;
+        return ChebyshevProxy(std::move(d), { a, b }, tolerance);
+    }
+
+    ChebyshevProxy ChebyshevProxy::Antiderivative() const
+    {
+        // C_k = (c_(k-1) - c_(k+1)) / (2k) for k >= 1, with c_0 doubled; C_0 makes the antiderivative vanish at t = -1
+        const std::size_t n = coeffs.size() - 1;
+        std::vector<double> C(n + 2, 0.0);
+        for (std::size_t k = 1; k <= n + 1; k++) {
+            const double previous = k == 1 ? 2.0 * coeffs[0] : coeffs[k - 1];
+            const double next = k + 1 <= n ? coeffs[k + 1] : 0.0;
+            C[k] = (previous - next) / (2.0 * k) * (b - a) / 2.0;
+        }
+        double atStart = 0.0;
+        for (std::size_t k = 1; k <= n + 1; k++) {
+            atStart += k % 2 == 0 ? C[k] : -C[k];
+        }
+        C[0] = -atStart;
+        return ChebyshevProxy(std::move(C), { a, b }, tolerance);
+    }
+
+    double ChebyshevProxy::Integral() const
+    {
+        double sum = 0.0;
+        for (std::size_t k = 0; k < coeffs.size(); k += 2) {
+            sum += coeffs[k] * 2.0 / (1.0 - static_cast<double>(k * k));
+        }
+        return sum * (b - a) / 2.0;
+    }
+
+    void ChebyshevProxy::CollectRoots(const std::vector<double>& c, double lo, double hi, double scale, int depth,
+        std::vector<double>& roots) const
+    {
+        std::size_t n = c.size() - 1;
+        while (n > 0 && std::abs(c[n]) <= tolerance * scale) n--;
+        if (n == 0) return;
+
+        if (n <= ChebyshevRootsDirectDegree || depth >= 24) {
+            for (double root : ColleagueRoots(std::vector<double>(c.begin(), c.begin() + n + 1))) {
+                roots.push_back(lo + (hi - lo) * (root + 1.0) / 2.0);
+            }
+            return;
+        }
+
+        // Restrict to both sides of the split point; interpolation at n + 1 or more points reproduces the polynomial exactly.
+        const std::size_t m = NextPowerOfTwo(n);
+        const double pieces[2][2] = { { -1.0, RootSplitPoint }, { RootSplitPoint, 1.0 } };
+        for (const auto& piece : pieces) {
+            std::vector<double> values(m + 1);
+            for (std::size_t j = 0; j <= m; j++) {
+                const double u = std::cos(std::numbers::pi * static_cast<double>(j) / static_cast<double>(m));
+                values[j] = Clenshaw(c, piece[0] + (piece[1] - piece[0]) * (u + 1.0) / 2.0);
+            }
+            CollectRoots(ChebyshevTransform(values), lo + (hi - lo) * (piece[0] + 1.0) / 2.0, lo + (hi - lo) * (piece[1] + 1.0) / 2.0,
+                scale, depth + 1, roots);
+        }
+    }
+
+    std::vector<double> ChebyshevProxy::Roots() const
+    {
+        double scale = 0.0;
+        for (double c : coeffs) scale = std::max(scale, std::abs(c));
+        std::vector<double> t;
+        if (scale == 0.0) return t;
+        CollectRoots(coeffs, -1.0, 1.0, scale, 0, t);
+
+        // Map to [a, b] and polish with Newton steps that are kept only while they reduce the residual.
+        const ChebyshevProxy derivative = Derivative();
+        std::vector<double> roots;
+        for (double root : t) {
+            double x = std::max(a, std::min(b, (a + b) / 2.0 + (b - a) / 2.0 * root));
+            double residual = std::abs(Evaluate(x));
+            for (int iteration = 0; iteration < 3 && residual > 0.0; iteration++) {
+                const double slope = derivative(x);
+                if (slope == 0.0) break;
+                const double next = x - Evaluate(x) / slope;
+                if (next < a || next > b || std::abs(Evaluate(next)) >= residual) break;
+                x = next;
+                residual = std::abs(Evaluate(x));
+            }
+            roots.push_back(x);
+        }
+
+        std::sort(roots.begin(), roots.end());
+        const double separation = 1e-10 * (b - a);
+        roots.erase(std::unique(roots.begin(), roots.end(), [separation](double left, double right) { return right - left <= separation; }),
+            roots.end());
+        return roots;
+    }
+
+} // namespace NumericLib
@@ -0,0 +1,301 @@
+#include "interpolation/grid.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace NumericLib {
+
+    namespace {
+
+        // Stencil order and stride of every dimension, padded to GridMaxDimensions with trivial axes of one node.
+        struct Padded {
+            std::size_t order[GridMaxDimensions] = { 1, 1, 1 };
+            std::size_t stride[GridMaxDimensions] = { 0, 0, 0 };
+        };
+
+        double Horner(const double* coefficients, std::size_t count, double t)
+        {
+            double result = coefficients[count - 1];
+            for (std::size_t p = count - 1; p-- > 0; ) result = result * t + coefficients[p];
+            return result;
+        }
+
+    } // namespace
+
+    GridInterpolant::GridInterpolant(std::vector<std::vector<double>> nodes, std::vector<double> gridValues, GridMethod gridMethod)
+        : method(gridMethod)
+    {
+        Initialize(std::move(nodes));
+        if (gridValues.size() != axes[0].stride * axes[0].nodes.size())
+            throw std::invalid_argument("Number of values must match the grid size.");
+        owned = std::make_shared<const std::vector<double>>(std::move(gridValues));
+        values = owned->data();
+    }
+
+    GridInterpolant::GridInterpolant(std::vector<std::vector<double>> nodes, const double* gridValues, GridMethod gridMethod)
+        : values(gridValues), method(gridMethod)
+    {
+        Initialize(std::move(nodes));
+        if (values == nullptr)
+            throw std::invalid_argument("Grid values must not be null.");
+    }
+
+    void GridInterpolant::Initialize(std::vector<std::vector<double>> nodes)
+    {
+        if (nodes.empty() || nodes.size() > GridMaxDimensions)
+            throw std::invalid_argument("Grid must have between one and three dimensions.");
+
+        axes.resize(nodes.size());
+        std::size_t stride = 1;
+        for (std::size_t d = nodes.size(); d-- > 0; ) {
+            GridAxis& axis = axes[d];
+            axis.nodes = std::move(nodes[d]);
+            const std::vector<double>& x = axis.nodes;
+            if (x.size() < 2)
+                throw std::invalid_argument("Every grid axis must have at least two nodes.");
+            for (std::size_t i = 1; i < x.size(); i++) {
+                if (!(x[i] > x[i - 1]))
+                    throw std::invalid_argument("Grid nodes must be strictly increasing.");
+            }
+
+            axis.uniform = isUniformAxis(x);
+            axis.cells = UniformAxis(x.front(), x.back(), x.size() - 1);
+            axis.stride = stride;
+            stride *= x.size();
+        }
+    }
+
+    std::size_t GridInterpolant::Stencil() const
+    {
+        std::size_t size = 1;
+        for (std::size_t d = 0; d < axes.size(); d++) size *= Order();
+        return size;
+    }
+
+    std::size_t GridInterpolant::Locate(const GridAxis& axis, double x, double& t)
+    {
+        const std::vector<double>& nodes = axis.nodes;
+        const std::size_t cell = axis.uniform ? axis.cells.Cell(x)
+            : static_cast<std::size_t>(std::upper_bound(nodes.begin() + 1, nodes.end() - 1, x) - nodes.begin()) - 1;
+        t = (x - nodes[cell]) / (nodes[cell + 1] - nodes[cell]);
+        return cell;
+    }
+
+    void GridInterpolant::StencilWeights(const GridAxis& axis, std::size_t cell, std::size_t* index, double* weight) const
+    {
+        const std::vector<double>& x = axis.nodes;
+        if (method == GridMethod::Linear) {
+            index[0] = cell;
+            index[1] = cell + 1;
+            weight[0] = 1.0; weight[1] = -1.0;
+            weight[2] = 0.0; weight[3] = 1.0;
+            return;
+        }
+
+        // Cubic Hermite basis on [0, 1] as coefficients of 1, t, t^2, t^3; the slopes, scaled by the cell width, are
+        // central differences inside the grid and one-sided differences at its ends.
+        static const double h00[4] = { 1.0, 0.0, -3.0, 2.0 };
+        static const double h10[4] = { 0.0, 1.0, -2.0, 1.0 };
+        static const double h01[4] = { 0.0, 0.0, 3.0, -2.0 };
+        static const double h11[4] = { 0.0, 0.0, -1.0, 1.0 };
+
+        const std::size_t n = x.size();
+        const double h = x[cell + 1] - x[cell];
+        double left[3] = { 0.0, -1.0, 1.0 };
+        double right[3] = { -1.0, 1.0, 0.0 };
+        if (cell > 0) {
+            const double alpha = h / (x[cell + 1] - x[cell - 1]);
+            left[0] = -alpha; left[1] = 0.0; left[2] = alpha;
+        }
+        if (cell + 2 < n) {
+            const double beta = h / (x[cell + 2] - x[cell]);
+            right[0] = -beta; right[1] = 0.0; right[2] = beta;
+        }
+
+        index[0] = cell > 0 ? cell - 1 : 0;
+        index[1] = cell;
+        index[2] = cell + 1;
+        index[3] = std::min(cell + 2, n - 1);
+        for (std::size_t p = 0; p < 4; p++) {
+            weight[p] = left[0] * h10[p];
+            weight[4 + p] = h00[p] + left[1] * h10[p] + right[0] * h11[p];
+            weight[8 + p] = h01[p] + left[2] * h10[p] + right[1] * h11[p];
+            weight[12 + p] = right[2] * h11[p];
+        }
+    }
+
+    void GridInterpolant::PrecomputeCells()
+    {
+        const std::size_t q = Order();
+        const std::size_t dims = axes.size();
+        Padded padded;
+        std::size_t cells = 1;
+        cellStrides.assign(dims, 0);
+        for (std::size_t d = dims; d-- > 0; ) {
+            padded.order[d] = q;
+            cellStrides[d] = cells;
+            cells *= axes[d].nodes.size() - 1;
+        }
+        const std::size_t stencil = Stencil();
+        std::vector<double> coefficients(cells * stencil);
+
+        std::size_t index[GridMaxDimensions][4] = {};
+        double weight[GridMaxDimensions][16] = {};
+        double tensor[64], next[64];
+        for (std::size_t c = 0; c < cells; c++) {
+            for (std::size_t d = 0; d < dims; d++) {
+                StencilWeights(axes[d], (c / cellStrides[d]) % (axes[d].nodes.size() - 1), index[d], weight[d]);
+            }
+
+            // Values of the stencil, then one mode product per axis turns node k into the coefficient of t_d^p.
+            std::size_t s = 0;
+            for (std::size_t k0 = 0; k0 < padded.order[0]; k0++)
+                for (std::size_t k1 = 0; k1 < padded.order[1]; k1++)
+                    for (std::size_t k2 = 0; k2 < padded.order[2]; k2++) {
+                        std::size_t offset = 0;
+                        const std::size_t k[GridMaxDimensions] = { k0, k1, k2 };
+                        for (std::size_t d = 0; d < dims; d++) offset += index[d][k[d]] * axes[d].stride;
+                        tensor[s++] = values[offset];
+                    }
+
+            for (std::size_t d = 0; d < dims; d++) {
+                std::size_t inner = 1;
+                for (std::size_t e = d + 1; e < dims; e++) inner *= q;
+                const std::size_t outer = stencil / (inner * q);
+                for (std::size_t o = 0; o < outer; o++) {
+                    for (std::size_t p = 0; p < q; p++) {
+                        for (std::size_t i = 0; i < inner; i++) {
+                            double sum = 0.0;
+                            for (std::size_t k = 0; k < q; k++) sum += tensor[(o * q + k) * inner + i] * weight[d][k * q + p];
+                            next[(o * q + p) * inner + i] = sum;
+                        }
+                    }
+                }
+                std::copy(next, next + stencil, tensor);
+            }
+            std::copy(tensor, tensor + stencil, coefficients.begin() + c * stencil);
+        }
+        cellCoefficients.swap(coefficients);
+    }
+
+    double GridInterpolant::EvaluatePrecomputed(const double* point) const
+    {
+        const std::size_t q = Order();
+        const std::size_t dims = axes.size();
+        double t[GridMaxDimensions] = { 0.0, 0.0, 0.0 };
+        std::size_t cell = 0;
+        for (std::size_t d = 0; d < dims; d++) {
+            cell += Locate(axes[d], point[d], t[d]) * cellStrides[d];
+        }
+        const double* c = cellCoefficients.data() + cell * Stencil();
+
+        // Nested Horner schemes, the last axis innermost.
+        if (dims == 1) return Horner(c, q, t[0]);
+        if (dims == 2) {
+            double result = 0.0;
+            for (std::size_t p0 = q; p0-- > 0; ) result = result * t[0] + Horner(c + p0 * q, q, t[1]);
+            return result;
+        }
+        double result = 0.0;
+        for (std::size_t p0 = q; p0-- > 0; ) {
+            double row = 0.0;
+            for (std::size_t p1 = q; p1-- > 0; ) row = row * t[1] + Horner(c + (p0 * q + p1) * q, q, t[2]);
+            result = result * t[0] + row;
+        }
+        return result;
+    }
+
+    double GridInterpolant::Evaluate(const double* point) const
+    {
+        if (Precomputed()) return EvaluatePrecomputed(point);
+
+        const std::size_t q = Order();
+        Padded padded;
+        std::size_t index[GridMaxDimensions][4] = {};
+        double weight[GridMaxDimensions][16] = {};
+        double w[GridMaxDimensions][4] = { { 1.0 }, { 1.0 }, { 1.0 } };
+        for (std::size_t d = 0; d < axes.size(); d++) {
+            double t;
+            StencilWeights(axes[d], Locate(axes[d], point[d], t), index[d], weight[d]);
+            for (std::size_t k = 0; k < q; k++) w[d][k] = Horner(weight[d] + k * q, q, t);
+            padded.order[d] = q;
+            padded.stride[d] = axes[d].stride;
+        }
+
+        double result = 0.0;
+        for (std::size_t k0 = 0; k0 < padded.order[0]; k0++)
+            for (std::size_t k1 = 0; k1 < padded.order[1]; k1++)
+                for (std::size_t k2 = 0; k2 < padded.order[2]; k2++) {
+                    const std::size_t offset = index[0][k0] * padded.stride[0] + index[1][k1] * padded.stride[1] + index[2][k2] * padded.stride[2];
+                    result += w[0][k0] * w[1][k1] * w[2][k2] * values[offset];
+                }
+        return result;
+    }
+
+    double GridInterpolant::Evaluate(const std::vector<double>& point) const
+    {
+        if (point.size() != axes.size())
+            throw std::invalid_argument("Point must have one coordinate per grid dimension.");
+        return Evaluate(point.data());
+    }
+
+    void GridInterpolant::Evaluate(const double* points, double* y, std::size_t count) const
+    {
+        const std::size_t dims = axes.size();
+        const std::size_t q = Order();
+        const std::size_t blocks = (count + parallel::BlockSize - 1) / parallel::BlockSize;
+        Padded padded;
+        for (std::size_t d = 0; d < dims; d++) padded.order[d] = q;
+
+        parallel::ForEachBlock(blocks, [&](std::size_t block) {
+            const std::size_t start = block * parallel::BlockSize;
+            const std::size_t size = std::min(parallel::BlockSize, count - start);
+            double* ys = y + start;
+
+            if (Precomputed()) {
+                for (std::size_t i = 0; i < size; i++) ys[i] = EvaluatePrecomputed(points + (start + i) * dims);
+                return;
+            }
+
+            // offsets[(d * 4 + k) * BlockSize + i] is the storage offset of stencil node k along axis d for point i, and
+            // weights holds the matching weights; trivial padded axes have offset 0 and weight 1.
+            std::size_t offsets[GridMaxDimensions * 4 * parallel::BlockSize];
+            double weights[GridMaxDimensions * 4 * parallel::BlockSize];
+            for (std::size_t d = dims; d < GridMaxDimensions; d++) {
+                std::fill_n(offsets + d * 4 * parallel::BlockSize, size, std::size_t(0));
+                std::fill_n(weights + d * 4 * parallel::BlockSize, size, 1.0);
+            }
+
+            std::size_t index[4];
+            double weight[16];
+            for (std::size_t d = 0; d < dims; d++) {
+                for (std::size_t i = 0; i < size; i++) {
+                    double t;
+                    StencilWeights(axes[d], Locate(axes[d], points[(start + i) * dims + d], t), index, weight);
+                    for (std::size_t k = 0; k < q; k++) {
+                        offsets[(d * 4 + k) * parallel::BlockSize + i] = index[k] * axes[d].stride;
+                        weights[(d * 4 + k) * parallel::BlockSize + i] = Horner(weight + k * q, q, t);
+                    }
+                }
+            }
+
+            for (std::size_t i = 0; i < size; i++) ys[i] = 0.0;
+            for (std::size_t k0 = 0; k0 < padded.order[0]; k0++)
+                for (std::size_t k1 = 0; k1 < padded.order[1]; k1++)
+                    for (std::size_t k2 = 0; k2 < padded.order[2]; k2++) {
+                        const std::size_t* o0 = offsets + k0 * parallel::BlockSize;
+                        const std::size_t* o1 = offsets + (4 + k1) * parallel::BlockSize;
+                        const std::size_t* o2 = offsets + (8 + k2) * parallel::BlockSize;
+                        const double* w0 = weights + k0 * parallel::BlockSize;
+                        const double* w1 = weights + (4 + k1) * parallel::BlockSize;
+                        const double* w2 = weights + (8 + k2) * parallel::BlockSize;
+                        for (std::size_t i = 0; i < size; i++) {
+                            ys[i] += w0[i] * w1[i] * w2[i] * values[o0[i] + o1[i] + o2[i]];
+                        }
+                    }
+            });
+    }
+
+} // namespace NumericLib
@@ -1,8 +1,27 @@
 #include "interpolation/lagrange.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
 #include <stdexcept>
+#include <utility>
 
 namespace NumericLib {
 
+    namespace {
+
+        void CheckNodeRange(std::size_t count, const std::vector<double>& range)
+        {
+            if (count == 0)
+                throw std::invalid_argument("At least one node is required.");
+            if (range.size() != 2)
+                throw std::invalid_argument("Range vector must have exactly two elements.");
+            if (range[0] >= range[1])
+                throw std::invalid_argument("Range start must be less than range end.");
+        }
+
+    } // namespace
+
     double InterpolateLagrange(double x, const std::vector<double>& xi, const std::vector<double>& fxi, int prec)
     {
         if (xi.size() != fxi.size() || xi.empty()) {
@@ -30,4 +49,177 @@ namespace NumericLib {
         return sum;
     }
 
+    BarycentricInterpolant::BarycentricInterpolant(std::vector<double> x, std::vector<double> y, std::vector<double> w)
+        : nodes(std::move(x)), values(std::move(y)), weights(std::move(w))
+    {
+        Normalize();
+    }
+
+    BarycentricInterpolant::BarycentricInterpolant(std::vector<double> x, std::vector<double> y)
+        : nodes(std::move(x)), values(std::move(y))
+    {
+        if (nodes.size() != values.size() || nodes.empty()) {
+            throw std::invalid_argument("Input vectors must have the same non-zero size.");
+        }
+
+        // Differences are scaled by 4 / (max - min), the inverse capacity of the interval, so the products neither
+        // overflow nor underflow for well-distributed nodes; the common factor cancels in the barycentric formula.
+        const auto bounds = std::minmax_element(nodes.begin(), nodes.end());
+        const double scale = nodes.size() > 1 ? 4.0 / (*bounds.second - *bounds.first) : 1.0;
+
+        weights.assign(nodes.size(), 1.0);
+        for (std::size_t j = 0; j < nodes.size(); j++) {
+            for (std::size_t k = 0; k < nodes.size(); k++) {
+                if (k == j) continue;
+                const double difference = nodes[j] - nodes[k];
+                if (difference == 0.0)
+                    throw std::invalid_argument("Interpolation points must be distinct.");
+                weights[j] *= scale * difference;
+            }
+            weights[j] = 1.0 / weights[j];
+        }
+        Normalize();
+    }
+
+    void BarycentricInterpolant::Normalize()
+    {
+        double largest = 0.0;
+        for (double w : weights) largest = std::max(largest, std::abs(w));
+        for (double& w : weights) w /= largest;
+    }
+
+    std::vector<double> BarycentricInterpolant::ChebyshevNodes(std::size_t count, const std::vector<double>& range, ChebyshevNodeKind kind)
+    {
+        CheckNodeRange(count, range);
+        const double mid = (range[0] + range[1]) / 2.0, half = (range[1] - range[0]) / 2.0;
+        const std::size_t n = count - 1;
+
+        std::vector<double> x(count, mid);
+        for (std::size_t j = 0; j < count; j++) {
+            if (kind == ChebyshevNodeKind::First) {
+                x[j] = mid + half * std::cos((2.0 * j + 1.0) * std::numbers::pi / (2.0 * n + 2.0));
+            }
+            else if (n > 0) {
+                x[j] = mid + half * std::cos(std::numbers::pi * static_cast<double>(j) / static_cast<double>(n));
+            }
+        }
+        return x;
+    }
+
+    std::vector<double> BarycentricInterpolant::EquispacedNodes(std::size_t count, const std::vector<double>& range)
+    {
+        CheckNodeRange(count, range);
+        if (count == 1) return { (range[0] + range[1]) / 2.0 };
+
+        const double h = (range[1] - range[0]) / static_cast<double>(count - 1);
+        std::vector<double> x(count);
+        for (std::size_t j = 0; j < count; j++) x[j] = range[0] + h * static_cast<double>(j);
+        x.back() = range[1];
+        return x;
+    }
+
+    BarycentricInterpolant BarycentricInterpolant::Chebyshev(std::vector<double> y, const std::vector<double>& range, ChebyshevNodeKind kind)
+    {
+        std::vector<double> x = ChebyshevNodes(y.size(), range, kind);
+        const std::size_t n = y.size() - 1;
+
+        std::vector<double> w(y.size());
+        for (std::size_t j = 0; j <= n; j++) {
+            const double sign = j % 2 == 0 ? 1.0 : -1.0;
+            if (kind == ChebyshevNodeKind::First) {
+                w[j] = sign * std::sin((2.0 * j + 1.0) * std::numbers::pi / (2.0 * n + 2.0));
+            }
+            else {
+                w[j] = j == 0 || j == n ? sign / 2.0 : sign;
+            }
+        }
+        return BarycentricInterpolant(std::move(x), std::move(y), std::move(w));
+    }
+
+    BarycentricInterpolant BarycentricInterpolant::Equispaced(std::vector<double> y, const std::vector<double>& range)
+    {
+        std::vector<double> x = EquispacedNodes(y.size(), range);
+        const std::size_t n = y.size() - 1;
+
+        // (-1)^j C(n, j) relative to the middle binomial coefficient, built outwards so the weights stay in [0, 1].
+        std::vector<double> w(y.size(), 1.0);
+        const std::size_t middle = n / 2;
+        for (std::size_t j = middle; j < n; j++) {
+            w[j + 1] = w[j] * static_cast<double>(n - j) / static_cast<double>(j + 1);
+        }
+        for (std::size_t j = middle; j > 0; j--) {
+            w[j - 1] = w[j] * static_cast<double>(j) / static_cast<double>(n - j + 1);
+        }
+        for (std::size_t j = 1; j <= n; j += 2) w[j] = -w[j];
+        return BarycentricInterpolant(std::move(x), std::move(y), std::move(w));
+    }
+
+    void BarycentricInterpolant::AddNode(double x, double y)
+    {
+        // The new weight is 1 / prod (x - x_k) expressed relative to w_0 = 1 / prod (x_0 - x_k), which carries the
+        // current scaling of the weights: w_new = w_0 / (x - x_0) * prod_{k > 0} (x_0 - x_k) / (x - x_k).
+        double added = weights[0];
+        for (std::size_t k = 0; k < nodes.size(); k++) {
+            const double difference = x - nodes[k];
+            if (difference == 0.0)
+                throw std::invalid_argument("Interpolation points must be distinct.");
+            added *= k == 0 ? 1.0 / difference : (nodes[0] - nodes[k]) / difference;
+        }
+        for (std::size_t j = 0; j < nodes.size(); j++) {
+            weights[j] /= nodes[j] - x;
+        }
+
+        nodes.push_back(x);
+        values.push_back(y);
+        weights.push_back(added);
+        Normalize();
+    }
+
+    double BarycentricInterpolant::Evaluate(double x) const
+    {
+        double numerator = 0.0, denominator = 0.0;
+        for (std::size_t j = 0; j < nodes.size(); j++) {
+            const double difference = x - nodes[j];
+            if (difference == 0.0) return values[j];
+            const double term = weights[j] / difference;
+            numerator += term * values[j];
+            denominator += term;
+        }
+        return numerator / denominator;
+    }
+
+    void BarycentricInterpolant::Evaluate(const double* x, double* y, std::size_t count) const
+    {
+        double numerator[parallel::BlockSize];
+        double denominator[parallel::BlockSize];
+        for (std::size_t start = 0; start < count; start += parallel::BlockSize) {
+            const std::size_t size = std::min(parallel::BlockSize, count - start);
+            const double* xs = x + start;
+            for (std::size_t i = 0; i < size; i++) {
+                numerator[i] = 0.0;
+                denominator[i] = 0.0;
+            }
+            for (std::size_t j = 0; j < nodes.size(); j++) {
+                const double node = nodes[j], w = weights[j], wy = weights[j] * values[j];
+                for (std::size_t i = 0; i < size; i++) {
+                    const double inverse = 1.0 / (xs[i] - node);
+                    numerator[i] += wy * inverse;
+                    denominator[i] += w * inverse;
+                }
+            }
+            // A point on a node divides by zero and gives inf / inf; those few points are redone by the scalar formula.
+            for (std::size_t i = 0; i < size; i++) {
+                const double value = numerator[i] / denominator[i];
+                y[start + i] = std::isfinite(value) ? value : Evaluate(xs[i]);
+            }
+        }
+    }
+
+    std::vector<double> BarycentricInterpolant::Evaluate(const std::vector<double>& x) const
+    {
+        std::vector<double> y(x.size());
+        Evaluate(x.data(), y.data(), x.size());
+        return y;
+    }
+
 } // namespace NumericLib
@@ -1,6 +1,9 @@
 #include "interpolation/newton.hpp"
+#include "parallel.hpp"
+#include <algorithm>
 #include <vector>
 #include <stdexcept>
+#include <utility>
 
 namespace NumericLib {
 
@@ -44,24 +47,20 @@ namespace NumericLib {
 	/// vector of Newton coefficients a0, a1, ..., an, where n = x.size() - 1.
     /// </returns>
     std::vector<double> computeDividedDifferences(const std::vector<double>& x, const std::vector<double>& y) {
-        int n = x.size();
-        std::vector<std::vector<double>> table(n, std::vector<double>(n));
+        size_t n = x.size();
+        std::vector<double> coefficients = y;
 
-        for (int i = 0; i < n; i++) {
-            table[i][0] = y[i];
-        }
-
-        for (int j = 1; j < n; j++) {
-            for (int i = 0; i < n - j; i++) {
-                table[i][j] = (table[i + 1][j - 1] - table[i][j - 1]) / (x[i + j] - x[i]);
+        // Column j of the divided difference table overwrites entries j..n-1; entry j is final once column j is done.
+        for (size_t j = 1; j < n; j++) {
+            for (size_t i = n - 1; i >= j; i--) {
+                double dx = x[i] - x[i - j];
+                if (dx == 0.0) {
+                    throw std::invalid_argument("Interpolation points must be distinct.");
+                }
+                coefficients[i] = (coefficients[i] - coefficients[i - 1]) / dx;
             }
         }
 
-        std::vector<double> coefficients(n);
-        for (int i = 0; i < n; i++) {
-            coefficients[i] = table[0][i];
-        }
-
         return coefficients;
     }
 
@@ -74,4 +73,91 @@ namespace NumericLib {
         return evaluateNewtonPolynomial(x_val, x, coeffs);
     }
 
+    NewtonInterpolant::NewtonInterpolant(std::vector<double> x, const std::vector<double>& y)
+        : nodes(std::move(x))
+    {
+        if (nodes.size() != y.size() || nodes.empty()) {
+            throw std::invalid_argument("Input vectors must have the same non-zero size.");
+        }
+        coeffs = computeDividedDifferences(nodes, y);
+    }
+
+    double NewtonInterpolant::Evaluate(double x) const {
+        size_t k = coeffs.size() - 1;
+        double result = coeffs[k];
+        while (k-- > 0) {
+            result = result * (x - nodes[k]) + coeffs[k];
+        }
+        return result;
+    }
+
+    void NewtonInterpolant::Evaluate(const double* x, double* y, std::size_t count) const {
+        const std::size_t n = coeffs.size() - 1;
+        const std::size_t blocks = (count + parallel::BlockSize - 1) / parallel::BlockSize;
+
+        parallel::ForEachBlock(blocks, [&](std::size_t block) {
+            const std::size_t start = block * parallel::BlockSize;
+            const std::size_t size = std::min(parallel::BlockSize, count - start);
+            const double* xs = x + start;
+            double* ys = y + start;
+            for (std::size_t i = 0; i < size; i++) ys[i] = coeffs[n];
+            for (std::size_t k = n; k-- > 0; ) {
+                const double node = nodes[k];
+                const double c = coeffs[k];
+                for (std::size_t i = 0; i < size; i++) ys[i] = ys[i] * (xs[i] - node) + c;
+            }
+            });
+    }
+
+    std::vector<double> NewtonInterpolant::Evaluate(const std::vector<double>& x) const {
+        std::vector<double> y(x.size());
+        Evaluate(x.data(), y.data(), x.size());
+        return y;
+    }
+
+    StreamingNewtonInterpolant::StreamingNewtonInterpolant(std::size_t window)
+    {
+        if (window == 0) {
+            throw std::invalid_argument("Window must hold at least one sample.");
+        }
+        nodes.resize(window);
+        diagonal.resize(window);
+    }
+
+    void StreamingNewtonInterpolant::Push(double x, double y) {
+        const std::size_t window = nodes.size();
+
+        // The coefficients of the new diagonal use the newest window - 1 nodes; the oldest node is evicted with the last term.
+        const std::size_t terms = std::min(count + 1, window);
+        for (std::size_t i = 0; i + 1 < terms; i++) {
+            if (x == Node(i)) {
+                throw std::invalid_argument("Interpolation points must be distinct.");
+            }
+        }
+
+        // f[x_{n-j+1}, ..., x] = (f[x_{n-j+2}, ..., x] - f[x_{n-j+1}, ..., x_n]) / (x - x_{n-j+1}), in place over the old diagonal.
+        double previous = diagonal[0];
+        diagonal[0] = y;
+        for (std::size_t j = 1; j < terms; j++) {
+            const double old = diagonal[j];
+            diagonal[j] = (diagonal[j - 1] - previous) / (x - Node(j - 1));
+            previous = old;
+        }
+
+        newest = (newest + 1) % window;
+        nodes[newest] = x;
+        count = terms;
+    }
+
+    double StreamingNewtonInterpolant::Evaluate(double x) const {
+        if (count == 0) {
+            throw std::runtime_error("No samples in the window.");
+        }
+        double result = diagonal[count - 1];
+        for (std::size_t j = count - 1; j-- > 0; ) {
+            result = result * (x - Node(j)) + diagonal[j];
+        }
+        return result;
+    }
+
 } // namespace NumericLib
@@ -0,0 +1,218 @@
+#include "interpolation/spline.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace NumericLib {
+
+    namespace {
+
+        // Solves the tridiagonal system sub[i] m[i-1] + diag[i] m[i] + super[i] m[i+1] = rhs[i] by the Thomas algorithm;
+        // the solution overwrites rhs.
+        void SolveTridiagonal(const std::vector<double>& sub, std::vector<double> diag, const std::vector<double>& super, std::vector<double>& rhs)
+        {
+            const std::size_t n = diag.size();
+            for (std::size_t i = 1; i < n; i++) {
+                const double factor = sub[i] / diag[i - 1];
+                diag[i] -= factor * super[i - 1];
+                rhs[i] -= factor * rhs[i - 1];
+            }
+            rhs[n - 1] /= diag[n - 1];
+            for (std::size_t i = n - 1; i-- > 0; ) {
+                rhs[i] = (rhs[i] - super[i] * rhs[i + 1]) / diag[i];
+            }
+        }
+
+        // Node slopes of the C2 cubic spline with the given end conditions.
+        std::vector<double> SplineSlopes(const std::vector<double>& h, const std::vector<double>& delta, SplineKind kind,
+            double startSlope, double endSlope)
+        {
+            const std::size_t n = h.size() + 1;
+            if (kind == SplineKind::NotAKnot && n == 2) {
+                return { delta[0], delta[0] };
+            }
+            if (kind == SplineKind::NotAKnot && n == 3) {
+                // The not-a-knot spline through three points is the interpolating parabola.
+                const double curvature = (delta[1] - delta[0]) / (h[0] + h[1]);
+                return { delta[0] - h[0] * curvature, delta[0] + h[0] * curvature, delta[0] + (h[0] + 2.0 * h[1]) * curvature };
+            }
+
+            std::vector<double> sub(n, 0.0), diag(n), super(n, 0.0), slopes(n);
+            for (std::size_t i = 1; i + 1 < n; i++) {
+                sub[i] = h[i];
+                diag[i] = 2.0 * (h[i - 1] + h[i]);
+                super[i] = h[i - 1];
+                slopes[i] = 3.0 * (h[i] * delta[i - 1] + h[i - 1] * delta[i]);
+            }
+
+            const std::size_t last = n - 1;
+            if (kind == SplineKind::Natural) {
+                diag[0] = 2.0;
+                super[0] = 1.0;
+                slopes[0] = 3.0 * delta[0];
+                sub[last] = 1.0;
+                diag[last] = 2.0;
+                slopes[last] = 3.0 * delta[last - 1];
+            }
+            else if (kind == SplineKind::Clamped) {
+                diag[0] = 1.0;
+                slopes[0] = startSlope;
+                diag[last] = 1.0;
+                slopes[last] = endSlope;
+            }
+            else {
+                double d = h[0] + h[1];
+                diag[0] = h[1];
+                super[0] = d;
+                slopes[0] = ((h[0] + 2.0 * d) * h[1] * delta[0] + h[0] * h[0] * delta[1]) / d;
+
+                d = h[last - 2] + h[last - 1];
+                sub[last] = d;
+                diag[last] = h[last - 2];
+                slopes[last] = (h[last - 1] * h[last - 1] * delta[last - 2] + (2.0 * d + h[last - 1]) * h[last - 2] * delta[last - 1]) / d;
+            }
+
+            SolveTridiagonal(sub, diag, super, slopes);
+            return slopes;
+        }
+
+        // End slope of the monotone interpolant: the three-point estimate, limited so the end piece keeps its shape.
+        double MonotoneEndSlope(double h0, double h1, double delta0, double delta1)
+        {
+            double slope = ((2.0 * h0 + h1) * delta0 - h0 * delta1) / (h0 + h1);
+            if (slope * delta0 <= 0.0) return 0.0;
+            if (delta0 * delta1 <= 0.0 && std::abs(slope) > 3.0 * std::abs(delta0)) return 3.0 * delta0;
+            return slope;
+        }
+
+        // Node slopes of the PCHIP interpolant: zero at local extrema, otherwise a weighted harmonic mean of the secants.
+        std::vector<double> MonotoneSlopes(const std::vector<double>& h, const std::vector<double>& delta)
+        {
+            const std::size_t n = h.size() + 1;
+            if (n == 2) return { delta[0], delta[0] };
+
+            std::vector<double> slopes(n);
+            for (std::size_t i = 1; i + 1 < n; i++) {
+                if (delta[i - 1] * delta[i] <= 0.0) {
+                    slopes[i] = 0.0;
+                    continue;
+                }
+                const double w1 = 2.0 * h[i] + h[i - 1], w2 = h[i] + 2.0 * h[i - 1];
+                slopes[i] = (w1 + w2) / (w1 / delta[i - 1] + w2 / delta[i]);
+            }
+            slopes[0] = MonotoneEndSlope(h[0], h[1], delta[0], delta[1]);
+            slopes[n - 1] = MonotoneEndSlope(h[n - 2], h[n - 3], delta[n - 2], delta[n - 3]);
+            return slopes;
+        }
+
+    } // namespace
+
+    Spline::Spline(std::vector<double> x, const std::vector<double>& y, SplineKind splineKind, double startSlope, double endSlope)
+        : nodes(std::move(x)), kind(splineKind)
+    {
+        if (nodes.size() != y.size())
+            throw std::invalid_argument("Vectors x and y must have the same size.");
+        if (nodes.size() < 2)
+            throw std::invalid_argument("At least two interpolation points are required.");
+
+        const std::size_t intervals = nodes.size() - 1;
+        std::vector<double> h(intervals), delta(intervals);
+        for (std::size_t i = 0; i < intervals; i++) {
+            h[i] = nodes[i + 1] - nodes[i];
+            if (!(h[i] > 0.0))
+                throw std::invalid_argument("Interpolation points must be strictly increasing.");
+            delta[i] = (y[i + 1] - y[i]) / h[i];
+        }
+
+        c0.assign(y.begin(), y.end() - 1);
+        c1.resize(intervals);
+        c2.assign(intervals, 0.0);
+        c3.assign(intervals, 0.0);
+        if (kind == SplineKind::Linear) {
+            c1 = delta;
+        }
+        else {
+            // Cubic Hermite pieces from the node slopes.
+            const std::vector<double> slopes = kind == SplineKind::Monotone ? MonotoneSlopes(h, delta)
+                : SplineSlopes(h, delta, kind, startSlope, endSlope);
+            for (std::size_t i = 0; i < intervals; i++) {
+                c1[i] = slopes[i];
+                c2[i] = (3.0 * delta[i] - 2.0 * slopes[i] - slopes[i + 1]) / h[i];
+                c3[i] = (slopes[i] + slopes[i + 1] - 2.0 * delta[i]) / (h[i] * h[i]);
+            }
+        }
+
+        uniform = isUniformAxis(nodes);
+        intervalAxis = UniformAxis(nodes.front(), nodes.back(), intervals);
+    }
+
+    std::size_t Spline::Locate(double x, std::size_t hint) const
+    {
+        if (uniform) return intervalAxis.Cell(x);
+
+        const std::size_t last = nodes.size() - 2;
+        hint = std::min(hint, last);
+        if (nodes[hint] <= x && (hint == last || x < nodes[hint + 1])) return hint;
+        if (hint < last && nodes[hint + 1] <= x && (hint + 1 == last || x < nodes[hint + 2])) return hint + 1;
+
+        const auto it = std::upper_bound(nodes.begin() + 1, nodes.end() - 1, x);
+        return static_cast<std::size_t>(it - nodes.begin()) - 1;
+    }
+
+    double Spline::Evaluate(double x) const
+    {
+        std::size_t interval = 0;
+        return Evaluate(x, interval);
+    }
+
+    double Spline::Evaluate(double x, std::size_t& interval) const
+    {
+        interval = Locate(x, interval);
+        const double t = x - nodes[interval];
+        return c0[interval] + t * (c1[interval] + t * (c2[interval] + t * c3[interval]));
+    }
+
+    void Spline::Evaluate(const double* x, double* y, std::size_t count) const
+    {
+        std::size_t index[parallel::BlockSize];
+        std::size_t hint = 0;
+        for (std::size_t start = 0; start < count; start += parallel::BlockSize) {
+            const std::size_t size = std::min(parallel::BlockSize, count - start);
+            const double* xs = x + start;
+            double* ys = y + start;
+
+            if (uniform) {
+                for (std::size_t i = 0; i < size; i++) index[i] = intervalAxis.Cell(xs[i]);
+            }
+            else {
+                for (std::size_t i = 0; i < size; i++) {
+                    hint = Locate(xs[i], hint);
+                    index[i] = hint;
+                }
+            }
+
+            for (std::size_t i = 0; i < size; i++) {
+                const std::size_t k = index[i];
+                const double t = xs[i] - nodes[k];
+                ys[i] = c0[k] + t * (c1[k] + t * (c2[k] + t * c3[k]));
+            }
+        }
+    }
+
+    std::vector<double> Spline::Evaluate(const std::vector<double>& x) const
+    {
+        std::vector<double> y(x.size());
+        Evaluate(x.data(), y.data(), x.size());
+        return y;
+    }
+
+    double Spline::Derivative(double x) const
+    {
+        const std::size_t interval = Locate(x, 0);
+        const double t = x - nodes[interval];
+        return c1[interval] + t * (2.0 * c2[interval] + t * 3.0 * c3[interval]);
+    }
+
+} // namespace NumericLib
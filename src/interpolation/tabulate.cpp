@@ -0,0 +1,136 @@
+#include "interpolation/tabulate.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace NumericLib {
+
+    namespace {
+
+        // The index grid has at most this many cells per segment.
+        const std::size_t CellsPerSegment = 8;
+
+    } // namespace
+
+    std::vector<double> TabulatedFunction::FitNodes(int degree)
+    {
+        std::vector<double> t(degree + 1);
+        for (int j = 0; j <= degree; j++) t[j] = std::cos((2.0 * j + 1.0) * std::numbers::pi / (2.0 * degree + 2.0));
+        return t;
+    }
+
+    std::vector<double> TabulatedFunction::CheckNodes()
+    {
+        std::vector<double> t(TabulateCheckPoints);
+        for (int i = 0; i < TabulateCheckPoints; i++) t[i] = -1.0 + 2.0 * i / (TabulateCheckPoints - 1.0);
+        return t;
+    }
+
+    std::vector<double> TabulatedFunction::FitSegment(const std::vector<double>& values)
+    {
+        const std::size_t n = values.size();
+        const std::vector<double> t = FitNodes(static_cast<int>(n) - 1);
+
+        // Chebyshev coefficients of the interpolant at the Chebyshev roots, then the sum of c_k T_k expanded into monomials
+        // with T_{k+1} = 2t T_k - T_{k-1}; the degree is small enough for the expansion to stay accurate on [-1, 1].
+        std::vector<double> coefficients(n, 0.0);
+        std::vector<double> previous(n, 0.0), current(n, 0.0), next(n);
+        previous[0] = 1.0;
+        if (n > 1) current[1] = 1.0;
+        for (std::size_t k = 0; k < n; k++) {
+            double c = 0.0;
+            for (std::size_t j = 0; j < n; j++) {
+                c += values[j] * std::cos(k * std::acos(t[j]));
+            }
+            c *= (k == 0 ? 1.0 : 2.0) / static_cast<double>(n);
+
+            const std::vector<double>& basis = k == 0 ? previous : current;
+            for (std::size_t i = 0; i < n; i++) coefficients[i] += c * basis[i];
+
+            if (k >= 1 && k + 1 < n) {
+                for (std::size_t i = 0; i < n; i++) next[i] = (i > 0 ? 2.0 * current[i - 1] : 0.0) - previous[i];
+                previous.swap(current);
+                current.swap(next);
+            }
+        }
+        return coefficients;
+    }
+
+    double TabulatedFunction::Horner(const double* coefficients, int degree, double t)
+    {
+        double result = coefficients[degree];
+        for (int i = degree - 1; i >= 0; i--) result = result * t + coefficients[i];
+        return result;
+    }
+
+    void TabulatedFunction::AddSegment(double lo, double hi, const std::vector<double>& coefficients)
+    {
+        if (breaks.empty()) breaks.push_back(lo);
+        breaks.push_back(hi);
+        table.push_back((lo + hi) / 2.0);
+        table.push_back(2.0 / (hi - lo));
+        table.insert(table.end(), coefficients.begin(), coefficients.end());
+    }
+
+    void TabulatedFunction::BuildIndex()
+    {
+        const std::size_t segments = Segments();
+        double narrowest = b - a;
+        for (std::size_t k = 0; k < segments; k++) narrowest = std::min(narrowest, breaks[k + 1] - breaks[k]);
+
+        // With cells no wider than the narrowest segment every lookup is a single step; the cap bounds the index size.
+        const double fit = std::ceil((b - a) / narrowest);
+        const std::size_t count = std::max<std::size_t>(1, static_cast<std::size_t>(std::min(fit, static_cast<double>(CellsPerSegment * segments))));
+        cells = UniformAxis(a, b, count);
+
+        cellStart.resize(count);
+        for (std::size_t c = 0; c < count; c++) {
+            const double start = a + (b - a) * static_cast<double>(c) / static_cast<double>(count);
+            cellStart[c] = static_cast<std::size_t>(std::upper_bound(breaks.begin() + 1, breaks.end() - 1, start) - breaks.begin()) - 1;
+        }
+    }
+
+    std::size_t TabulatedFunction::Locate(double x) const
+    {
+        std::size_t k = cellStart[cells.Cell(x)];
+        const std::size_t last = Segments() - 1;
+        while (k < last && x >= breaks[k + 1]) k++;
+        return k;
+    }
+
+    double TabulatedFunction::Evaluate(double x) const
+    {
+        const double* segment = table.data() + Locate(x) * Stride();
+        return Horner(segment + 2, degree, (x - segment[0]) * segment[1]);
+    }
+
+    void TabulatedFunction::Evaluate(const double* x, double* y, std::size_t count) const
+    {
+        const std::size_t stride = Stride();
+        const double* segments[parallel::BlockSize];
+        double t[parallel::BlockSize];
+        for (std::size_t start = 0; start < count; start += parallel::BlockSize) {
+            const std::size_t size = std::min(parallel::BlockSize, count - start);
+            const double* xs = x + start;
+            double* ys = y + start;
+
+            for (std::size_t i = 0; i < size; i++) {
+                segments[i] = table.data() + Locate(xs[i]) * stride;
+                t[i] = (xs[i] - segments[i][0]) * segments[i][1];
+                ys[i] = segments[i][2 + degree];
+            }
+            for (int k = degree - 1; k >= 0; k--) {
+                for (std::size_t i = 0; i < size; i++) ys[i] = ys[i] * t[i] + segments[i][2 + k];
+            }
+        }
+    }
+
+    std::vector<double> TabulatedFunction::Evaluate(const std::vector<double>& x) const
+    {
+        std::vector<double> y(x.size());
+        Evaluate(x.data(), y.data(), x.size());
+        return y;
+    }
+
+} // namespace NumericLib
@@ -0,0 +1,213 @@
+#include "io/artifact_cache.hpp"
+#include "liniear_systems/lu.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <sstream>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace NumericLib {
+
+    namespace {
+
+        const char* ArtifactExtension = ".nlb";
+
+        std::string ToHex(std::uint64_t value) {
+            char text[17];
+            std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(value));
+            return text;
+        }
+
+        long long ProcessId() {
+#ifdef _WIN32
+            return _getpid();
+#else
+            return getpid();
+#endif
+        }
+
+    } // namespace
+
+    std::string ArtifactKey(const std::string& name, const std::vector<std::vector<double>>& content)
+    {
+        std::uint64_t hash = BinaryChecksum(name.data(), name.size());
+        for (const auto& row : content) {
+            std::uint64_t length = row.size();
+            hash ^= BinaryChecksum(&length, sizeof(length)) + (hash << 6) + (hash >> 2);
+            hash ^= BinaryChecksum(row.data(), row.size() * sizeof(double)) + (hash << 6) + (hash >> 2);
+        }
+        return name + "@v" + std::to_string(ArtifactFormatVersion) + "." + std::to_string(BinaryMatrixVersion) + "#" + ToHex(hash);
+    }
+
+    ArtifactCache::ArtifactCache(const std::string& dir, std::uint64_t sizeLimit, bool verifyChecksum)
+        : directory(dir), maxBytes(sizeLimit), verify(verifyChecksum)
+    {
+        std::error_code ec;
+        fs::create_directories(directory, ec);
+        if (ec || !fs::is_directory(directory))
+            throw std::runtime_error("Cannot create cache directory: " + directory);
+    }
+
+    std::string ArtifactCache::PathFor(const std::string& key) const
+    {
+        return (fs::path(directory) / (ToHex(BinaryChecksum(key.data(), key.size())) + ArtifactExtension)).string();
+    }
+
+    std::optional<MappedMatrix> ArtifactCache::Find(const std::string& key)
+    {
+        const std::string path = PathFor(key);
+        std::error_code ec;
+        if (!fs::exists(path, ec)) return std::nullopt;
+
+        try {
+            MappedMatrix mapped(path, verify);
+
+            // The modification time doubles as the last use time for LRU eviction.
+            fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+            return std::optional<MappedMatrix>(std::move(mapped));
+        }
+        catch (const BinaryMatrixFormatError&) {
+            fs::remove(path, ec);
+            return std::nullopt;
+        }
+        catch (const std::runtime_error&) {
+            // The file may be locked or briefly unavailable; it is not known to be corrupt, so it is kept.
+            return std::nullopt;
+        }
+    }
+
+    MappedMatrix ArtifactCache::Store(const std::string& key, const std::vector<std::vector<double>>& A, const std::vector<double>& b)
+    {
+        const std::string path = PathFor(key);
+
+        // Write under a temporary name first so readers never map a partially written artifact. The name is unique per
+        // process and thread, as several processes may share the cache directory.
+        std::ostringstream temporary;
+        temporary << path << ".tmp" << ProcessId() << '.' << std::this_thread::get_id();
+        std::error_code ec;
+        try {
+            WriteBinaryMatrix(temporary.str(), A, b);
+        }
+        catch (...) {
+            fs::remove(temporary.str(), ec);
+            throw;
+        }
+
+        fs::rename(temporary.str(), path, ec);
+        if (ec) {
+            fs::remove(temporary.str(), ec);
+            throw std::runtime_error("Cannot store artifact: " + path);
+        }
+
+        Evict(path);
+        return MappedMatrix(path);
+    }
+
+    void ArtifactCache::Evict(const std::string& keep)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        struct Entry {
+            fs::path path;
+            std::uint64_t size;
+            fs::file_time_type used;
+        };
+        std::vector<Entry> entries;
+        std::uint64_t total = 0;
+
+        std::error_code ec;
+        for (const auto& item : fs::directory_iterator(directory, ec)) {
+            if (!item.is_regular_file(ec) || item.path().extension() != ArtifactExtension) continue;
+            Entry entry{ item.path(), item.file_size(ec), item.last_write_time(ec) };
+            total += entry.size;
+            if (!fs::equivalent(entry.path, keep, ec)) entries.push_back(entry);
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.used < b.used; });
+        for (const auto& entry : entries) {
+            if (total <= maxBytes) break;
+            if (fs::remove(entry.path, ec)) total -= entry.size;
+        }
+    }
+
+    std::uint64_t ArtifactCache::Size()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::uint64_t total = 0;
+        std::error_code ec;
+        for (const auto& item : fs::directory_iterator(directory, ec)) {
+            if (item.is_regular_file(ec) && item.path().extension() == ArtifactExtension) total += item.file_size(ec);
+        }
+        return total;
+    }
+
+    void ArtifactCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::error_code ec;
+        std::vector<fs::path> files;
+        for (const auto& item : fs::directory_iterator(directory, ec)) {
+            if (item.is_regular_file(ec) && item.path().extension() == ArtifactExtension) files.push_back(item.path());
+        }
+        for (const auto& file : files) {
+            fs::remove(file, ec);
+        }
+    }
+
+    GaussLegendreRule CachedGLRule(ArtifactCache& cache, int n)
+    {
+        MappedMatrix mapped = cache.GetOrCreate(ArtifactKey("gauss_legendre/" + std::to_string(n)), [n]() {
+            GaussLegendreRule rule = getGLRule(n);
+            return std::make_pair(std::vector<std::vector<double>>{ rule.nodes, rule.weights }, std::vector<double>());
+            });
+
+        MatrixView view = mapped.matrix();
+        GaussLegendreRule rule;
+        for (std::size_t i = 0; i < view.cols; i++) {
+            rule.nodes.push_back(view(0, i));
+            rule.weights.push_back(view(1, i));
+        }
+        return rule;
+    }
+
+    void CachedLuDecomposition(ArtifactCache& cache, const std::vector<std::vector<double>>& A,
+        std::vector<std::vector<double>>& L, std::vector<std::vector<double>>& U)
+    {
+        // L and U are packed into one matrix: the unit diagonal of L is implicit.
+        MappedMatrix mapped = cache.GetOrCreate(ArtifactKey("lu", A), [&A]() {
+            std::vector<std::vector<double>> copy = A, lower, upper;
+            std::vector<double> unused(A.size());
+            luDecomposition(copy, lower, upper, unused);
+
+            for (std::size_t i = 0; i < A.size(); i++) {
+                for (std::size_t j = 0; j < i; j++) {
+                    upper[i][j] = lower[i][j];
+                }
+            }
+            return std::make_pair(upper, std::vector<double>());
+            });
+
+        MatrixView packed = mapped.matrix();
+        const std::size_t n = packed.rows;
+        L.assign(n, std::vector<double>(n, 0.0));
+        U.assign(n, std::vector<double>(n, 0.0));
+        for (std::size_t i = 0; i < n; i++) {
+            for (std::size_t j = 0; j < n; j++) {
+                if (j < i) L[i][j] = packed(i, j);
+                else U[i][j] = packed(i, j);
+            }
+            L[i][i] = 1.0;
+        }
+    }
+
+} // namespace NumericLib
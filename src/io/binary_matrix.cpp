@@ -0,0 +1,321 @@
+#include "io/binary_matrix.hpp"
+#include "numeric_io.hpp"
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace NumericLib {
+
+    namespace {
+
+        const char BinaryMagic[8] = { 'N', 'L', 'B', 'M', 'A', 'T', '\0', '\0' };
+
+        const std::uint64_t FnvOffset = 14695981039346656037ull;
+        const std::uint64_t FnvPrime = 1099511628211ull;
+
+        std::uint64_t AlignUp(std::uint64_t value) {
+            return (value + BinaryMatrixAlignment - 1) / BinaryMatrixAlignment * BinaryMatrixAlignment;
+        }
+
+        std::uint64_t ChecksumUpdate(std::uint64_t hash, const void* data, std::size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            std::size_t words = size / sizeof(std::uint64_t);
+
+            for (std::size_t i = 0; i < words; i++) {
+                std::uint64_t word;
+                std::memcpy(&word, bytes + i * sizeof(std::uint64_t), sizeof(word));
+                hash = (hash ^ word) * FnvPrime;
+            }
+            for (std::size_t i = words * sizeof(std::uint64_t); i < size; i++) {
+                hash = (hash ^ bytes[i]) * FnvPrime;
+            }
+            return hash;
+        }
+
+        // Writes zero bytes until the stream position reaches the next aligned offset.
+        std::uint64_t WritePadding(std::ofstream& file, std::uint64_t position, std::uint64_t& hash) {
+            static const char zeros[BinaryMatrixAlignment] = {};
+            std::uint64_t padding = AlignUp(position) - position;
+            if (padding > 0) {
+                file.write(zeros, static_cast<std::streamsize>(padding));
+                hash = ChecksumUpdate(hash, zeros, static_cast<std::size_t>(padding));
+            }
+            return position + padding;
+        }
+
+        // Fills every header field except the checksum.
+        BinaryMatrixHeader HeaderFor(const std::vector<std::vector<double>>& A, const std::vector<double>& b) {
+            const std::uint64_t rows = A.size();
+            const std::uint64_t cols = A.empty() ? 0 : A[0].size();
+            for (const auto& row : A) {
+                if (row.size() != cols)
+                    throw std::invalid_argument("All matrix rows must have the same length.");
+            }
+
+            BinaryMatrixHeader header{};
+            std::memcpy(header.magic, BinaryMagic, sizeof(header.magic));
+            header.version = BinaryMatrixVersion;
+            header.dtype = BinaryDType::Float64;
+            header.layout = BinaryLayout::RowMajor;
+            header.alignment = static_cast<std::uint32_t>(BinaryMatrixAlignment);
+            header.rows = rows;
+            header.cols = cols;
+            header.vectorLength = b.size();
+            header.matrixOffset = sizeof(BinaryMatrixHeader);
+            header.vectorOffset = AlignUp(header.matrixOffset + rows * cols * sizeof(double));
+            return header;
+        }
+
+    } // namespace
+
+    std::uint64_t BinaryChecksum(const void* data, std::size_t size) {
+        return ChecksumUpdate(FnvOffset, data, size);
+    }
+
+    BinaryMatrixHeader MakeBinaryMatrixHeader(const std::vector<std::vector<double>>& A, const std::vector<double>& b)
+    {
+        static const char zeros[BinaryMatrixAlignment] = {};
+        BinaryMatrixHeader header = HeaderFor(A, b);
+
+        std::uint64_t hash = FnvOffset;
+        std::uint64_t matrixEnd = header.matrixOffset;
+        for (const auto& row : A) {
+            hash = ChecksumUpdate(hash, row.data(), row.size() * sizeof(double));
+            matrixEnd += row.size() * sizeof(double);
+        }
+        hash = ChecksumUpdate(hash, zeros, static_cast<std::size_t>(header.vectorOffset - matrixEnd));
+
+        std::uint64_t vectorEnd = header.vectorOffset + b.size() * sizeof(double);
+        hash = ChecksumUpdate(hash, b.data(), b.size() * sizeof(double));
+        hash = ChecksumUpdate(hash, zeros, static_cast<std::size_t>(AlignUp(vectorEnd) - vectorEnd));
+
+        header.checksum = hash;
+        return header;
+    }
+
+    void WriteBinaryMatrix(const std::string& target, const std::vector<std::vector<double>>& A, const std::vector<double>& b)
+    {
+        BinaryMatrixHeader header = HeaderFor(A, b);
+
+        std::ofstream file(target, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            throw std::runtime_error("Cannot open file for writing: " + target);
+
+        // The checksum is patched into the header once the payload has been streamed out.
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        std::uint64_t hash = FnvOffset;
+        std::uint64_t position = header.matrixOffset;
+        for (const auto& row : A) {
+            std::size_t bytes = row.size() * sizeof(double);
+            file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(bytes));
+            hash = ChecksumUpdate(hash, row.data(), bytes);
+            position += bytes;
+        }
+
+        position = WritePadding(file, position, hash);
+        std::size_t vectorBytes = b.size() * sizeof(double);
+        file.write(reinterpret_cast<const char*>(b.data()), static_cast<std::streamsize>(vectorBytes));
+        hash = ChecksumUpdate(hash, b.data(), vectorBytes);
+        WritePadding(file, position + vectorBytes, hash);
+
+        header.checksum = hash;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        if (!file)
+            throw std::runtime_error("Failed to write binary matrix file: " + target);
+    }
+
+    void ConvertTextToBinary(const std::string& source, const std::string& target)
+    {
+        std::vector<std::vector<double>> A;
+        std::vector<double> b;
+
+        ::LoadMatrix(source, A, b);
+        if (A.empty())
+            throw std::runtime_error("Cannot read text matrix file: " + source);
+
+        WriteBinaryMatrix(target, A, b);
+    }
+
+    MappedMatrix::MappedMatrix(const std::string& source, bool verifyChecksum)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(source.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Cannot open binary matrix file: " + source);
+        fileHandle = file;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) {
+            Release();
+            throw std::runtime_error("Cannot read size of binary matrix file: " + source);
+        }
+        size = static_cast<std::size_t>(fileSize.QuadPart);
+
+        if (size >= sizeof(BinaryMatrixHeader)) {
+            mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mappingHandle != nullptr)
+                base = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        }
+#else
+        int fd = open(source.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Cannot open binary matrix file: " + source);
+
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw std::runtime_error("Cannot read size of binary matrix file: " + source);
+        }
+        size = static_cast<std::size_t>(info.st_size);
+
+        if (size >= sizeof(BinaryMatrixHeader)) {
+            void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapped != MAP_FAILED)
+                base = static_cast<const unsigned char*>(mapped);
+        }
+        close(fd);
+#endif
+        if (base == nullptr) {
+            const bool truncated = size < sizeof(BinaryMatrixHeader);
+            Release();
+            if (truncated)
+                throw BinaryMatrixFormatError("Binary matrix file is too short: " + source);
+            throw std::runtime_error("Cannot map binary matrix file: " + source);
+        }
+
+        std::memcpy(&header, base, sizeof(header));
+
+        const std::uint64_t matrixBytes = header.rows * header.cols * sizeof(double);
+        bool valid = std::memcmp(header.magic, BinaryMagic, sizeof(header.magic)) == 0
+            && header.version >= 1 && header.version <= BinaryMatrixVersion
+            && header.dtype == BinaryDType::Float64
+            && (header.layout == BinaryLayout::RowMajor || header.layout == BinaryLayout::ColMajor)
+            && header.alignment == BinaryMatrixAlignment
+            && header.matrixOffset % BinaryMatrixAlignment == 0
+            && header.vectorOffset % BinaryMatrixAlignment == 0
+            && (header.cols == 0 || header.rows <= size / sizeof(double) / header.cols)
+            && header.vectorLength <= size / sizeof(double)
+            && header.matrixOffset >= sizeof(BinaryMatrixHeader)
+            // Offsets come from the file, so the bounds are checked in a form that cannot wrap around.
+            && header.matrixOffset <= header.vectorOffset
+            && matrixBytes <= header.vectorOffset - header.matrixOffset
+            && header.vectorOffset <= size
+            && header.vectorLength <= (size - header.vectorOffset) / sizeof(double);
+
+        if (!valid) {
+            Release();
+            throw BinaryMatrixFormatError("Invalid binary matrix header: " + source);
+        }
+
+        if (verifyChecksum && !VerifyChecksum()) {
+            Release();
+            throw BinaryMatrixFormatError("Binary matrix checksum mismatch: " + source);
+        }
+    }
+
+    MappedMatrix::~MappedMatrix()
+    {
+        Release();
+    }
+
+    MappedMatrix::MappedMatrix(MappedMatrix&& other) noexcept
+        : base(other.base), size(other.size), header(other.header)
+#ifdef _WIN32
+        , fileHandle(other.fileHandle), mappingHandle(other.mappingHandle)
+#endif
+    {
+        other.base = nullptr;
+        other.size = 0;
+#ifdef _WIN32
+        other.fileHandle = nullptr;
+        other.mappingHandle = nullptr;
+#endif
+    }
+
+    MappedMatrix& MappedMatrix::operator=(MappedMatrix&& other) noexcept
+    {
+        if (this != &other) {
+            Release();
+            std::swap(base, other.base);
+            std::swap(size, other.size);
+            header = other.header;
+#ifdef _WIN32
+            std::swap(fileHandle, other.fileHandle);
+            std::swap(mappingHandle, other.mappingHandle);
+#endif
+        }
+        return *this;
+    }
+
+    void MappedMatrix::Release()
+    {
+#ifdef _WIN32
+        if (base != nullptr)
+            UnmapViewOfFile(base);
+        if (mappingHandle != nullptr)
+            CloseHandle(mappingHandle);
+        if (fileHandle != nullptr)
+            CloseHandle(fileHandle);
+        fileHandle = nullptr;
+        mappingHandle = nullptr;
+#else
+        if (base != nullptr)
+            munmap(const_cast<unsigned char*>(base), size);
+#endif
+        base = nullptr;
+        size = 0;
+    }
+
+    MatrixView MappedMatrix::matrix() const
+    {
+        MatrixView view;
+        view.data = reinterpret_cast<const double*>(base + header.matrixOffset);
+        view.rows = rows();
+        view.cols = cols();
+        if (header.layout == BinaryLayout::RowMajor) {
+            view.rowStride = cols();
+            view.colStride = 1;
+        }
+        else {
+            view.rowStride = 1;
+            view.colStride = rows();
+        }
+        return view;
+    }
+
+    const double* MappedMatrix::vector() const
+    {
+        if (header.vectorLength == 0)
+            return nullptr;
+        return reinterpret_cast<const double*>(base + header.vectorOffset);
+    }
+
+    bool MappedMatrix::VerifyChecksum() const
+    {
+        return BinaryChecksum(base + header.matrixOffset, size - static_cast<std::size_t>(header.matrixOffset)) == header.checksum;
+    }
+
+    void LoadMatrixBinary(const std::string& source, std::vector<std::vector<double>>& A, std::vector<double>& B)
+    {
+        MappedMatrix mapped(source);
+
+        A = mapped.matrix().ToMatrix();
+        B.assign(mapped.vector(), mapped.vector() + mapped.vectorLength());
+    }
+
+} // namespace NumericLib
@@ -0,0 +1,379 @@
+#include "io/matrix_market.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace NumericLib {
+
+    namespace {
+
+        // Files smaller than this per thread are parsed by fewer threads.
+        const std::size_t MinChunkBytes = 1 << 16;
+
+        std::string ToLower(std::string text) {
+            std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return text;
+        }
+
+        const char* SkipBlanks(const char* p, const char* end) {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+            return p;
+        }
+
+        bool ParseIndex(const char*& p, const char* end, std::size_t& value) {
+            p = SkipBlanks(p, end);
+            unsigned long long parsed = 0;
+            auto result = std::from_chars(p, end, parsed);
+            if (result.ec != std::errc()) return false;
+            p = result.ptr;
+            value = static_cast<std::size_t>(parsed);
+            return true;
+        }
+
+        bool ParseValue(const char*& p, const char* end, double& value) {
+            p = SkipBlanks(p, end);
+            if (p < end && *p == '+') p++;
+            auto result = std::from_chars(p, end, value);
+            if (result.ec != std::errc()) return false;
+            p = result.ptr;
+            return true;
+        }
+
+        // Calls fn(begin, end) for every line in [begin, end) that is neither blank nor a comment.
+        template <typename Func>
+        void ForEachLine(const char* begin, const char* end, Func fn) {
+            while (begin < end) {
+                const char* lineEnd = std::find(begin, end, '\n');
+                const char* first = SkipBlanks(begin, lineEnd);
+                if (first < lineEnd && *first != '%') {
+                    fn(first, lineEnd);
+                }
+                begin = lineEnd < end ? lineEnd + 1 : end;
+            }
+        }
+
+        // Parses the banner, comments and size line; returns the position of the first data line.
+        const char* ParseHeader(const char* begin, const char* end, MatrixMarketInfo& info) {
+            const char* lineEnd = std::find(begin, end, '\n');
+            std::istringstream banner(ToLower(std::string(begin, lineEnd)));
+            std::string tag, object, format, field, symmetry;
+            banner >> tag >> object >> format >> field >> symmetry;
+
+            if (tag != "%%matrixmarket" || object != "matrix")
+                throw std::runtime_error("Missing %%MatrixMarket matrix banner.");
+
+            if (format == "coordinate") info.format = MatrixMarketFormat::Coordinate;
+            else if (format == "array") info.format = MatrixMarketFormat::Array;
+            else throw std::runtime_error("Unsupported Matrix Market format: " + format);
+
+            if (field != "real" && field != "integer" && field != "double")
+                throw std::runtime_error("Unsupported Matrix Market field: " + field);
+
+            if (symmetry == "general") info.symmetry = MatrixMarketSymmetry::General;
+            else if (symmetry == "symmetric") info.symmetry = MatrixMarketSymmetry::Symmetric;
+            else throw std::runtime_error("Unsupported Matrix Market symmetry: " + symmetry);
+
+            const char* p = lineEnd < end ? lineEnd + 1 : end;
+            while (p < end) {
+                lineEnd = std::find(p, end, '\n');
+                const char* first = SkipBlanks(p, lineEnd);
+                const char* next = lineEnd < end ? lineEnd + 1 : end;
+                if (first < lineEnd && *first != '%') {
+                    bool valid = ParseIndex(first, lineEnd, info.rows) && ParseIndex(first, lineEnd, info.cols);
+                    if (info.format == MatrixMarketFormat::Coordinate) {
+                        valid = valid && ParseIndex(first, lineEnd, info.entries);
+                    }
+                    else if (info.symmetry == MatrixMarketSymmetry::Symmetric) {
+                        info.entries = info.rows * (info.rows + 1) / 2;
+                    }
+                    else {
+                        info.entries = info.rows * info.cols;
+                    }
+                    if (!valid)
+                        throw std::runtime_error("Malformed Matrix Market size line.");
+                    if (info.symmetry == MatrixMarketSymmetry::Symmetric && info.rows != info.cols)
+                        throw std::runtime_error("Symmetric Matrix Market matrix must be square.");
+                    return next;
+                }
+                p = next;
+            }
+            throw std::runtime_error("Missing Matrix Market size line.");
+        }
+
+        std::string ReadFile(const std::string& source) {
+            std::ifstream file(source, std::ios::binary | std::ios::ate);
+            if (!file.is_open())
+                throw std::runtime_error("Cannot open Matrix Market file: " + source);
+
+            std::string text(static_cast<std::size_t>(file.tellg()), '\0');
+            file.seekg(0);
+            file.read(&text[0], static_cast<std::streamsize>(text.size()));
+            return text;
+        }
+
+        // Splits [begin, end) into line-aligned chunks, one per parser thread.
+        std::vector<const char*> SplitChunks(const char* begin, const char* end, unsigned threads) {
+            std::size_t length = static_cast<std::size_t>(end - begin);
+            std::size_t chunks = std::max<std::size_t>(1, std::min<std::size_t>(threads == 0 ? parallel::DefaultThreadCount() : threads, length / MinChunkBytes));
+
+            std::vector<const char*> bounds(chunks + 1, end);
+            bounds[0] = begin;
+            for (std::size_t c = 1; c < chunks; c++) {
+                const char* p = std::max(bounds[c - 1], begin + length * c / chunks);
+                p = std::find(p, end, '\n');
+                bounds[c] = p < end ? p + 1 : end;
+            }
+            return bounds;
+        }
+
+        void ParseEntry(const char* p, const char* end, const MatrixMarketInfo& info, std::size_t& i, std::size_t& j, double& value) {
+            if (!ParseIndex(p, end, i) || !ParseIndex(p, end, j) || !ParseValue(p, end, value) || SkipBlanks(p, end) != end)
+                throw std::runtime_error("Malformed Matrix Market entry.");
+            if (i == 0 || j == 0 || i > info.rows || j > info.cols)
+                throw std::runtime_error("Matrix Market entry index out of range.");
+            i--;
+            j--;
+        }
+
+        void CheckEntryCount(const std::vector<std::size_t>& counts, std::size_t expected) {
+            std::size_t total = 0;
+            for (std::size_t count : counts) total += count;
+            if (total != expected)
+                throw std::runtime_error("Number of Matrix Market entries does not match the size line.");
+        }
+
+        void SortRow(std::vector<std::size_t>& colIdx, std::vector<double>& values, std::size_t begin, std::size_t end) {
+            if (std::is_sorted(colIdx.begin() + begin, colIdx.begin() + end)) return;
+
+            std::vector<std::pair<std::size_t, double>> row(end - begin);
+            for (std::size_t k = begin; k < end; k++) row[k - begin] = { colIdx[k], values[k] };
+            std::sort(row.begin(), row.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+            for (std::size_t k = begin; k < end; k++) {
+                colIdx[k] = row[k - begin].first;
+                values[k] = row[k - begin].second;
+            }
+        }
+
+        // Parses the coordinate entries after the size line into CSR storage. Entries are counted per row into one shared
+        // array of atomic counters, which become the row offsets and then the write cursors, so the memory does not grow
+        // with the number of threads. Duplicate entries are kept; their order within a row depends on the scheduling.
+        CsrMatrix ParseCoordinate(const char* body, const char* end, const MatrixMarketInfo& info, unsigned threads) {
+            const bool symmetric = info.symmetry == MatrixMarketSymmetry::Symmetric;
+            const std::vector<const char*> bounds = SplitChunks(body, end, threads);
+            const std::size_t chunks = bounds.size() - 1;
+
+            // Pass 1: count the entries of every row.
+            std::vector<std::atomic<std::size_t>> rowCursors(info.rows);
+            std::vector<std::size_t> entryCounts(chunks, 0);
+            parallel::RunChunks(chunks, [&](std::size_t c) {
+                ForEachLine(bounds[c], bounds[c + 1], [&](const char* p, const char* lineEnd) {
+                    std::size_t i, j;
+                    double value;
+                    ParseEntry(p, lineEnd, info, i, j, value);
+                    rowCursors[i].fetch_add(1, std::memory_order_relaxed);
+                    if (symmetric && i != j) rowCursors[j].fetch_add(1, std::memory_order_relaxed);
+                    entryCounts[c]++;
+                    });
+                });
+            CheckEntryCount(entryCounts, info.entries);
+
+            // Prefix sum of the counts into the row offsets, which also start the write cursors.
+            CsrMatrix A;
+            A.rows = info.rows;
+            A.cols = info.cols;
+            A.rowPtr.assign(info.rows + 1, 0);
+            for (std::size_t r = 0; r < info.rows; r++) {
+                A.rowPtr[r + 1] = A.rowPtr[r] + rowCursors[r].load(std::memory_order_relaxed);
+                rowCursors[r].store(A.rowPtr[r], std::memory_order_relaxed);
+            }
+            A.colIdx.resize(A.rowPtr[info.rows]);
+            A.values.resize(A.rowPtr[info.rows]);
+
+            // Pass 2: every chunk claims CSR slots from the row cursors and writes its entries into them.
+            parallel::RunChunks(chunks, [&](std::size_t c) {
+                ForEachLine(bounds[c], bounds[c + 1], [&](const char* p, const char* lineEnd) {
+                    std::size_t i, j;
+                    double value;
+                    ParseEntry(p, lineEnd, info, i, j, value);
+                    std::size_t k = rowCursors[i].fetch_add(1, std::memory_order_relaxed);
+                    A.colIdx[k] = j;
+                    A.values[k] = value;
+                    if (symmetric && i != j) {
+                        k = rowCursors[j].fetch_add(1, std::memory_order_relaxed);
+                        A.colIdx[k] = i;
+                        A.values[k] = value;
+                    }
+                    });
+                });
+
+            parallel::RunChunks(chunks, [&](std::size_t c) {
+                for (std::size_t r = info.rows * c / chunks; r < info.rows * (c + 1) / chunks; r++) {
+                    SortRow(A.colIdx, A.values, A.rowPtr[r], A.rowPtr[r + 1]);
+                }
+                });
+
+            return A;
+        }
+
+    } // namespace
+
+    MatrixMarketInfo ReadMatrixMarketInfo(const std::string& source)
+    {
+        std::ifstream file(source);
+        if (!file.is_open())
+            throw std::runtime_error("Cannot open Matrix Market file: " + source);
+
+        std::string header, line;
+        while (std::getline(file, line)) {
+            header += line;
+            header += '\n';
+            const char* first = SkipBlanks(line.data(), line.data() + line.size());
+            if (first < line.data() + line.size() && *first != '%') break;
+        }
+
+        MatrixMarketInfo info;
+        ParseHeader(header.data(), header.data() + header.size(), info);
+        return info;
+    }
+
+    CsrMatrix ReadMatrixMarketSparse(const std::string& source, unsigned threads)
+    {
+        const std::string text = ReadFile(source);
+        const char* end = text.data() + text.size();
+
+        MatrixMarketInfo info;
+        const char* body = ParseHeader(text.data(), end, info);
+        if (info.format != MatrixMarketFormat::Coordinate)
+            throw std::runtime_error("Sparse reader requires a coordinate Matrix Market file.");
+
+        return ParseCoordinate(body, end, info, threads);
+    }
+
+    std::vector<std::vector<double>> ReadMatrixMarketDense(const std::string& source, unsigned threads)
+    {
+        const std::string text = ReadFile(source);
+        const char* end = text.data() + text.size();
+
+        MatrixMarketInfo info;
+        const char* body = ParseHeader(text.data(), end, info);
+
+        // Coordinate entries may repeat a position, and two chunks may write the same one; going through CSR sums
+        // duplicates the same way CsrMatrix::ToDense does, without racing on the dense storage.
+        if (info.format == MatrixMarketFormat::Coordinate) {
+            return ParseCoordinate(body, end, info, threads).ToDense();
+        }
+
+        const bool symmetric = info.symmetry == MatrixMarketSymmetry::Symmetric;
+        const std::vector<const char*> bounds = SplitChunks(body, end, threads);
+        const std::size_t chunks = bounds.size() - 1;
+
+        std::vector<std::vector<double>> A(info.rows, std::vector<double>(info.cols, 0.0));
+        std::vector<std::size_t> entryCounts(chunks, 0);
+
+        // Array entries are positional, so every chunk first needs to know where its values start.
+        parallel::RunChunks(chunks, [&](std::size_t c) {
+            ForEachLine(bounds[c], bounds[c + 1], [&](const char*, const char*) { entryCounts[c]++; });
+            });
+        CheckEntryCount(entryCounts, info.entries);
+
+        std::vector<std::size_t> starts(chunks, 0);
+        for (std::size_t c = 1; c < chunks; c++) starts[c] = starts[c - 1] + entryCounts[c - 1];
+
+        parallel::RunChunks(chunks, [&](std::size_t c) {
+            // Column-major position of the first value in this chunk; symmetric files store only the lower triangle.
+            std::size_t k = starts[c], i, j = 0;
+            if (symmetric) {
+                while (j < info.rows && k >= info.rows - j) {
+                    k -= info.rows - j;
+                    j++;
+                }
+                i = j + k;
+            }
+            else {
+                j = info.rows == 0 ? 0 : k / info.rows;
+                i = info.rows == 0 ? 0 : k % info.rows;
+            }
+
+            ForEachLine(bounds[c], bounds[c + 1], [&](const char* p, const char* lineEnd) {
+                double value;
+                if (!ParseValue(p, lineEnd, value))
+                    throw std::runtime_error("Malformed Matrix Market entry.");
+                A[i][j] = value;
+                if (symmetric) A[j][i] = value;
+                if (++i == info.rows) {
+                    j++;
+                    i = symmetric ? j : 0;
+                }
+                });
+            });
+
+        return A;
+    }
+
+    void WriteMatrixMarket(const std::string& target, const std::vector<std::vector<double>>& A, MatrixMarketSymmetry symmetry)
+    {
+        const std::size_t rows = A.size();
+        const std::size_t cols = A.empty() ? 0 : A[0].size();
+        for (const auto& row : A) {
+            if (row.size() != cols)
+                throw std::invalid_argument("All matrix rows must have the same length.");
+        }
+        const bool symmetric = symmetry == MatrixMarketSymmetry::Symmetric;
+        if (symmetric && rows != cols)
+            throw std::invalid_argument("Symmetric matrix must be square.");
+
+        std::ofstream file(target);
+        if (!file.is_open())
+            throw std::runtime_error("Cannot open file for writing: " + target);
+
+        file << "%%MatrixMarket matrix array real " << (symmetric ? "symmetric" : "general") << '\n';
+        file << rows << ' ' << cols << '\n';
+        file << std::setprecision(17);
+        for (std::size_t j = 0; j < cols; j++) {
+            for (std::size_t i = symmetric ? j : 0; i < rows; i++) {
+                file << A[i][j] << '\n';
+            }
+        }
+
+        if (!file)
+            throw std::runtime_error("Failed to write Matrix Market file: " + target);
+    }
+
+    void WriteMatrixMarket(const std::string& target, const CsrMatrix& A, MatrixMarketSymmetry symmetry)
+    {
+        const bool symmetric = symmetry == MatrixMarketSymmetry::Symmetric;
+        if (symmetric && A.rows != A.cols)
+            throw std::invalid_argument("Symmetric matrix must be square.");
+
+        std::size_t entries = 0;
+        for (std::size_t i = 0; i < A.rows; i++) {
+            for (std::size_t k = A.rowPtr[i]; k < A.rowPtr[i + 1]; k++) {
+                if (!symmetric || A.colIdx[k] <= i) entries++;
+            }
+        }
+
+        std::ofstream file(target);
+        if (!file.is_open())
+            throw std::runtime_error("Cannot open file for writing: " + target);
+
+        file << "%%MatrixMarket matrix coordinate real " << (symmetric ? "symmetric" : "general") << '\n';
+        file << A.rows << ' ' << A.cols << ' ' << entries << '\n';
+        file << std::setprecision(17);
+        for (std::size_t i = 0; i < A.rows; i++) {
+            for (std::size_t k = A.rowPtr[i]; k < A.rowPtr[i + 1]; k++) {
+                if (!symmetric || A.colIdx[k] <= i)
+                    file << i + 1 << ' ' << A.colIdx[k] + 1 << ' ' << A.values[k] << '\n';
+            }
+        }
+
+        if (!file)
+            throw std::runtime_error("Failed to write Matrix Market file: " + target);
+    }
+
+} // namespace NumericLib
@@ -0,0 +1,299 @@
+#include "io/matrix_writer.hpp"
+#include "io/binary_matrix.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace NumericLib {
+
+    namespace {
+
+        // Width of a column in the aligned text format.
+        const int AlignedWidth = 24;
+
+        char Separator(OutputFormat format) {
+            switch (format) {
+            case OutputFormat::Csv:
+                return ',';
+            case OutputFormat::Tsv:
+                return '\t';
+            default:
+                return ' ';
+            }
+        }
+
+        int Width(OutputFormat format) {
+            return format == OutputFormat::Aligned ? AlignedWidth : 0;
+        }
+
+        void WritePadding(BufferedWriter& out, std::size_t written) {
+            static const char zeros[BinaryMatrixAlignment] = {};
+            std::size_t padding = (BinaryMatrixAlignment - written % BinaryMatrixAlignment) % BinaryMatrixAlignment;
+            out.Write(zeros, padding);
+        }
+
+        void WriteBinary(BufferedWriter& out, const std::vector<std::vector<double>>& A, const std::vector<double>& b) {
+            BinaryMatrixHeader header = MakeBinaryMatrixHeader(A, b);
+            out.Write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            std::size_t written = 0;
+            for (const auto& row : A) {
+                out.Write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(double));
+                written += row.size() * sizeof(double);
+            }
+            WritePadding(out, written);
+            out.Write(reinterpret_cast<const char*>(b.data()), b.size() * sizeof(double));
+            WritePadding(out, b.size() * sizeof(double));
+        }
+
+    } // namespace
+
+    BufferedWriter::BufferedWriter(int fileDescriptor, std::size_t bufferSize, bool useBackground) : fd(fileDescriptor)
+    {
+        Start(bufferSize, useBackground);
+    }
+
+    BufferedWriter::BufferedWriter(std::ostream& output, std::size_t bufferSize, bool useBackground) : stream(&output)
+    {
+        Start(bufferSize, useBackground);
+    }
+
+    BufferedWriter::BufferedWriter(const std::string& target, std::size_t bufferSize, bool useBackground)
+    {
+        auto file = std::make_unique<std::ofstream>(target, std::ios::binary | std::ios::trunc);
+        if (!file->is_open())
+            throw std::runtime_error("Cannot open file for writing: " + target);
+        ownedStream = std::move(file);
+        stream = ownedStream.get();
+        Start(bufferSize, useBackground);
+    }
+
+    BufferedWriter::~BufferedWriter()
+    {
+        try {
+            Flush();
+        }
+        catch (...) {
+        }
+
+        if (background) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            ready.notify_all();
+            worker.join();
+        }
+    }
+
+    void BufferedWriter::Start(std::size_t bufferSize, bool useBackground)
+    {
+        buffer.resize(std::max<std::size_t>(bufferSize, 64));
+        background = useBackground;
+        if (background) {
+            pending.resize(buffer.size());
+            worker = std::thread(&BufferedWriter::WorkerLoop, this);
+        }
+    }
+
+    void BufferedWriter::Sink(const char* data, std::size_t size)
+    {
+        if (stream != nullptr) {
+            stream->write(data, static_cast<std::streamsize>(size));
+            if (!*stream)
+                throw std::runtime_error("Failed to write to output stream.");
+            return;
+        }
+
+        while (size > 0) {
+#ifdef _WIN32
+            int chunk = static_cast<int>(std::min<std::size_t>(size, 1 << 30));
+            int result = _write(fd, data, static_cast<unsigned>(chunk));
+#else
+            ssize_t result = ::write(fd, data, size);
+#endif
+            if (result < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Failed to write to file descriptor.");
+            }
+            data += result;
+            size -= static_cast<std::size_t>(result);
+        }
+    }
+
+    void BufferedWriter::Submit()
+    {
+        if (used == 0) return;
+
+        if (!background) {
+            Sink(buffer.data(), used);
+            used = 0;
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this]() { return !hasPending; });
+        if (error) std::rethrow_exception(error);
+
+        std::swap(buffer, pending);
+        pendingSize = used;
+        hasPending = true;
+        used = 0;
+        lock.unlock();
+        ready.notify_all();
+    }
+
+    void BufferedWriter::WorkerLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            ready.wait(lock, [this]() { return hasPending || stopping; });
+            if (!hasPending) return;
+
+            lock.unlock();
+            std::exception_ptr failure;
+            try {
+                Sink(pending.data(), pendingSize);
+            }
+            catch (...) {
+                failure = std::current_exception();
+            }
+            lock.lock();
+
+            if (failure) error = failure;
+            hasPending = false;
+            ready.notify_all();
+        }
+    }
+
+    void BufferedWriter::Write(const char* data, std::size_t size)
+    {
+        while (size > 0) {
+            if (used == buffer.size()) Submit();
+            std::size_t chunk = std::min(size, buffer.size() - used);
+            std::memcpy(buffer.data() + used, data, chunk);
+            used += chunk;
+            data += chunk;
+            size -= chunk;
+        }
+    }
+
+    void BufferedWriter::WriteNumber(double value, int width)
+    {
+        char text[64];
+        std::to_chars_result result = precision > 0
+            ? std::to_chars(text, text + sizeof(text), value, std::chars_format::general, precision)
+            : std::to_chars(text, text + sizeof(text), value);
+
+        std::size_t length = static_cast<std::size_t>(result.ptr - text);
+        for (std::size_t i = length; i < static_cast<std::size_t>(std::max(width, 0)); i++) Put(' ');
+        Write(text, length);
+    }
+
+    void BufferedWriter::WriteNumber(std::size_t value, int width)
+    {
+        char text[32];
+        std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+
+        std::size_t length = static_cast<std::size_t>(result.ptr - text);
+        for (std::size_t i = length; i < static_cast<std::size_t>(std::max(width, 0)); i++) Put(' ');
+        Write(text, length);
+    }
+
+    void BufferedWriter::Flush()
+    {
+        Submit();
+
+        if (background) {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this]() { return !hasPending; });
+            if (error) std::rethrow_exception(error);
+        }
+        if (stream != nullptr) stream->flush();
+    }
+
+    void WriteMatrix(BufferedWriter& out, const std::vector<std::vector<double>>& A, OutputFormat format)
+    {
+        if (format == OutputFormat::Binary) {
+            WriteBinary(out, A, {});
+            return;
+        }
+
+        const char separator = Separator(format);
+        const int width = Width(format);
+        for (const auto& row : A) {
+            for (std::size_t j = 0; j < row.size(); j++) {
+                if (j > 0) out.Put(separator);
+                out.WriteNumber(row[j], width);
+            }
+            out.Put('\n');
+        }
+    }
+
+    void WriteMatrix(BufferedWriter& out, const std::vector<std::vector<double>>& A, const std::vector<double>& b, OutputFormat format)
+    {
+        if (b.size() != A.size())
+            throw std::invalid_argument("Vector b must have one element per matrix row.");
+
+        if (format == OutputFormat::Binary) {
+            WriteBinary(out, A, b);
+            return;
+        }
+
+        const char separator = Separator(format);
+        const int width = Width(format);
+        for (std::size_t i = 0; i < A.size(); i++) {
+            for (std::size_t j = 0; j < A[i].size(); j++) {
+                if (j > 0) out.Put(separator);
+                out.WriteNumber(A[i][j], width);
+            }
+            if (format == OutputFormat::Aligned) out.Write(" |");
+            if (!A[i].empty() || format == OutputFormat::Aligned) out.Put(separator);
+            out.WriteNumber(b[i], width);
+            out.Put('\n');
+        }
+    }
+
+    void WriteVector(BufferedWriter& out, const std::vector<double>& x, OutputFormat format)
+    {
+        if (format == OutputFormat::Binary) {
+            WriteBinary(out, {}, x);
+            return;
+        }
+
+        const int width = Width(format);
+        for (double value : x) {
+            out.WriteNumber(value, width);
+            out.Put('\n');
+        }
+    }
+
+    void WriteIterations(BufferedWriter& out, const std::vector<double>& values, double root, OutputFormat format)
+    {
+        if (format == OutputFormat::Binary)
+            throw std::invalid_argument("Iterations cannot be written in the binary matrix format.");
+
+        const char separator = Separator(format);
+        const int width = Width(format);
+        for (std::size_t i = 0; i < values.size(); i++) {
+            out.WriteNumber(i + 1, format == OutputFormat::Aligned ? 8 : 0);
+            out.Put(separator);
+            out.WriteNumber(values[i], width);
+            out.Put(separator);
+            out.WriteNumber(std::abs(values[i] - root), width);
+            out.Put('\n');
+        }
+    }
+
+} // namespace NumericLib
@@ -0,0 +1,545 @@
+#include "polynomial.hpp"
+#include "fft.hpp"
+#include "parallel.hpp"
+#include "interpolation/chebyshev.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <stdexcept>
+
+namespace NumericLib {
+
+    namespace {
+
+        std::vector<double> NaiveProduct(const std::vector<double>& a, const std::vector<double>& b)
+        {
+            std::vector<double> product(a.size() + b.size() - 1, 0.0);
+            for (std::size_t i = 0; i < a.size(); i++) {
+                for (std::size_t j = 0; j < b.size(); j++) {
+                    product[i + j] += a[i] * b[j];
+                }
+            }
+            return product;
+        }
+
+        std::vector<double> FFTProduct(const std::vector<double>& a, const std::vector<double>& b)
+        {
+            const std::size_t size = a.size() + b.size() - 1;
+            const std::size_t n = NextPowerOfTwo(size);
+            std::vector<std::complex<double>> fa(n), fb(n);
+            for (std::size_t i = 0; i < a.size(); i++) fa[i] = a[i];
+            for (std::size_t i = 0; i < b.size(); i++) fb[i] = b[i];
+            FFT(fa);
+            FFT(fb);
+            for (std::size_t i = 0; i < n; i++) fa[i] *= fb[i];
+            FFT(fa, true);
+
+            std::vector<double> product(size);
+            for (std::size_t i = 0; i < size; i++) product[i] = fa[i].real();
+            return product;
+        }
+
+        std::vector<double> Product(const std::vector<double>& a, const std::vector<double>& b)
+        {
+            if (std::min(a.size(), b.size()) - 1 > PolynomialFFTThreshold) return FFTProduct(a, b);
+            return NaiveProduct(a, b);
+        }
+
+        // Power series g with h g = 1 mod x^n, by the Newton iteration g <- g (2 - h g), doubling the precision each step.
+        std::vector<double> InverseSeries(const std::vector<double>& h, std::size_t n)
+        {
+            std::vector<double> g = { 1.0 / h[0] };
+            for (std::size_t k = 1; k < n; ) {
+                const std::size_t next = std::min(2 * k, n);
+                std::vector<double> e = Product(std::vector<double>(h.begin(), h.begin() + std::min(next, h.size())), g);
+                e.resize(next, 0.0);
+                for (double& value : e) value = -value;
+                e[0] += 2.0;
+                g = Product(g, e);
+                g.resize(next, 0.0);
+                k = next;
+            }
+            return g;
+        }
+
+        // Subproduct tree: levels[0] holds prod (x - x_i) over blocks of SubproductLeafSize points, every higher level the
+        // products of pairs of nodes below it.
+        struct SubproductTree {
+            std::vector<std::vector<Polynomial>> levels;
+        };
+
+        SubproductTree BuildTree(const std::vector<double>& x)
+        {
+            SubproductTree tree;
+            tree.levels.emplace_back();
+            for (std::size_t start = 0; start < x.size(); start += SubproductLeafSize) {
+                std::vector<double> leaf = { 1.0 };
+                for (std::size_t i = start; i < std::min(x.size(), start + SubproductLeafSize); i++) {
+                    leaf = NaiveProduct(leaf, { -x[i], 1.0 });
+                }
+                tree.levels[0].emplace_back(std::move(leaf));
+            }
+            while (tree.levels.back().size() > 1) {
+                const std::vector<Polynomial>& below = tree.levels.back();
+                std::vector<Polynomial> level;
+                for (std::size_t j = 0; j < below.size(); j += 2) {
+                    level.push_back(j + 1 < below.size() ? below[j] * below[j + 1] : below[j]);
+                }
+                tree.levels.push_back(std::move(level));
+            }
+            return tree;
+        }
+
+        std::vector<double> EvaluateWithTree(const Polynomial& p, const SubproductTree& tree, const std::vector<double>& x)
+        {
+            // Remainders modulo the nodes, from the root down to the leaves.
+            std::vector<Polynomial> remainders = { p.DivMod(tree.levels.back()[0]).second };
+            for (std::size_t level = tree.levels.size() - 1; level-- > 0; ) {
+                std::vector<Polynomial> next;
+                for (std::size_t j = 0; j < tree.levels[level].size(); j++) {
+                    next.push_back(remainders[j / 2].DivMod(tree.levels[level][j]).second);
+                }
+                remainders.swap(next);
+            }
+
+            std::vector<double> values(x.size());
+            for (std::size_t leaf = 0; leaf < remainders.size(); leaf++) {
+                const std::size_t start = leaf * SubproductLeafSize;
+                const std::size_t count = std::min(x.size() - start, SubproductLeafSize);
+                remainders[leaf].Evaluate(x.data() + start, values.data() + start, count);
+            }
+            return values;
+        }
+
+        // Chebyshev series sum c_k T_k(t) from here on. T_i T_j = (T_(i+j) + T_|i-j|) / 2, so a product is half the
+        // convolution of the coefficients plus half their correlation, folded onto |i - j|.
+        std::vector<double> ChebyshevProduct(const std::vector<double>& a, const std::vector<double>& b)
+        {
+            std::vector<double> product = Product(a, b);
+            for (double& value : product) value /= 2.0;
+
+            // correlation[i - j + offset] collects a_i b_j
+            const std::vector<double> correlation = Product(a, std::vector<double>(b.rbegin(), b.rend()));
+            const std::size_t offset = b.size() - 1;
+            for (std::size_t k = 0; k < correlation.size(); k++) {
+                product[k >= offset ? k - offset : offset - k] += correlation[k] / 2.0;
+            }
+            return product;
+        }
+
+        // Remainder of f modulo g of degree m >= 1, with m coefficients. With t = (z + 1/z) / 2, T_k = (z^k + z^-k) / 2
+        // and z^n f = z^(n-m) q z^m g + z^n r is an identity of ordinary polynomials in z whose top n - m + 1
+        // coefficients involve neither r nor the lower half of z^(n-m) q, so large divisions get the quotient by
+        // a reversed power series division as in DivMod.
+        std::vector<double> ChebyshevRemainder(std::vector<double> f, const std::vector<double>& g)
+        {
+            const std::size_t m = g.size() - 1;
+            if (f.size() <= m) return f;
+
+            const std::size_t n = f.size() - 1, count = n - m + 1;
+            if (std::min(m, count) > PolynomialFFTThreshold) {
+                // top[j] and divisor[i] are the coefficients of z^(2n - j) in z^n f and of z^(2m - i) in z^m g.
+                std::vector<double> top(count), divisor(std::min(count, 2 * m + 1));
+                for (std::size_t j = 0; j < count; j++) top[j] = f[n - j] / 2.0;
+                for (std::size_t i = 0; i < divisor.size(); i++) divisor[i] = i == m ? g[0] : g[i < m ? m - i : i - m] / 2.0;
+                const std::vector<double> reversed = Product(top, InverseSeries(divisor, count));
+
+                std::vector<double> quotient(count);
+                quotient[0] = reversed[count - 1];
+                for (std::size_t e = 1; e < count; e++) quotient[e] = 2.0 * reversed[count - 1 - e];
+                const std::vector<double> multiple = ChebyshevProduct(quotient, g);
+                for (std::size_t k = 0; k < m; k++) f[k] -= multiple[k];
+            } else {
+                for (std::size_t k = n; k >= m; k--) {
+                    // q T_(k-m) g removes f_k T_k: its top coefficient is q g_m / 2, or q g_m for k = m.
+                    const std::size_t j = k - m;
+                    const double q = (j == 0 ? 1.0 : 2.0) * f[k] / g[m];
+                    for (std::size_t i = 0; i <= m; i++) {
+                        if (j == 0) {
+                            f[i] -= q * g[i];
+                        } else {
+                            f[i + j] -= q * g[i] / 2.0;
+                            f[i > j ? i - j : j - i] -= q * g[i] / 2.0;
+                        }
+                    }
+                }
+            }
+            f.resize(m);
+            return f;
+        }
+
+        // Subproduct tree of points t_i in [-1, 1] in the Chebyshev basis, with nodes prod 2 (t - t_i). A node stays of
+        // the size of 2 T_k only if its points spread over the whole interval, so the sorted points are interleaved:
+        // the left child of a node takes every other point of it and the right child the rest, and each node covers
+        // a contiguous range of t. levels[0] holds the leaves of at most SubproductLeafSize points, which start at
+        // starts[leaf]; index[k] is the position of t[k] among the original points.
+        struct ChebyshevTree {
+            std::vector<double> t;
+            std::vector<std::size_t> index;
+            std::vector<std::size_t> starts;
+            std::vector<std::vector<std::vector<double>>> levels;
+        };
+
+        void Interleave(std::vector<std::size_t>& order, std::size_t start, std::size_t count)
+        {
+            if (count <= 2) return;
+            const std::vector<std::size_t> block(order.begin() + start, order.begin() + start + count);
+            const std::size_t half = (count + 1) / 2;
+            for (std::size_t k = 0; k < count; k++) order[start + (k % 2 == 0 ? k / 2 : half + k / 2)] = block[k];
+            Interleave(order, start, half);
+            Interleave(order, start + half, count - half);
+        }
+
+        // Tree of the points x mapped from [a, b] to [-1, 1].
+        ChebyshevTree BuildChebyshevTree(const std::vector<double>& x, double a, double b)
+        {
+            ChebyshevTree tree;
+            tree.index.resize(x.size());
+            std::iota(tree.index.begin(), tree.index.end(), std::size_t(0));
+            std::sort(tree.index.begin(), tree.index.end(), [&](std::size_t i, std::size_t j) { return x[i] < x[j]; });
+            Interleave(tree.index, 0, x.size());
+            for (std::size_t i : tree.index) tree.t.push_back((2.0 * x[i] - a - b) / (b - a));
+
+            // Blocks are halved, the left half taking the extra point of an odd block, until none is larger than a leaf.
+            tree.starts = { 0, x.size() };
+            for (std::size_t largest = x.size(); largest > SubproductLeafSize; largest = (largest + 1) / 2) {
+                std::vector<std::size_t> starts;
+                for (std::size_t j = 0; j + 1 < tree.starts.size(); j++) {
+                    starts.push_back(tree.starts[j]);
+                    starts.push_back(tree.starts[j] + (tree.starts[j + 1] - tree.starts[j] + 1) / 2);
+                }
+                starts.push_back(x.size());
+                tree.starts.swap(starts);
+            }
+
+            tree.levels.emplace_back();
+            for (std::size_t leaf = 0; leaf + 1 < tree.starts.size(); leaf++) {
+                std::vector<double> node = { 1.0 };
+                for (std::size_t k = tree.starts[leaf]; k < tree.starts[leaf + 1]; k++) {
+                    node = ChebyshevProduct(node, { -2.0 * tree.t[k], 2.0 });
+                }
+                tree.levels[0].push_back(std::move(node));
+            }
+            while (tree.levels.back().size() > 1) {
+                const std::vector<std::vector<double>>& below = tree.levels.back();
+                std::vector<std::vector<double>> level;
+                for (std::size_t j = 0; j < below.size(); j += 2) {
+                    level.push_back(ChebyshevProduct(below[j], below[j + 1]));
+                }
+                tree.levels.push_back(std::move(level));
+            }
+            return tree;
+        }
+
+        // Values of the series f at the points of the tree, in its order, by remainders modulo the nodes.
+        std::vector<double> EvaluateWithChebyshevTree(const std::vector<double>& f, const ChebyshevTree& tree)
+        {
+            std::vector<std::vector<double>> remainders = { ChebyshevRemainder(f, tree.levels.back()[0]) };
+            for (std::size_t level = tree.levels.size() - 1; level-- > 0; ) {
+                std::vector<std::vector<double>> next;
+                for (std::size_t j = 0; j < tree.levels[level].size(); j++) {
+                    next.push_back(ChebyshevRemainder(remainders[j / 2], tree.levels[level][j]));
+                }
+                remainders.swap(next);
+            }
+
+            std::vector<double> values(tree.t.size());
+            for (std::size_t leaf = 0; leaf < remainders.size(); leaf++) {
+                const std::size_t start = tree.starts[leaf], count = tree.starts[leaf + 1] - start;
+                EvaluateChebyshevSeries(remainders[leaf], 1.0, 0.0, tree.t.data() + start, values.data() + start, count);
+            }
+            return values;
+        }
+
+        // Series sum c_k M(t) / (2 (t - t_k)) for the root M and c in the order of the tree.
+        std::vector<double> CombineWithChebyshevTree(const std::vector<double>& c, const ChebyshevTree& tree)
+        {
+            std::vector<std::vector<double>> sums;
+            for (std::size_t leaf = 0; leaf < tree.levels[0].size(); leaf++) {
+                const std::vector<double>& node = tree.levels[0][leaf];
+                const std::size_t m = node.size() - 1;
+                std::vector<double> sum(m, 0.0), q(m + 2, 0.0);
+                for (std::size_t k = tree.starts[leaf]; k < tree.starts[leaf + 1]; k++) {
+                    // node / 2 = (t - s) Q, by t T_j = (T_(j+1) + T_(j-1)) / 2 matched from the top coefficient down
+                    const double s = tree.t[k];
+                    for (std::size_t j = m; j >= 2; j--) q[j - 1] = node[j] + 2.0 * s * q[j] - q[j + 1];
+                    q[0] = node[1] / 2.0 + s * q[1] - q[2] / 2.0;
+                    for (std::size_t j = 0; j < m; j++) sum[j] += c[k] * q[j];
+                }
+                sums.push_back(std::move(sum));
+            }
+
+            // Internal nodes: left * M_right + right * M_left.
+            for (std::size_t level = 0; level + 1 < tree.levels.size(); level++) {
+                const std::vector<std::vector<double>>& nodes = tree.levels[level];
+                std::vector<std::vector<double>> next;
+                for (std::size_t j = 0; j < nodes.size(); j += 2) {
+                    std::vector<double> sum = ChebyshevProduct(sums[j], nodes[j + 1]);
+                    const std::vector<double> right = ChebyshevProduct(sums[j + 1], nodes[j]);
+                    sum.resize(std::max(sum.size(), right.size()), 0.0);
+                    for (std::size_t k = 0; k < right.size(); k++) sum[k] += right[k];
+                    next.push_back(std::move(sum));
+                }
+                sums.swap(next);
+            }
+            return sums[0];
+        }
+
+        // Monomial coefficients of sum c_k T_k(t), through T_(k+1) = 2 t T_k - T_(k-1).
+        Polynomial ChebyshevToMonomial(const std::vector<double>& c)
+        {
+            std::vector<double> sum(c.size(), 0.0), previous(c.size() + 1, 0.0), current(c.size() + 1, 0.0);
+            sum[0] = c[0];
+            previous[0] = 1.0;
+            current[1] = 1.0;
+            for (std::size_t k = 1; k < c.size(); k++) {
+                for (std::size_t i = 0; i <= k; i++) sum[i] += c[k] * current[i];
+                for (std::size_t i = 0; i <= k + 1 && i < previous.size(); i++) {
+                    previous[i] = (i > 0 ? 2.0 * current[i - 1] : 0.0) - previous[i];
+                }
+                previous.swap(current);
+            }
+            return Polynomial(std::move(sum));
+        }
+
+    } // namespace
+
+    Polynomial::Polynomial()
+        : coeffs(1, 0.0)
+    {
+    }
+
+    Polynomial::Polynomial(std::vector<double> coefficients)
+        : coeffs(std::move(coefficients))
+    {
+        Trim();
+    }
+
+    void Polynomial::Trim()
+    {
+        while (coeffs.size() > 1 && coeffs.back() == 0.0) coeffs.pop_back();
+        if (coeffs.empty()) coeffs.push_back(0.0);
+    }
+
+    Polynomial Polynomial::FromRoots(const std::vector<double>& roots)
+    {
+        if (roots.empty()) return Polynomial({ 1.0 });
+        return BuildTree(roots).levels.back()[0];
+    }
+
+    Polynomial Polynomial::Interpolate(const std::vector<double>& x, const std::vector<double>& y)
+    {
+        if (x.size() != y.size())
+            throw std::invalid_argument("Vectors x and y must have the same size.");
+        if (x.empty())
+            throw std::invalid_argument("At least one interpolation point is required.");
+        std::vector<double> sorted = x;
+        std::sort(sorted.begin(), sorted.end());
+        if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+            throw std::invalid_argument("Interpolation points must be distinct.");
+
+        const std::size_t n = x.size();
+        if (n == 1) return Polynomial({ y[0] });
+        double scale = 0.0;
+        for (double value : y) scale = std::max(scale, std::abs(value));
+        const double epsilon = std::numeric_limits<double>::epsilon();
+
+        // The interpolant q is a Chebyshev series in t = (2x - a - b) / (b - a) over [a, b] = [min x, max x], in the
+        // Lagrange form sum v_k w_k M(t) / (2 (t - t_k)) with the weights w_k = 2 / M'(t_k).
+        const double a = sorted.front(), b = sorted.back();
+        const ChebyshevTree tree = BuildChebyshevTree(x, a, b);
+        const std::vector<double> slopes = EvaluateWithChebyshevTree(ChebyshevDerivative(tree.levels.back()[0]), tree);
+
+        // The tree sums carry rounding errors that grow with the Lebesgue constant of the points, which iterative
+        // refinement removes: the residuals at the points are interpolated and added.
+        std::vector<double> q(1, 0.0), residual(n), c(n);
+        for (std::size_t k = 0; k < n; k++) residual[k] = y[tree.index[k]];
+        for (std::size_t step = 0; ; step++) {
+            for (std::size_t k = 0; k < n; k++) c[k] = 2.0 * residual[k] / slopes[k];
+            const std::vector<double> correction = CombineWithChebyshevTree(c, tree);
+            q.resize(std::max(q.size(), correction.size()), 0.0);
+            for (std::size_t k = 0; k < correction.size(); k++) q[k] += correction[k];
+            if (step == SubproductRefinementSteps) break;
+
+            const std::vector<double> values = EvaluateWithChebyshevTree(q, tree);
+            double largest = 0.0;
+            for (std::size_t k = 0; k < n; k++) {
+                residual[k] = y[tree.index[k]] - values[k];
+                largest = std::max(largest, std::abs(residual[k]));
+            }
+            if (largest <= n * epsilon * scale) break;
+        }
+
+        // Converting to monomials of x and evaluating them amplifies the rounding error of the coefficient of T_k by up
+        // to g^k, g = r + sqrt(r^2 + 1) with r = max |x| |dt/dx| + |t(0)| over the points. This error of the kept
+        // coefficients plus the size of the dropped ones estimates the error of the monomial form cut at each degree.
+        const double r = (2.0 * std::max(std::abs(a), std::abs(b)) + std::abs(a + b)) / (b - a);
+        const double g = r + std::sqrt(r * r + 1.0);
+        std::vector<double> tail(q.size() + 1, 0.0);
+        for (std::size_t k = q.size(); k-- > 0; ) tail[k] = tail[k + 1] + std::abs(q[k]);
+        std::vector<double> errors;
+        double amplified = 0.0, growth = 1.0;
+        for (std::size_t k = 0; k < q.size() && std::isfinite(growth); k++) {
+            amplified += std::abs(q[k]) * growth;
+            growth *= g;
+            errors.push_back(tail[k + 1] + epsilon * amplified);
+        }
+        const double best = *std::min_element(errors.begin(), errors.end());
+        if (!(best <= SubproductCheckTolerance * scale))
+            throw std::domain_error("Interpolant is too oscillatory for the monomial basis.");
+
+        // The lowest degree within twice the smallest error leaves out the rounding noise of the coefficients.
+        std::size_t degree = 0;
+        while (errors[degree] > 2.0 * best) degree++;
+        q.resize(degree + 1);
+
+        const Polynomial p = ChebyshevToMonomial(q).Compose(Polynomial({ -(a + b) / (b - a), 2.0 / (b - a) }));
+        const std::vector<double> values = p.Evaluate(x);
+        for (std::size_t i = 0; i < n; i++) {
+            if (!(std::abs(values[i] - y[i]) <= SubproductCheckTolerance * scale))
+                throw std::domain_error("Interpolant is too oscillatory for the monomial basis.");
+        }
+        return p;
+    }
+
+    double Polynomial::Evaluate(double x) const
+    {
+        const std::size_t n = coeffs.size() - 1;
+        const double x2 = x * x;
+        std::size_t top = n % 2 == 0 ? n : n - 1;
+        double even = coeffs[top];
+        double odd = n % 2 == 1 ? coeffs[n] : 0.0;
+        while (top >= 2) {
+            top -= 2;
+            even = even * x2 + coeffs[top];
+            odd = odd * x2 + coeffs[top + 1];
+        }
+        return even + x * odd;
+    }
+
+    void Polynomial::Evaluate(const double* x, double* y, std::size_t count) const
+    {
+        const std::size_t n = coeffs.size() - 1;
+        for (std::size_t start = 0; start < count; start += parallel::BlockSize) {
+            const std::size_t size = std::min(parallel::BlockSize, count - start);
+            const double* xs = x + start;
+            double* ys = y + start;
+            for (std::size_t i = 0; i < size; i++) ys[i] = coeffs[n];
+            for (std::size_t k = n; k-- > 0; ) {
+                const double c = coeffs[k];
+                for (std::size_t i = 0; i < size; i++) ys[i] = ys[i] * xs[i] + c;
+            }
+        }
+    }
+
+    std::vector<double> Polynomial::Evaluate(const std::vector<double>& x) const
+    {
+        std::vector<double> y(x.size());
+        Evaluate(x.data(), y.data(), x.size());
+        return y;
+    }
+
+    std::vector<double> Polynomial::EvaluateMultipoint(const std::vector<double>& x) const
+    {
+        // The tree only beats the batch Horner scheme at high degrees and only stays accurate for points close to 0,
+        // so it is chosen before anything is built.
+        double radius = 0.0;
+        for (double value : x) radius = std::max(radius, std::abs(value));
+        const std::size_t chunk = coeffs.size();
+        if (Degree() < SubproductMinDegree || !(chunk * radius <= SubproductMaxSpread)) return Evaluate(x);
+
+        // One tree per chunk of degree + 1 points, whose root reduces the polynomial by a single division.
+        std::vector<double> values(x.size());
+        for (std::size_t start = 0; start < x.size(); start += chunk) {
+            const std::vector<double> points(x.begin() + start, x.begin() + std::min(x.size(), start + chunk));
+            const std::vector<double> chunkValues = EvaluateWithTree(*this, BuildTree(points), points);
+            std::copy(chunkValues.begin(), chunkValues.end(), values.begin() + start);
+        }
+        return values;
+    }
+
+    Polynomial Polynomial::Derivative() const
+    {
+        if (coeffs.size() == 1) return Polynomial();
+        std::vector<double> d(coeffs.size() - 1);
+        for (std::size_t i = 1; i < coeffs.size(); i++) d[i - 1] = i * coeffs[i];
+        return Polynomial(std::move(d));
+    }
+
+    Polynomial Polynomial::Compose(const Polynomial& inner) const
+    {
+        Polynomial result({ coeffs.back() });
+        for (std::size_t k = coeffs.size() - 1; k-- > 0; ) {
+            result = result * inner + Polynomial({ coeffs[k] });
+        }
+        return result;
+    }
+
+    std::pair<Polynomial, Polynomial> Polynomial::DivMod(const Polynomial& divisor) const
+    {
+        const std::vector<double>& d = divisor.coeffs;
+        if (d.size() == 1 && d[0] == 0.0)
+            throw std::invalid_argument("Division by the zero polynomial.");
+
+        const std::size_t n = coeffs.size() - 1, m = d.size() - 1;
+        if (n < m) return { Polynomial(), *this };
+
+        std::vector<double> quotient(n - m + 1);
+        if (std::min(m, n - m + 1) > PolynomialFFTThreshold) {
+            // rev(q) = rev(f) / rev(d) mod x^(n - m + 1), where rev reverses the coefficients.
+            std::vector<double> reversedF(coeffs.rbegin(), coeffs.rend());
+            std::vector<double> reversedD(d.rbegin(), d.rend());
+            reversedF.resize(n - m + 1);
+            std::vector<double> reversedQ = Product(reversedF, InverseSeries(reversedD, n - m + 1));
+            reversedQ.resize(n - m + 1);
+            quotient.assign(reversedQ.rbegin(), reversedQ.rend());
+
+            std::vector<double> remainder = (*this - divisor * Polynomial(quotient)).coeffs;
+            remainder.resize(std::max<std::size_t>(m, 1), 0.0);
+            if (m == 0) remainder.assign(1, 0.0);
+            return { Polynomial(std::move(quotient)), Polynomial(std::move(remainder)) };
+        }
+
+        std::vector<double> remainder = coeffs;
+        for (std::size_t k = n - m + 1; k-- > 0; ) {
+            const double q = remainder[k + m] / d[m];
+            quotient[k] = q;
+            for (std::size_t j = 0; j <= m; j++) {
+                remainder[k + j] -= q * d[j];
+            }
+        }
+        remainder.resize(std::max<std::size_t>(m, 1));
+        if (m == 0) remainder.assign(1, 0.0);
+        return { Polynomial(std::move(quotient)), Polynomial(std::move(remainder)) };
+    }
+
+    Polynomial Polynomial::operator+(const Polynomial& other) const
+    {
+        std::vector<double> sum(std::max(coeffs.size(), other.coeffs.size()), 0.0);
+        for (std::size_t i = 0; i < sum.size(); i++) sum[i] = (*this)[i] + other[i];
+        return Polynomial(std::move(sum));
+    }
+
+    Polynomial Polynomial::operator-(const Polynomial& other) const
+    {
+        std::vector<double> difference(std::max(coeffs.size(), other.coeffs.size()), 0.0);
+        for (std::size_t i = 0; i < difference.size(); i++) difference[i] = (*this)[i] - other[i];
+        return Polynomial(std::move(difference));
+    }
+
+    Polynomial Polynomial::operator*(const Polynomial& other) const
+    {
+        return Polynomial(Product(coeffs, other.coeffs));
+    }
+
+    Polynomial Polynomial::operator*(double scalar) const
+    {
+        std::vector<double> scaled = coeffs;
+        for (double& c : scaled) c *= scalar;
+        return Polynomial(std::move(scaled));
+    }
+
+} // namespace NumericLib
@@ -13,7 +13,8 @@ namespace NumericLib {
         }
     }
 
-    double GetValueHorner(double x, std::vector<double>& ai, int n) {
+    double GetValueHorner(double x, const std::vector<double>& ai, int n) {
+        if (n < 0) n = static_cast<int>(ai.size()) - 1;
         double value = 0;
         for (int i = n; i >= 0; i--) {
             value = value * x + ai[i];
@@ -27,7 +28,7 @@ namespace NumericLib {
             for (int j = 0; j < n; j++) {
                 std::cout << std::setw(10) << A[i][j] << " ";
             }
-            std::cout << std::endl;
+            std::cout << '\n';
         }
         std::cout << std::endl;
     }
@@ -38,7 +39,7 @@ namespace NumericLib {
             for (int j = 0; j < n; j++) {
                 std::cout << std::setw(10) << A[i][j] << " ";
             }
-            std::cout << "| " << b[i] << std::endl;
+            std::cout << "| " << b[i] << '\n';
         }
         std::cout << std::endl;
     }
@@ -1,5 +1,15 @@
 #include "Test.h"
 #include "NumericLib.hpp"
+#include <algorithm>
+#include <atomic>
+#include <complex>
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numbers>
+#include <sstream>
 
 #define tol 0.01
 using namespace NumericLib;
@@ -180,4 +190,1085 @@ void RunTests() {
             ode::rungeKutta4Method(0, f, 1, 1, 1);
             }));
     }
+
+    {
+        UnitGroup binaryIO("Binary IO");
+
+        std::vector<std::vector<double>> A = { {2, 1, 0}, {1, 3, 1}, {0, 1, 4} };
+        std::vector<double> b = { 5, 7, 9 };
+        const std::string path = "numericlib_test.nlb";
+
+        WriteBinaryMatrix(path, A, b);
+        {
+            MappedMatrix mapped(path, true);
+            MatrixView view = mapped.matrix();
+            binaryIO.AddTest("Binary - Dimensions", mapped.rows() == 3 && mapped.cols() == 3 && mapped.vectorLength() == 3);
+            binaryIO.AddTest("Binary - Zero-copy view", view(1, 2) == 1.0 && view(2, 2) == 4.0 && mapped.vector()[2] == 9.0);
+            binaryIO.AddTest("Binary - Aligned payload", reinterpret_cast<std::uintptr_t>(view.data) % BinaryMatrixAlignment == 0);
+        }
+
+        std::vector<std::vector<double>> loadedA;
+        std::vector<double> loadedB;
+        LoadMatrixBinary(path, loadedA, loadedB);
+        binaryIO.AddTest("Binary - Load round trip", loadedA == A && loadedB == b);
+
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(sizeof(BinaryMatrixHeader));
+            double corrupted = 42.0;
+            file.write(reinterpret_cast<const char*>(&corrupted), sizeof(corrupted));
+        }
+        binaryIO.AddTest("Binary - Checksum mismatch", shouldThrowException([&]() {
+            MappedMatrix mapped(path, true);
+            }));
+
+        {
+            // A vector offset near 2^64 wraps vectorOffset + vectorLength * 8 around to a small value.
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            const std::uint64_t length = 16, wrapping = ~std::uint64_t(0) - BinaryMatrixAlignment + 1;
+            file.seekp(offsetof(BinaryMatrixHeader, vectorLength));
+            file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            file.seekp(offsetof(BinaryMatrixHeader, vectorOffset));
+            file.write(reinterpret_cast<const char*>(&wrapping), sizeof(wrapping));
+        }
+        binaryIO.AddTest("Binary - Wrapping offset", shouldThrowException([&]() {
+            MappedMatrix mapped(path, false);
+            }));
+        std::remove(path.c_str());
+
+        binaryIO.AddTest("Binary - Missing file", shouldThrowException([&]() {
+            MappedMatrix mapped("numericlib_missing.nlb");
+            }));
+    }
+
+    {
+        UnitGroup matrixMarket("Matrix Market");
+
+        const std::string path = "numericlib_test.mtx";
+        {
+            std::ofstream file(path);
+            file << "%%MatrixMarket matrix coordinate real symmetric\n% comment\n3 3 4\n1 1 4.0\n2 1 -1\n3 3 2.5e0\n3 2 +1\n";
+        }
+        CsrMatrix sparse = ReadMatrixMarketSparse(path, 2);
+        matrixMarket.AddTest("Matrix Market - Symmetric coordinate", sparse.nonZeros() == 6
+            && sparse.rowPtr == std::vector<size_t>{ 0, 2, 4, 6 } && sparse.colIdx == std::vector<size_t>{ 0, 1, 0, 2, 1, 2 });
+
+        std::vector<std::vector<double>> dense = ReadMatrixMarketDense(path);
+        matrixMarket.AddTest("Matrix Market - Dense from coordinate", dense == sparse.ToDense() && dense[1][2] == 1.0);
+
+        {
+            // Enough duplicate lines for several parser chunks, all adding to the same two positions.
+            std::ofstream file(path);
+            const std::size_t repeats = 20000;
+            file << "%%MatrixMarket matrix coordinate real general\n2 2 " << 2 * repeats << '\n';
+            for (std::size_t k = 0; k < repeats; k++) file << "1 2 0.5\n2 2 1\n";
+        }
+        std::vector<std::vector<double>> summed = ReadMatrixMarketDense(path, 4);
+        CsrMatrix duplicates = ReadMatrixMarketSparse(path, 4);
+        matrixMarket.AddTest("Matrix Market - Duplicates summed", summed[0][1] == 10000.0 && summed[1][1] == 20000.0
+            && summed == duplicates.ToDense() && duplicates.rowPtr == std::vector<size_t>{ 0, 20000, 40000 });
+
+        std::vector<std::vector<double>> A = { {1, 2}, {3, 4}, {5, 6} };
+        WriteMatrixMarket(path, A);
+        matrixMarket.AddTest("Matrix Market - Array round trip", ReadMatrixMarketDense(path, 4) == A);
+
+        WriteMatrixMarket(path, sparse, MatrixMarketSymmetry::Symmetric);
+        MatrixMarketInfo info = ReadMatrixMarketInfo(path);
+        matrixMarket.AddTest("Matrix Market - Coordinate writer", info.entries == 4 && ReadMatrixMarketDense(path) == dense);
+
+        {
+            std::ofstream file(path);
+            file << "%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1.0\n";
+        }
+        matrixMarket.AddTest("Matrix Market - Index out of range", shouldThrowException([&]() {
+            ReadMatrixMarketSparse(path);
+            }));
+
+        {
+            std::ofstream file(path);
+            file << "%%MatrixMarket matrix coordinate real general\n2 2 1\n1 2 3.0 junk\n";
+        }
+        matrixMarket.AddTest("Matrix Market - Trailing tokens rejected", shouldThrowException([&]() {
+            ReadMatrixMarketSparse(path);
+            }));
+        std::remove(path.c_str());
+    }
+
+    {
+        UnitGroup writer("Buffered Writer");
+
+        std::vector<std::vector<double>> A = { {1.5, -2}, {0.1, 1e20} };
+        std::vector<double> b = { 3, 4 };
+
+        std::ostringstream csv;
+        {
+            BufferedWriter out(csv, 64);
+            WriteMatrix(out, A, b);
+        }
+        writer.AddTest("Writer - CSV", csv.str() == "1.5,-2,3\n0.1,1e+20,4\n");
+
+        std::ostringstream tsv;
+        {
+            BufferedWriter out(tsv, 64, true);
+            for (int i = 0; i < 100; i++) WriteVector(out, b, OutputFormat::Tsv);
+        }
+        writer.AddTest("Writer - Background thread", tsv.str().size() == 400 && tsv.str().substr(0, 4) == "3\n4\n");
+
+        std::ostringstream iterations;
+        {
+            BufferedWriter out(iterations);
+            WriteIterations(out, { 1.5, 1.25 }, 1.0, OutputFormat::Tsv);
+        }
+        writer.AddTest("Writer - Iterations", iterations.str() == "1\t1.5\t0.5\n2\t1.25\t0.25\n");
+
+        const std::string path = "numericlib_test.nlb";
+        {
+            BufferedWriter out(path);
+            WriteMatrix(out, A, b, OutputFormat::Binary);
+        }
+        std::vector<std::vector<double>> loadedA;
+        std::vector<double> loadedB;
+        LoadMatrixBinary(path, loadedA, loadedB);
+        writer.AddTest("Writer - Binary format", loadedA == A && loadedB == b && MappedMatrix(path).VerifyChecksum());
+        std::remove(path.c_str());
+    }
+
+    {
+        UnitGroup cache("Artifact Cache");
+
+        const std::string dir = "numericlib_test_cache";
+        {
+            ArtifactCache artifacts(dir);
+            artifacts.Clear();
+
+            GaussLegendreRule rule = CachedGLRule(artifacts, 4);
+            GaussLegendreRule cached = CachedGLRule(artifacts, 4);
+            cache.AddTest("Cache - Quadrature rule", cached.nodes == getGLRule(4).nodes && cached.weights == rule.weights);
+
+            std::vector<std::vector<double>> A = { {4, 3}, {6, 3} };
+            std::vector<std::vector<double>> L, U, cachedL, cachedU;
+            std::vector<double> unused(2);
+            luDecomposition(A, L, U, unused);
+            CachedLuDecomposition(artifacts, A, cachedL, cachedU);
+            CachedLuDecomposition(artifacts, A, cachedL, cachedU);
+            cache.AddTest("Cache - LU factorization", cachedL == L && cachedU == U);
+
+            auto f = [](double x) { return std::sin(x); };
+            Approximation<decltype(f)> approx = CachedApproximation(artifacts, "sin", f, 2, { 0.0, 2.0 });
+            Approximation<decltype(f)> reloaded = CachedApproximation(artifacts, "sin", f, 2, { 0.0, 2.0 });
+            cache.AddTest("Cache - Approximation", reloaded.Coefficients() == approx.Coefficients()
+                && std::abs(reloaded(1.0) - std::sin(1.0)) < tol);
+        }
+        {
+            ArtifactCache small(dir, 1);
+            small.Store("first", {}, { 1.0 });
+            small.Store("second", {}, { 2.0 });
+            cache.AddTest("Cache - LRU eviction", !small.Find("first") && small.Find("second") && small.Find("second")->vector()[0] == 2.0);
+            small.Clear();
+            cache.AddTest("Cache - Clear", small.Size() == 0);
+        }
+        {
+            ArtifactCache artifacts(dir);
+            const std::string key = ArtifactKey("truncated");
+            artifacts.Store(key, {}, { 1.0 });
+            for (const auto& item : std::filesystem::directory_iterator(dir)) {
+                std::filesystem::resize_file(item.path(), 16);
+            }
+            cache.AddTest("Cache - Truncated artifact removed", !artifacts.Find(key) && artifacts.Size() == 0);
+            cache.AddTest("Cache - Versioned keys", key.rfind("truncated@v" + std::to_string(ArtifactFormatVersion) + ".", 0) == 0);
+        }
+        std::filesystem::remove_all(dir);
+    }
+
+    {
+        UnitGroup adaptive("Adaptive Integration");
+
+        auto peak = [](double x) { return 1.0 / (1e-4 + (x - 0.3) * (x - 0.3)); };
+        const double exact = 100.0 * (std::atan(70.0) + std::atan(30.0));
+
+        AdaptiveIntegrationResult res = gaussKronrodAdaptive(0.0, 1.0, peak, 1e-10, 1e-10);
+        adaptive.AddTest("Gauss-Kronrod - Sharp peak", res.converged && std::abs(res.value - exact) <= res.error);
+
+        res = gaussKronrodAdaptive(0.0, 1.0, [](double x) { return std::sqrt(x); }, 1e-12, 0.0, KronrodRule::G10K21);
+        adaptive.AddTest("Gauss-Kronrod - Endpoint singularity", res.converged && std::abs(res.value - 2.0 / 3.0) < 1e-12);
+
+        res = gaussKronrodAdaptive(0.0, 2.0, [](double x) { return x * x; });
+        adaptive.AddTest("Gauss-Kronrod - Single interval for polynomial", res.intervals == 1 && res.evaluations == 15);
+
+        res = gaussKronrodAdaptive(0.0, 1.0, peak, 1e-14, 0.0, KronrodRule::G7K15, 4);
+        adaptive.AddTest("Gauss-Kronrod - Interval limit", !res.converged && res.intervals <= 4);
+
+        adaptive.AddTest("Gauss-Kronrod - Invalid tolerance", shouldThrowException([&]() {
+            gaussKronrodAdaptive(0.0, 1.0, peak, 0.0, 0.0);
+            }));
+    }
+
+    {
+        UnitGroup legendre("Gauss-Legendre Rules");
+
+        const GaussLegendreRule& rule = getGLRule(4);
+        legendre.AddTest("Gauss-Legendre - Full precision nodes", std::abs(rule.nodes[3] - 0.86113631159405257522) < 1e-15
+            && std::abs(rule.weights[3] - 0.34785484513745385737) < 1e-15);
+        legendre.AddTest("Gauss-Legendre - Cached by reference", &getGLRule(4) == &rule);
+
+        // The weights next to x = 1 are the hardest to get in relative precision; references are from quad precision.
+        const GaussLegendreRule& large = getGLRule(1000);
+        const GaussLegendreRule& huge = getGLRule(5000);
+        double weightSum = 0.0;
+        for (double w : huge.weights) weightSum += w;
+        legendre.AddTest("Gauss-Legendre - Large n end weights", std::abs(large.weights.back() / 7.4133384164320715175e-06 - 1.0) < 1e-13
+            && std::abs(huge.weights.back() / 2.9677108524087973790e-07 - 1.0) < 1e-13
+            && std::abs(huge.nodes.back() - 0.99999988435941262965) < 2e-16 && std::abs(weightSum - 2.0) < 1e-13);
+
+        double res = gaussLegendreIntegral(-1.0, 1.0, [](double x) { return std::pow(x, 98); }, 50);
+        legendre.AddTest("Gauss-Legendre - High order exactness", std::abs(res - 2.0 / 99.0) < 1e-14);
+
+        res = gaussLegendreIntegral<12>(0.0, 1.0, [](double x) { return std::exp(x); });
+        legendre.AddTest("Gauss-Legendre - Compile-time table", std::abs(res - (std::exp(1.0) - 1.0)) < 1e-14);
+    }
+
+    {
+        UnitGroup composite("Composite Rules");
+
+        std::size_t calls = 0, batchCalls = 0;
+        auto cube = makeBatchIntegrand([&](const double* x, double* y, std::size_t count) {
+            batchCalls++;
+            calls += count;
+            for (std::size_t k = 0; k < count; k++) y[k] = x[k] * x[k] * x[k];
+            });
+        double res = Simpson(1000, cube, { 0.0, 2.0 });
+        composite.AddTest("Simpson - Batch integrand", std::abs(res - 4.0) < 1e-12 && calls == 1001 && batchCalls == 4);
+
+        res = Trapezoids(1000000, [](double x) { return x; }, { 0.0, 1.0 });
+        composite.AddTest("Trapezoids - All panels without drift", std::abs(res - 0.5) < 1e-12);
+
+        calls = 0;
+        double scale = 3.0;
+        res = Rect(10, [&](double x) { calls++; return scale * x; }, { 0.0, 1.0 });
+        composite.AddTest("Rect - Capturing lambda, one call per node", std::abs(res - 1.35) < 1e-12 && calls == 10);
+        composite.AddTest("Rect - Fractional step stays inside the range", std::abs(Rect(2.5, [](double) { return 1.0; }, { 0.0, 1.0 }) - 1.0) < 1e-15
+            && std::abs(RectParallel(2.5, [](double) { return 1.0; }, { 0.0, 1.0 }) - 1.0) < 1e-15);
+
+        composite.AddTest("Rect - Non-finite batch value", shouldThrowException([]() {
+            Rect(10, makeBatchIntegrand([](const double*, double* y, std::size_t count) {
+                for (std::size_t k = 0; k < count; k++) y[k] = std::nan("");
+                }), { 0.0, 1.0 });
+            }));
+    }
+
+    {
+        UnitGroup parallelRules("Parallel Integration");
+
+        auto wave = [](double x) {
+            double y = 0.0;
+            for (int k = 1; k <= 20; k++) y += std::sin(k * x) / k;
+            return y;
+        };
+
+        ParallelIntegrationOptions options;
+        options.deterministic = true;
+        options.threads = 1;
+        const double serial = SimpsonParallel(200000, wave, { 0.0, 1.0 }, options);
+        bool identical = true;
+        for (unsigned threads : { 2u, 3u, 8u }) {
+            options.threads = threads;
+            identical = identical && SimpsonParallel(200000, wave, { 0.0, 1.0 }, options) == serial;
+        }
+        parallelRules.AddTest("Simpson - Deterministic across thread counts", identical);
+        parallelRules.AddTest("Simpson - Matches serial rule", std::abs(serial - Simpson(200000, wave, { 0.0, 1.0 })) < 1e-12);
+
+        double res = TrapezoidsParallel(1000000, [](double x) { return std::exp(x); }, { 0.0, 1.0 });
+        parallelRules.AddTest("Trapezoids - Parallel accuracy", std::abs(res - (std::exp(1.0) - 1.0)) < 1e-11);
+
+        res = gaussLegendreIntegralSplitParallel(0.0, 3.0, [](double x) { return std::cos(x); }, 5, 100000);
+        parallelRules.AddTest("Gauss-Legendre - Parallel split", std::abs(res - std::sin(3.0)) < 1e-12);
+
+        parallelRules.AddTest("Rect - Exception from worker", shouldThrowException([]() {
+            ParallelIntegrationOptions forced;
+            forced.grainSize = 16;
+            RectParallel(100000, [](double x) { return x > 0.9 ? std::nan("") : std::sqrt(std::abs(std::sin(x))); }, { 0.0, 1.0 }, forced);
+            }));
+
+        parallel::ThreadPool pool(4);
+        std::atomic<int> total{ 0 };
+        pool.Run(100, [&](std::size_t) {
+            pool.Run(10, [&](std::size_t) { total++; });
+            });
+        parallelRules.AddTest("Thread pool - Nested runs", total == 1000);
+    }
+
+    {
+        UnitGroup romberg("Romberg Integration");
+
+        AdaptiveIntegrationResult res = rombergIntegral(0.0, 1.0, [](double x) { return std::exp(x); }, 1e-13, 0.0);
+        romberg.AddTest("Romberg - Smooth integrand", res.converged && std::abs(res.value - (std::exp(1.0) - 1.0)) < 1e-13);
+        romberg.AddTest("Romberg - Evaluations reused", res.evaluations == res.intervals + 1);
+
+        int calls = 0;
+        auto refinement = makeRombergRefinement([&calls](double x) { calls++; return std::sin(x); }, 0.0, 3.0);
+        for (int k = 0; k < 6; k++) refinement.Refine();
+        const double coarse = refinement.Estimate();
+        refinement.Refine();
+        romberg.AddTest("Romberg - Continued refinement", calls == 129 && refinement.Evaluations() == calls
+            && std::abs(refinement.Estimate() - (1.0 - std::cos(3.0))) <= std::abs(coarse - (1.0 - std::cos(3.0))));
+
+        romberg.AddTest("Romberg - Trapezoid column", std::abs(refinement.Trapezoid() - Trapezoids(128, [](double x) { return std::sin(x); }, { 0.0, 3.0 })) < 1e-14);
+
+        romberg.AddTest("Romberg - Invalid range", shouldThrowException([]() {
+            rombergIntegral(1.0, 0.0, [](double x) { return x; });
+            }));
+    }
+
+    {
+        UnitGroup cubature("Multidimensional Cubature");
+
+        double res = tensorGaussLegendre({ 0.0, 0.0, 0.0 }, { 1.0, 2.0, 1.0 }, [](const std::vector<double>& x) {
+            return x[0] * x[0] * x[1] * x[2] * x[2] * x[2];
+            }, 3);
+        cubature.AddTest("Tensor Gauss-Legendre - Polynomial exactness", std::abs(res - 1.0 / 6.0) < 1e-14);
+
+        auto expSum = [](const std::vector<double>& x) {
+            double s = 0.0;
+            for (double v : x) s += v;
+            return std::exp(s);
+        };
+        const std::vector<double> zero5(5, 0.0), one5(5, 1.0);
+        CubatureResult sparse = smolyakIntegral(zero5, one5, expSum, 6);
+        cubature.AddTest("Smolyak - 5-D exponential", std::abs(sparse.value - std::pow(std::exp(1.0) - 1.0, 5)) < 1e-8
+            && sparse.error < 1e-7 && sparse.evaluations == 6993);
+
+        auto anisotropic = [](const std::vector<double>& x) {
+            return std::exp(3.0 * x[0]) * (1.0 + 0.01 * x[1] + 0.001 * x[2] * x[3] + 1e-4 * x[4] * x[5]);
+        };
+        const double exact = (std::exp(3.0) - 1.0) / 3.0 * (1.0 + 0.005 + 0.00025 + 0.25e-4);
+        const std::vector<double> zero6(6, 0.0), one6(6, 1.0);
+        CubatureResult adaptive = adaptiveSparseGridIntegral(zero6, one6, anisotropic, 1e-10, 1e-10);
+        cubature.AddTest("Dimension-adaptive - Anisotropic 6-D", adaptive.converged && std::abs(adaptive.value - exact) < 1e-12
+            && adaptive.evaluations < smolyakIntegral(zero6, one6, anisotropic, 6).evaluations / 100);
+
+        const std::vector<double>& finest = clenshawCurtisWeights(SparseGridMaxLevel);
+        double weightSum = 0.0, secondMoment = 0.0;
+        for (std::size_t j = 0; j < finest.size(); j++) {
+            const double x = clenshawCurtisPoint(static_cast<std::int64_t>(j));
+            weightSum += finest[j];
+            secondMoment += finest[j] * x * x;
+        }
+        cubature.AddTest("Clenshaw-Curtis - Finest level weights", finest.size() == (std::size_t(1) << SparseGridMaxLevel) + 1
+            && std::abs(weightSum - 2.0) < 1e-13 && std::abs(secondMoment - 2.0 / 3.0) < 1e-13 && finest.front() == finest.back());
+
+        cubature.AddTest("Cubature - Invalid box", shouldThrowException([&]() {
+            smolyakIntegral({ 0.0, 1.0 }, { 1.0, 0.0 }, expSum, 2);
+            }));
+    }
+
+    {
+        UnitGroup monteCarlo("Quasi-Monte Carlo");
+
+        const auto words = Philox4x32({ 0, 0, 0, 0 }, { 0, 0 });
+        monteCarlo.AddTest("Philox - Known answer", words[0] == 0x6627e8d5u && words[1] == 0xe169c58du
+            && words[2] == 0xbc57ac4cu && words[3] == 0x9b00dbd8u);
+
+        SobolPoints sobol(3, false);
+        std::vector<double> block(3 * 5), single(3);
+        sobol.Fill(3, 5, block.data());
+        sobol.Fill(6, 1, single.data());
+        monteCarlo.AddTest("Sobol - Block independent", block[3] == single[0] && block[5 + 3] == single[1] && block[10 + 3] == single[2]);
+
+        auto product = [](const std::vector<double>& x) {
+            double p = 1.0;
+            for (std::size_t j = 0; j < x.size(); j++) p *= 1.0 + (x[j] - 0.5) / ((j + 1.0) * (j + 1.0));
+            return p;
+        };
+        const std::vector<double> zero(20, 0.0), one(20, 1.0);
+        MonteCarloOptions options;
+        options.absTol = 1e-6;
+        options.maxPoints = 1 << 15;
+        options.seed = 7;
+        MonteCarloResult res = monteCarloIntegral(zero, one, product, options);
+        monteCarlo.AddTest("Sobol - 20-D product", res.converged && std::abs(res.value - 1.0) < 5 * res.error + 1e-7);
+
+        options.threads = 1;
+        monteCarlo.AddTest("Sobol - Reproducible across threads", monteCarloIntegral(zero, one, product, options).value == res.value);
+
+        options.points = PointSet::Lattice;
+        options.absTol = 1e-4;
+        res = monteCarloIntegral(zero, one, product, options);
+        monteCarlo.AddTest("Lattice - Early stopping", res.converged && res.evaluations == 8 * 1024 && std::abs(res.value - 1.0) < 1e-4);
+
+        options.points = PointSet::Philox;
+        options.absTol = 1e-2;
+        res = monteCarloIntegral({ 0.0, 0.0 }, { 2.0, 1.0 }, [](const std::vector<double>& x) { return x[0] * x[1]; }, options);
+        monteCarlo.AddTest("Philox - Plain Monte Carlo", res.converged && std::abs(res.value - 1.0) < 5 * res.error);
+
+        MonteCarloOptions capped;
+        capped.minPoints = 1000;
+        capped.maxPoints = 1500;
+        capped.absTol = 0.0;
+        res = monteCarloIntegral({ 0.0 }, { 1.0 }, [](const std::vector<double>& x) { return std::exp(x[0]); }, capped);
+        capped.maxPoints = 999;
+        monteCarlo.AddTest("Options - Point count stays within maxPoints", res.evaluations == 8 * 1024
+            && shouldThrowException([&]() { monteCarloIntegral({ 0.0 }, { 1.0 }, [](const std::vector<double>&) { return 1.0; }, capped); }));
+    }
+
+    {
+        UnitGroup sampled("Sampled Data");
+
+        std::vector<double> x, y;
+        for (int i = 0; i <= 200; i++) {
+            x.push_back(std::pow(i / 200.0, 2) * 2.0);
+            y.push_back(3.0 * x.back() * x.back() - x.back());
+        }
+        sampled.AddTest("Simpson - Non-uniform quadratic", std::abs(SimpsonSampled(x, y) - 6.0) < 1e-12);
+
+        x.pop_back();
+        y.pop_back();
+        const double end = x.back();
+        sampled.AddTest("Simpson - Odd interval count", std::abs(SimpsonSampled(x, y) - (std::pow(end, 3) - end * end / 2.0)) < 1e-12);
+
+        std::vector<double> uniform(1001);
+        for (std::size_t i = 0; i < uniform.size(); i++) uniform[i] = std::exp(i * 0.001);
+        sampled.AddTest("Trapezoids - Uniform samples", std::abs(TrapezoidsSampled(uniform, 0.001) - (std::exp(1.0) - 1.0)) < 1e-6);
+
+        std::vector<double> running = CumulativeTrapezoids(uniform, 0.001);
+        sampled.AddTest("Cumulative - Prefix integral", running.size() == uniform.size() && running[0] == 0.0
+            && std::abs(running[500] - (std::exp(0.5) - 1.0)) < 1e-6 && std::abs(running.back() - TrapezoidsSampled(uniform, 0.001)) < 1e-14);
+
+        StreamingIntegrator stream;
+        for (std::size_t start = 0; start < x.size(); start += 7) {
+            std::size_t count = std::min<std::size_t>(7, x.size() - start);
+            stream.Add(x.data() + start, y.data() + start, count);
+        }
+        sampled.AddTest("Streaming - Chunks match whole series", stream.Count() == x.size()
+            && std::abs(stream.Simpson() - SimpsonSampled(x, y)) < 1e-14 && std::abs(stream.Trapezoid() - TrapezoidsSampled(x, y)) < 1e-14);
+
+        sampled.AddTest("Sampled - Mismatched sizes", shouldThrowException([]() {
+            SimpsonSampled({ 0.0, 1.0, 2.0 }, { 1.0, 2.0 });
+            }));
+    }
+
+    {
+        UnitGroup doubleExponential("Double-Exponential Quadrature");
+
+        AdaptiveIntegrationResult res = tanhSinhIntegral(0.0, 1.0, [](double x) { return std::log(x); });
+        doubleExponential.AddTest("Tanh-sinh - Logarithmic singularity", res.converged && std::abs(res.value + 1.0) < 1e-13);
+
+        res = tanhSinhIntegral(0.0, 1.0, [](double x, double d) { return 1.0 / std::sqrt(x > 0.5 ? d : 1.0 - x); });
+        doubleExponential.AddTest("Tanh-sinh - Endpoint distance", res.converged && std::abs(res.value - 2.0) < 1e-13);
+
+        int calls = 0;
+        auto circle = [&calls](double x) { calls++; return std::sqrt(1.0 - x * x); };
+        tanhSinhIntegral(-1.0, 1.0, circle, 1e-300, 0.0, 2);
+        const int coarseCalls = calls;
+        calls = 0;
+        AdaptiveIntegrationResult fine = tanhSinhIntegral(-1.0, 1.0, circle, 1e-300, 0.0, 3);
+        doubleExponential.AddTest("Tanh-sinh - Levels reuse evaluations", calls == fine.evaluations
+            && calls - coarseCalls <= 2 * static_cast<int>(tanhSinhTable().abscissas[3].size()));
+
+        res = expSinhIntegral(0.0, [](double x) { return 1.0 / (1.0 + x * x); });
+        doubleExponential.AddTest("Exp-sinh - Semi-infinite range", res.converged && std::abs(res.value - 2.0 * std::atan(1.0)) < 1e-13);
+
+        res = doubleExponentialIntegral(-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+            [](double x) { return std::exp(-x * x); });
+        doubleExponential.AddTest("Sinh-sinh - Infinite range", res.converged && std::abs(res.value - std::sqrt(4.0 * std::atan(1.0))) < 1e-13);
+    }
+
+    {
+        UnitGroup oscillatory("Oscillatory Quadrature");
+
+        const double omega = 1e5;
+        AdaptiveIntegrationResult res = filonIntegral(0.0, 1.0, [](double x) { return x; }, omega);
+        oscillatory.AddTest("Filon - Polynomial amplitude", res.converged
+            && std::abs(res.value - (std::sin(omega) - omega * std::cos(omega)) / (omega * omega)) < 1e-15);
+
+        auto amplitude = [](double x) { return std::exp(x); };
+        auto cosineExact = [](double w) { return (std::exp(1.0) * (std::cos(w) + w * std::sin(w)) - 1.0) / (1.0 + w * w); };
+        AdaptiveIntegrationResult slow = filonIntegral(0.0, 1.0, amplitude, 1e3, OscillatoryKernel::Cosine);
+        AdaptiveIntegrationResult fast = filonIntegral(0.0, 1.0, amplitude, 1e5, OscillatoryKernel::Cosine);
+        oscillatory.AddTest("Filon - Cost independent of frequency", slow.converged && fast.converged
+            && fast.evaluations <= slow.evaluations
+            && std::abs(slow.value - cosineExact(1e3)) < 1e-13 && std::abs(fast.value - cosineExact(1e5)) < 1e-15);
+
+        res = filonIntegral(0.0, 2.0, [](double x) { return 1.0 / (1.0 + x * x); }, 0.0, OscillatoryKernel::Cosine);
+        oscillatory.AddTest("Filon - Zero frequency", res.converged && std::abs(res.value - std::atan(2.0)) < 1e-12);
+
+        res = levinIntegral(0.0, 1.0, amplitude, [](double x) { return x; }, [](double) { return 1.0; }, omega, OscillatoryKernel::Cosine);
+        oscillatory.AddTest("Levin - Linear phase", res.converged && std::abs(res.value - cosineExact(omega)) < 1e-14);
+
+        // g(x) = x^2 + x, so that f = g' makes the integrand an exact derivative.
+        res = levinIntegral(0.0, 1.0, [](double x) { return 2.0 * x + 1.0; }, [](double x) { return x * x + x; },
+            [](double x) { return 2.0 * x + 1.0; }, 1e4, OscillatoryKernel::Sine);
+        oscillatory.AddTest("Levin - Nonlinear phase", res.converged && res.evaluations < 100
+            && std::abs(res.value - (1.0 - std::cos(2e4)) / 1e4) < 1e-14);
+    }
+
+    {
+        UnitGroup evaluationCache("Shared Evaluation Cache");
+
+        const std::vector<double> range = { 0.0, 3.0 };
+        std::size_t calls = 0;
+        auto counted = [&calls](double x) { calls++; return std::exp(-x) * std::sin(3.0 * x); };
+
+        IntegrationPlan plan(range);
+        const std::size_t rect = plan.AddRect(1000);
+        const std::size_t trapezoids = plan.AddTrapezoids(1000);
+        const std::size_t simpson = plan.AddSimpson(1000);
+        const std::size_t gauss = plan.AddGaussLegendreSplit(4, 100);
+        std::vector<double> estimates = plan.Evaluate(counted);
+
+        auto f = [](double x) { return std::exp(-x) * std::sin(3.0 * x); };
+        evaluationCache.AddTest("Plan - Estimates match standalone rules", estimates.size() == 4
+            && estimates[rect] == Rect(1000, f, range) && estimates[trapezoids] == Trapezoids(1000, f, range)
+            && estimates[simpson] == Simpson(1000, f, range)
+            && estimates[gauss] == gaussLegendreIntegralSplit(range[0], range[1], f, 4, 100));
+        evaluationCache.AddTest("Plan - Shared nodes evaluated once", calls == plan.Nodes().size() && calls == 1001 + 400);
+
+        std::size_t batches = 0;
+        auto batch = makeBatchIntegrand([&batches](const double* x, double* y, std::size_t count) {
+            batches++;
+            for (std::size_t i = 0; i < count; i++) y[i] = std::exp(-x[i]) * std::sin(3.0 * x[i]);
+            });
+        evaluationCache.AddTest("Plan - Batch integrand", plan.Evaluate(batch) == estimates
+            && batches == (plan.Nodes().size() + parallel::BlockSize - 1) / parallel::BlockSize);
+
+        calls = 0;
+        auto memoized = makeMemoizedIntegrand(counted);
+        const double trapezoid = Trapezoids(1000, memoized, range);
+        const double simpsonMemo = Simpson(1000, memoized, range);
+        Rect(1000, memoized, range);
+        evaluationCache.AddTest("Memoized - Values reused across rules", calls == 1001 && memoized.Evaluations() == 1001
+            && memoized.Hits() == 2001 && trapezoid == estimates[trapezoids] && simpsonMemo == estimates[simpson]);
+
+        bool thrown = false;
+        try {
+            plan.Estimates(std::vector<double>(3, 0.0));
+        }
+        catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        evaluationCache.AddTest("Plan - Value count checked", thrown);
+    }
+
+    {
+        UnitGroup approximationBases("Approximation Bases");
+
+        int calls = 0;
+        auto f = [&calls](double x) { calls++; return std::exp(x); };
+        Approximation<decltype(f)> monomial(f, 6, { 0.0, 2.0 });
+        approximationBases.AddTest("Monomial - One evaluation per node", calls == ApproximationQuadratureNodes
+            && std::abs(monomial.Approximate(1.3) - std::exp(1.3)) < 1e-5);
+
+        calls = 0;
+        Approximation<decltype(f)> legendre(f, 6, { 0.0, 2.0 }, ApproximationBasis::Legendre);
+        approximationBases.AddTest("Legendre - Same least-squares polynomial", calls == ApproximationQuadratureNodes
+            && std::abs(legendre.Approximate(1.3) - monomial.Approximate(1.3)) < 1e-9 && std::abs(legendre(0.1) - monomial(0.1)) < 1e-9);
+
+        auto smooth = [](double x) { return std::exp(std::sin(3.0 * x)); };
+        Approximation<decltype(smooth)> highDegree(smooth, 60, { -1.0, 1.0 }, ApproximationBasis::Legendre);
+        double legendreWorst = 0.0;
+        for (double x = -1.0; x <= 1.0; x += 0.001) legendreWorst = std::max(legendreWorst, std::abs(highDegree(x) - smooth(x)));
+        approximationBases.AddTest("Legendre - High degree converges", legendreWorst < 1e-12);
+
+        auto runge = [](double x) { return 1.0 / (1.0 + 25.0 * x * x); };
+        Approximation<decltype(runge)> chebyshev(runge, 40, { -1.0, 1.0 }, ApproximationBasis::Chebyshev);
+        double worst = 0.0;
+        for (double x = -1.0; x <= 1.0; x += 0.01) worst = std::max(worst, std::abs(chebyshev(x) - runge(x)));
+        approximationBases.AddTest("Chebyshev - High degree stays accurate", worst < 1e-3);
+
+        std::vector<double> points;
+        for (int i = 0; i <= 600; i++) points.push_back(2.0 * i / 600.0);
+        bool batchMatches = true;
+        for (const auto* approx : { &monomial, &legendre }) {
+            std::vector<double> values = approx->Approximate(points);
+            for (std::size_t i = 0; i < points.size(); i++) {
+                batchMatches = batchMatches && std::abs(values[i] - approx->Approximate(points[i])) < 1e-14;
+            }
+        }
+        approximationBases.AddTest("Batch evaluation matches scalar", batchMatches);
+
+        Approximation<decltype(runge)> stored(runge, chebyshev.Coefficients(), { -1.0, 1.0 }, ApproximationBasis::Chebyshev);
+        approximationBases.AddTest("Coefficients constructor keeps basis", stored.Basis() == ApproximationBasis::Chebyshev
+            && stored(0.3) == chebyshev(0.3));
+    }
+
+    {
+        UnitGroup chebyshevProxy("Chebyshev Proxies");
+
+        std::vector<std::complex<double>> signal(64);
+        for (std::size_t i = 0; i < signal.size(); i++) signal[i] = { std::sin(0.3 * i), std::cos(1.7 * i) };
+        std::vector<std::complex<double>> transformed = signal;
+        FFT(transformed);
+        std::complex<double> direct = 0.0;
+        for (std::size_t j = 0; j < signal.size(); j++) direct += signal[j] * std::polar(1.0, -2.0 * std::numbers::pi * 5.0 * j / 64.0);
+        FFT(transformed, true);
+        double roundTrip = 0.0;
+        for (std::size_t i = 0; i < signal.size(); i++) roundTrip = std::max(roundTrip, std::abs(transformed[i] - signal[i]));
+        FFT(signal);
+        chebyshevProxy.AddTest("FFT - Matches direct sum and inverts", std::abs(signal[5] - direct) < 1e-12 && roundTrip < 1e-14);
+
+        auto f = [](double x) { return std::exp(x) * std::sin(2.0 * x); };
+        ChebyshevProxy proxy(f, { 0.0, 2.0 });
+        std::vector<double> points;
+        double worst = 0.0;
+        for (int i = 0; i <= 1000; i++) {
+            points.push_back(2.0 * i / 1000.0);
+            worst = std::max(worst, std::abs(proxy(points.back()) - f(points.back())));
+        }
+        std::vector<double> batch = proxy.Evaluate(points);
+        bool batchMatches = true;
+        for (std::size_t i = 0; i < points.size(); i++) batchMatches = batchMatches && batch[i] == proxy(points[i]);
+        chebyshevProxy.AddTest("Proxy - Automatic degree", proxy.Resolved() && proxy.Degree() < 32 && worst < 1e-13 && batchMatches);
+
+        auto oscillatory = [](double x) { return std::sin(500.0 * x) * std::exp(x); };
+        ChebyshevProxy wave(oscillatory, { -1.0, 1.0 });
+        double waveWorst = 0.0;
+        for (double x = -1.0; x <= 1.0; x += 1e-3) waveWorst = std::max(waveWorst, std::abs(wave(x) - oscillatory(x)));
+        chebyshevProxy.AddTest("Proxy - Plateau chop of oscillatory function", wave.Resolved() && wave.Degree() < 700 && waveWorst < 1e-12);
+
+        ChebyshevProxy derivative = proxy.Derivative();
+        ChebyshevProxy antiderivative = proxy.Antiderivative();
+        auto exactDerivative = [](double x) { return std::exp(x) * (std::sin(2.0 * x) + 2.0 * std::cos(2.0 * x)); };
+        const double exactIntegral = (std::exp(2.0) * (std::sin(4.0) - 2.0 * std::cos(4.0)) + 2.0) / 5.0;
+        chebyshevProxy.AddTest("Proxy - Calculus", std::abs(derivative(1.3) - exactDerivative(1.3)) < 1e-11
+            && std::abs(proxy.Integral() - exactIntegral) < 1e-13 && std::abs(antiderivative(0.0)) < 1e-15
+            && std::abs(antiderivative(2.0) - exactIntegral) < 1e-13);
+
+        ChebyshevProxy sine([](double x) { return std::sin(x); }, { 0.5, 50.0 });
+        std::vector<double> roots = sine.Roots();
+        bool rootsCorrect = sine.Degree() > ChebyshevRootsDirectDegree && roots.size() == 15;
+        for (std::size_t i = 0; rootsCorrect && i < roots.size(); i++) {
+            rootsCorrect = std::abs(roots[i] - (i + 1) * std::numbers::pi) < 1e-12;
+        }
+        chebyshevProxy.AddTest("Proxy - Roots of high degree", rootsCorrect);
+
+        roots = ChebyshevProxy([](double x) { return x * x - 2.0; }, { 0.0, 3.0 }).Roots();
+        chebyshevProxy.AddTest("Proxy - Roots from colleague matrix", roots.size() == 1 && std::abs(roots[0] - std::sqrt(2.0)) < 1e-15);
+
+        ChebyshevProxy kink([](double x) { return std::abs(x); }, { -1.0, 1.0 }, ChebyshevDefaultTolerance, 128);
+        chebyshevProxy.AddTest("Proxy - Unresolved function reported", !kink.Resolved() && kink.Degree() == 128);
+    }
+
+    {
+        UnitGroup polynomial("Polynomial");
+
+        std::vector<double> a(300), b(200);
+        for (std::size_t i = 0; i < a.size(); i++) a[i] = std::sin(1.3 * i);
+        for (std::size_t i = 0; i < b.size(); i++) b[i] = std::cos(0.7 * i);
+        const Polynomial product = Polynomial(a) * Polynomial(b);
+        double productError = 0.0;
+        for (std::size_t k = 0; k < a.size() + b.size() - 1; k++) {
+            double direct = 0.0;
+            for (std::size_t i = 0; i < a.size(); i++) {
+                if (k >= i && k - i < b.size()) direct += a[i] * b[k - i];
+            }
+            productError = std::max(productError, std::abs(product[k] - direct));
+        }
+        polynomial.AddTest("FFT product matches convolution", product.Degree() == 498 && productError < 1e-11);
+
+        std::vector<double> roots;
+        for (int i = 0; i < 100; i++) roots.push_back(0.1 * std::cos(0.37 * i));
+        const Polynomial divisor = Polynomial::FromRoots(roots);
+        const std::pair<Polynomial, Polynomial> division = product.DivMod(divisor);
+        const Polynomial recombined = division.first * divisor + division.second;
+        double divisionError = 0.0;
+        for (std::size_t k = 0; k <= product.Degree(); k++) divisionError = std::max(divisionError, std::abs(recombined[k] - product[k]));
+        polynomial.AddTest("Division - Quotient and remainder", division.first.Degree() == 398 && division.second.Degree() < 100
+            && divisionError < 1e-12);
+
+        std::vector<double> x, decaying(b.size());
+        for (int i = 0; i < 256; i++) x.push_back(-0.25 + i / 512.0);
+        for (std::size_t i = 0; i < b.size(); i++) decaying[i] = b[i] * std::pow(0.9, static_cast<double>(i));
+        const Polynomial p(decaying);
+        const std::vector<double> fast = p.EvaluateMultipoint(x);
+        const std::vector<double> batch = p.Evaluate(x);
+        bool evaluationMatches = true;
+        for (std::size_t i = 0; i < x.size(); i++) {
+            evaluationMatches = evaluationMatches && std::abs(fast[i] - batch[i]) < 1e-10 && std::abs(batch[i] - p(x[i])) < 1e-12
+                && std::abs(p(x[i]) - GetValueHorner(x[i], decaying)) < 1e-12;
+        }
+        polynomial.AddTest("Evaluation - Multipoint, batch and scalar agree", evaluationMatches);
+
+        // On [-1, 1] the remainders would break down from about 64 points on; the result must match Horner's scheme.
+        std::vector<double> wide;
+        for (int i = 0; i < 256; i++) wide.push_back(std::cos(std::numbers::pi * (i + 0.5) / 256));
+        const Polynomial widePolynomial(a);
+        const std::vector<double> wideFast = widePolynomial.EvaluateMultipoint(wide);
+        bool wideMatches = true;
+        for (std::size_t i = 0; i < wide.size(); i++) {
+            wideMatches = wideMatches && std::abs(wideFast[i] - widePolynomial(wide[i])) <= 1e-12 * (1.0 + std::abs(widePolynomial(wide[i])));
+        }
+        polynomial.AddTest("Evaluation - Multipoint stays accurate on [-1, 1]", wideMatches);
+
+        // Degree SubproductMinDegree with (degree + 1) max |x| below SubproductMaxSpread goes through two trees.
+        std::vector<double> high(SubproductMinDegree + 1), near;
+        for (std::size_t i = 0; i < high.size(); i++) high[i] = std::cos(0.7 * i);
+        for (std::size_t i = 0; i < 2 * high.size() + 100; i++) near.push_back(100.0 / high.size() * std::cos(1.3 * i));
+        const Polynomial highPolynomial(high);
+        const std::vector<double> highFast = highPolynomial.EvaluateMultipoint(near);
+        const std::vector<double> highBatch = highPolynomial.Evaluate(near);
+        bool highMatches = true;
+        for (std::size_t i = 0; i < near.size(); i++) {
+            highMatches = highMatches && std::abs(highFast[i] - highBatch[i]) <= 1e-12 * (1.0 + std::abs(highBatch[i]));
+        }
+        polynomial.AddTest("Evaluation - Multipoint tree at high degree", highMatches);
+
+        // Interpolation runs through the Chebyshev-basis tree for more than SubproductLeafSize points.
+        auto interpolationError = [](const Polynomial& p, double lo, double hi) {
+            double error = 0.0;
+            for (int k = 0; k <= 1000; k++) {
+                const double t = lo + (hi - lo) * k / 1000.0;
+                error = std::max(error, std::abs(p(t) - std::exp(t)));
+            }
+            return error;
+            };
+        std::vector<double> chebyshev1000, exp1000, equispaced, expEquispaced, equispaced64, expEquispaced64;
+        for (int i = 0; i < 1000; i++) {
+            chebyshev1000.push_back(std::cos(std::numbers::pi * (i + 0.5) / 1000));
+            exp1000.push_back(std::exp(chebyshev1000.back()));
+        }
+        for (int i = 0; i < 24; i++) {
+            equispaced.push_back(3.9 * i / 23.0);
+            expEquispaced.push_back(std::exp(equispaced.back()));
+        }
+        for (int i = 0; i < 64; i++) {
+            equispaced64.push_back(3.9 * i / 63.0);
+            expEquispaced64.push_back(std::exp(equispaced64.back()));
+        }
+        const Polynomial chebyshevInterpolant = Polynomial::Interpolate(chebyshev1000, exp1000);
+        polynomial.AddTest("Interpolation - 1000 Chebyshev points", chebyshevInterpolant.Degree() < 20
+            && interpolationError(chebyshevInterpolant, -1.0, 1.0) < 1e-13);
+        polynomial.AddTest("Interpolation - Equispaced points off center", interpolationError(Polynomial::Interpolate(equispaced, expEquispaced), 0.0, 3.9) < 1e-9);
+        polynomial.AddTest("Interpolation - Ill-conditioned point set rejected", shouldThrowException([&]() {
+            Polynomial::Interpolate(equispaced64, expEquispaced64);
+            }));
+
+        std::vector<double> nodes, values;
+        for (int i = 0; i < 14; i++) {
+            nodes.push_back(std::cos(std::numbers::pi * (i + 0.5) / 14));
+            values.push_back(std::exp(nodes.back()));
+        }
+        const Polynomial interpolant = Polynomial::Interpolate(nodes, values);
+        polynomial.AddTest("Interpolation - Single leaf", interpolant.Degree() == 13 && std::abs(interpolant(0.123) - std::exp(0.123)) < 1e-12);
+
+        auto g = [](double t) { return std::cos(t); };
+        Approximation<decltype(g)> legendre(g, 8, { 0.0, 2.0 }, ApproximationBasis::Legendre);
+        polynomial.AddTest("Approximation converted to monomials", std::abs(legendre.ToPolynomial()(1.7) - legendre(1.7)) < 1e-12
+            && legendre.ToPolynomial().Degree() == 8);
+    }
+
+    {
+        UnitGroup newtonInterpolant("Newton Interpolant");
+        const std::vector<double> x = { 1.0, 2.0, 3.0, 4.0 };
+        const std::vector<double> y = { 1.0, 4.0, 9.0, 16.0 };
+        const NewtonInterpolant quadratic(x, y);
+        newtonInterpolant.AddTest("Coefficients - In-place divided differences", quadratic.Coefficients() == std::vector<double>({ 1.0, 3.0, 1.0, 0.0 }));
+        newtonInterpolant.AddTest("Evaluate - Matches InterpolateNewton", std::abs(quadratic(2.5) - 6.25) < tol
+            && std::abs(quadratic(2.5) - InterpolateNewton(2.5, x, y)) < 1e-14);
+
+        std::vector<double> nodes, values;
+        for (int i = 0; i < 20; i++) {
+            nodes.push_back(std::cos(std::numbers::pi * (i + 0.5) / 20));
+            values.push_back(std::exp(nodes.back()));
+        }
+        const NewtonInterpolant exponential(nodes, values);
+        std::vector<double> points(10000);
+        for (std::size_t i = 0; i < points.size(); i++) points[i] = -1.0 + 2.0 * i / (points.size() - 1.0);
+        const std::vector<double> batch = exponential.Evaluate(points);
+        bool batchMatches = true;
+        for (std::size_t i = 0; i < points.size(); i++) {
+            batchMatches = batchMatches && std::abs(batch[i] - exponential(points[i])) < 1e-15 && std::abs(batch[i] - std::exp(points[i])) < 1e-13;
+        }
+        newtonInterpolant.AddTest("Batch - Parallel blocks match scalar evaluation", batchMatches);
+
+        std::vector<std::vector<double>> shared(4);
+        parallel::RunChunks(shared.size(), [&](std::size_t c) { shared[c] = exponential.Evaluate(points); });
+        bool sharedMatches = true;
+        for (const auto& result : shared) sharedMatches = sharedMatches && result == batch;
+        newtonInterpolant.AddTest("Shared - Concurrent evaluation from several threads", sharedMatches);
+
+        newtonInterpolant.AddTest("Invalid input - Repeated nodes", shouldThrowException([&]() {
+            NewtonInterpolant({ 1.0, 2.0, 1.0 }, { 0.0, 1.0, 2.0 });
+            }));
+        newtonInterpolant.AddTest("Invalid input - Size mismatch", shouldThrowException([&]() {
+            NewtonInterpolant({ 1.0, 2.0 }, { 0.0 });
+            }));
+    }
+
+    {
+        UnitGroup barycentric("Barycentric Interpolation");
+        const BarycentricInterpolant quadratic({ 1.0, 2.0, 3.0 }, { 1.0, 4.0, 9.0 });
+        barycentric.AddTest("General nodes - Matches InterpolateLagrange", std::abs(quadratic(2.5) - 6.25) < 1e-14
+            && std::abs(quadratic(2.5) - InterpolateLagrange(2.5, { 1.0, 2.0, 3.0 }, { 1.0, 4.0, 9.0 }, 3)) < 1e-14
+            && quadratic(2.0) == 4.0);
+
+        auto f = [](double x) { return 1.0 / (1.0 + 25.0 * x * x); };
+        std::vector<double> chebyshevValues;
+        for (double x : BarycentricInterpolant::ChebyshevNodes(201, { -1.0, 1.0 })) chebyshevValues.push_back(f(x));
+        const BarycentricInterpolant runge = BarycentricInterpolant::Chebyshev(chebyshevValues, { -1.0, 1.0 });
+        const BarycentricInterpolant general(runge.Nodes(), runge.Values());
+        bool weightsMatch = true;
+        for (std::size_t j = 0; j < runge.Weights().size(); j++) {
+            weightsMatch = weightsMatch && std::abs(runge.Weights()[j] - general.Weights()[j]) < 1e-10;
+        }
+        barycentric.AddTest("Chebyshev - Closed-form weights match the O(n^2) weights", weightsMatch && std::abs(runge(0.3) - f(0.3)) < 1e-12);
+
+        std::vector<double> firstKindValues;
+        for (double x : BarycentricInterpolant::ChebyshevNodes(40, { 0.0, 2.0 }, ChebyshevNodeKind::First)) firstKindValues.push_back(std::exp(x));
+        const BarycentricInterpolant firstKind = BarycentricInterpolant::Chebyshev(firstKindValues, { 0.0, 2.0 }, ChebyshevNodeKind::First);
+        const BarycentricInterpolant equispaced = BarycentricInterpolant::Equispaced({ 1.0, 8.0, 27.0, 64.0, 125.0 }, { 1.0, 5.0 });
+        barycentric.AddTest("First kind and equispaced - Closed-form weights", std::abs(firstKind(1.234) - std::exp(1.234)) < 1e-13
+            && std::abs(equispaced(2.5) - 15.625) < 1e-12);
+
+        BarycentricInterpolant growing({ 0.0 }, { std::sin(0.0) });
+        for (int i = 1; i <= 15; i++) growing.AddNode(i / 15.0, std::sin(i / 15.0));
+        std::vector<double> growingNodes = growing.Nodes(), growingValues = growing.Values();
+        const BarycentricInterpolant rebuilt(growingNodes, growingValues);
+        bool addedMatches = std::abs(growing(0.55) - std::sin(0.55)) < 1e-13;
+        for (std::size_t j = 0; j < rebuilt.Weights().size(); j++) {
+            addedMatches = addedMatches && std::abs(growing.Weights()[j] - rebuilt.Weights()[j]) < 1e-10;
+        }
+        barycentric.AddTest("AddNode - Incremental weights match a rebuild", addedMatches);
+
+        std::vector<double> points(1000);
+        for (std::size_t i = 0; i < points.size(); i++) points[i] = -1.0 + 2.0 * i / (points.size() - 1.0);
+        points[10] = runge.Nodes()[7];
+        const std::vector<double> batch = runge.Evaluate(points);
+        bool batchMatches = batch[10] == runge.Values()[7];
+        for (std::size_t i = 0; i < points.size(); i++) batchMatches = batchMatches && std::abs(batch[i] - runge(points[i])) < 1e-14;
+        barycentric.AddTest("Batch - Matches scalar evaluation, including nodes", batchMatches);
+
+        barycentric.AddTest("Invalid input - Repeated nodes", shouldThrowException([&]() {
+            BarycentricInterpolant({ 1.0, 2.0, 1.0 }, { 0.0, 1.0, 2.0 });
+            }) && shouldThrowException([&]() { growing.AddNode(0.0, 1.0); }));
+    }
+
+    {
+        UnitGroup spline("Splines");
+        std::vector<double> x, y;
+        for (int i = 0; i <= 100; i++) {
+            x.push_back(i / 100.0);
+            y.push_back(std::sin(3.0 * x.back()));
+        }
+        const Spline natural(x, y);
+        const Spline clamped(x, y, SplineKind::Clamped, 3.0, 3.0 * std::cos(3.0));
+        const Spline notAKnot(x, y, SplineKind::NotAKnot);
+        spline.AddTest("Cubic - Natural, clamped and not-a-knot accuracy", natural.Uniform() && std::abs(natural(0.505) - std::sin(1.515)) < 1e-7
+            && std::abs(clamped(0.005) - std::sin(0.015)) < 1e-9 && std::abs(notAKnot(0.995) - std::sin(2.985)) < 1e-8
+            && std::abs(clamped.Derivative(0.0) - 3.0) < 1e-12 && natural(0.37) == y[37]);
+
+        const Spline cubic({ 0.0, 0.5, 1.5, 2.0, 3.5 }, { 0.0, 0.125, 3.375, 8.0, 42.875 }, SplineKind::NotAKnot);
+        const Spline parabola({ 0.0, 1.0, 3.0 }, { 0.0, 1.0, 9.0 }, SplineKind::NotAKnot);
+        spline.AddTest("Not-a-knot - Reproduces cubics and parabolas", !cubic.Uniform() && std::abs(cubic(2.7) - 2.7 * 2.7 * 2.7) < 1e-12
+            && std::abs(parabola(2.2) - 4.84) < 1e-12);
+
+        const std::vector<double> steps = { 0.0, 0.1, 0.2, 2.0, 2.1, 2.2 }, levels = { 0.0, 0.0, 0.0, 1.0, 1.0, 1.0 };
+        const Spline monotone(steps, levels, SplineKind::Monotone);
+        const Spline linear(steps, levels, SplineKind::Linear);
+        bool monotoneHolds = true;
+        double previous = 0.0;
+        for (int i = 0; i <= 220; i++) {
+            const double value = monotone(i / 100.0);
+            monotoneHolds = monotoneHolds && value >= previous - 1e-15 && value >= 0.0 && value <= 1.0;
+            previous = value;
+        }
+        spline.AddTest("Monotone and linear - Preserve shape", monotoneHolds && std::abs(linear(1.1) - 0.5) < 1e-15);
+
+        std::vector<double> points(5000);
+        for (std::size_t i = 0; i < points.size(); i++) points[i] = -0.1 + 1.2 * ((i * 7919) % points.size()) / points.size();
+        const Spline irregular(steps, { 1.0, 2.0, 0.0, 3.0, 1.0, 2.0 });
+        std::vector<double> sorted = points;
+        std::sort(sorted.begin(), sorted.end());
+        const std::vector<double> uniformBatch = natural.Evaluate(points), irregularBatch = irregular.Evaluate(sorted);
+        bool batchMatches = true;
+        std::size_t interval = 0;
+        for (std::size_t i = 0; i < points.size(); i++) {
+            batchMatches = batchMatches && std::abs(uniformBatch[i] - natural(points[i])) < 1e-15
+                && irregularBatch[i] == irregular(sorted[i]) && irregular.Evaluate(sorted[i], interval) == irregularBatch[i];
+        }
+        spline.AddTest("Batch - Uniform and cached-search lookups match scalar evaluation", batchMatches);
+
+        spline.AddTest("Invalid input - Unsorted nodes", shouldThrowException([&]() {
+            Spline({ 0.0, 2.0, 1.0 }, { 0.0, 1.0, 2.0 });
+            }));
+        spline.AddTest("Invalid input - Single point", shouldThrowException([&]() {
+            Spline({ 0.0 }, { 1.0 });
+            }));
+    }
+
+    {
+        UnitGroup tabulated("Tabulated Functions");
+        auto f = [](double x) { return std::exp(-x) * std::sin(3 * x); };
+        const TabulatedFunction table = tabulate(f, { 0.0, 10.0 }, 1e-10);
+        double largest = 0.0;
+        for (int i = 0; i <= 100000; i++) largest = std::max(largest, std::abs(table(i / 10000.0) - f(i / 10000.0)));
+        tabulated.AddTest("Error bound - Holds between check points", table.Verified() && table.MaxError() <= 1e-10 && largest < 2e-10);
+
+        auto peaked = [](double x) { return std::sqrt(x + 1e-3); };
+        const TabulatedFunction adaptive(peaked, { 0.0, 1.0 }, 1e-8, 7);
+        const std::vector<double>& breaks = adaptive.Breaks();
+        tabulated.AddTest("Adaptive segments - Narrow near the steep end", adaptive.Verified() && breaks.front() == 0.0 && breaks.back() == 1.0
+            && breaks[1] - breaks[0] < (breaks.back() - breaks[breaks.size() - 2]) / 100.0 && std::abs(adaptive(0.0005) - peaked(0.0005)) < 1e-8);
+
+        const TabulatedFunction cubic([](double x) { return x * x * x - x; }, { -2.0, 2.0 }, 1e-12, 3);
+        tabulated.AddTest("Polynomials - Reproduced by a single segment", cubic.Segments() == 1 && std::abs(cubic(1.5) - 1.875) < 1e-13);
+
+        std::vector<double> points(3000);
+        for (std::size_t i = 0; i < points.size(); i++) points[i] = 10.0 * ((i * 7919) % points.size()) / points.size();
+        const std::vector<double> batch = table.Evaluate(points);
+        bool batchMatches = true;
+        for (std::size_t i = 0; i < points.size(); i++) batchMatches = batchMatches && batch[i] == table(points[i]);
+        tabulated.AddTest("Batch - Matches scalar evaluation", batchMatches);
+
+        const TabulatedFunction jump([](double x) { return x < 0.3 ? 0.0 : 1.0; }, { 0.0, 1.0 }, 1e-6, 3, 16);
+        tabulated.AddTest("Unresolved - Discontinuity reported at the segment limit", !jump.Verified() && jump.Segments() <= 16 && jump.MaxError() > 0.1);
+
+        tabulated.AddTest("Invalid input - Non-positive tolerance", shouldThrowException([&]() {
+            tabulate(f, { 0.0, 1.0 }, 0.0);
+            }));
+    }
+
+    {
+        UnitGroup grid("Grid Interpolation");
+        std::vector<double> xs, ys, zs;
+        for (int i = 0; i <= 20; i++) xs.push_back(i / 20.0);
+        for (int j = 0; j <= 30; j++) ys.push_back(-1.0 + j / 15.0);
+        for (int k = 0; k <= 10; k++) zs.push_back(k * k / 50.0);
+        auto plane = [](double x, double y) { return 1.0 + 2.0 * x - 3.0 * y + 0.5 * x * y; };
+        std::vector<double> planeValues;
+        for (double x : xs) for (double y : ys) planeValues.push_back(plane(x, y));
+        const GridInterpolant bilinear({ xs, ys }, planeValues);
+        grid.AddTest("Bilinear - Reproduces bilinear functions", std::abs(bilinear({ 0.37, 0.21 }) - plane(0.37, 0.21)) < 1e-13
+            && std::abs(bilinear({ 1.0, 1.0 }) - plane(1.0, 1.0)) < 1e-14);
+
+        auto smooth = [](double x, double y, double z) { return std::sin(2.0 * x) * std::cos(y) * std::exp(-z); };
+        std::vector<double> smoothValues;
+        for (double x : xs) for (double y : ys) for (double z : zs) smoothValues.push_back(smooth(x, y, z));
+        const GridInterpolant tricubic({ xs, ys, zs }, smoothValues, GridMethod::Cubic);
+        const GridInterpolant trilinear({ xs, ys, zs }, smoothValues.data());
+        const double cubicError = std::abs(tricubic({ 0.512, 0.123, 0.777 }) - smooth(0.512, 0.123, 0.777));
+        const double linearError = std::abs(trilinear({ 0.512, 0.123, 0.777 }) - smooth(0.512, 0.123, 0.777));
+        grid.AddTest("Tricubic - More accurate than trilinear on external storage", cubicError < 5e-4 && cubicError < linearError / 10.0);
+
+        std::vector<double> cubicValues;
+        for (double x : xs) for (double y : ys) cubicValues.push_back(x * x - 2.0 * y * y);
+        const GridInterpolant bicubic({ xs, ys }, cubicValues, GridMethod::Cubic);
+        grid.AddTest("Bicubic - Catmull-Rom reproduces quadratics inside the grid", std::abs(bicubic({ 0.43, 0.31 }) - (0.43 * 0.43 - 2.0 * 0.31 * 0.31)) < 1e-13
+            && std::abs(bicubic({ 0.5, 0.2 }) - (0.25 - 0.08)) < 1e-13);
+
+        std::vector<double> points;
+        for (int i = 0; i < 6000; i++) {
+            points.push_back(((i * 37) % 1000) / 1000.0);
+            points.push_back(-1.0 + ((i * 53) % 2000) / 1000.0);
+            points.push_back(2.0 * ((i * 71) % 1000) / 1000.0);
+        }
+        std::vector<double> batch(6000);
+        tricubic.Evaluate(points.data(), batch.data(), batch.size());
+        GridInterpolant precomputed = tricubic;
+        precomputed.PrecomputeCells();
+        std::vector<double> precomputedBatch(6000);
+        precomputed.Evaluate(points.data(), precomputedBatch.data(), precomputedBatch.size());
+        bool batchMatches = precomputed.Precomputed() && !tricubic.Precomputed();
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            batchMatches = batchMatches && std::abs(batch[i] - tricubic.Evaluate(points.data() + 3 * i)) < 1e-15
+                && std::abs(precomputedBatch[i] - batch[i]) < 1e-13;
+        }
+        grid.AddTest("Batch - Parallel gathers and precomputed cells match scalar evaluation", batchMatches);
+
+        grid.AddTest("Invalid input - Value count does not match the grid", shouldThrowException([&]() {
+            GridInterpolant({ xs, ys }, std::vector<double>(10, 0.0));
+            }));
+        grid.AddTest("Invalid input - Unsorted axis", shouldThrowException([&]() {
+            GridInterpolant({ { 0.0, 2.0, 1.0 } }, std::vector<double>(3, 0.0));
+            }));
+    }
+
+    {
+        UnitGroup streamingNewton("Streaming Newton Interpolation");
+        StreamingNewtonInterpolant stream(4);
+        stream.Push(1.0, 1.0);
+        stream.Push(2.0, 4.0);
+        streamingNewton.AddTest("Partial window - Line through two samples", stream.Size() == 2 && std::abs(stream(1.5) - 2.5) < 1e-15);
+
+        bool matchesFresh = true;
+        std::vector<double> xs, ys;
+        StreamingNewtonInterpolant feed(6);
+        for (int i = 0; i < 200; i++) {
+            const double x = 0.05 * i + 0.01 * std::sin(static_cast<double>(i));
+            feed.Push(x, std::exp(std::sin(x)));
+            xs.push_back(x);
+            ys.push_back(std::exp(std::sin(x)));
+            if (xs.size() > 6) {
+                xs.erase(xs.begin());
+                ys.erase(ys.begin());
+            }
+            const double query = x - 0.12;
+            matchesFresh = matchesFresh && std::abs(feed(query) - InterpolateNewton(query, xs, ys)) < 1e-12;
+        }
+        streamingNewton.AddTest("Sliding window - Matches InterpolateNewton on the last samples", matchesFresh && feed.Size() == 6 && feed.Window() == 6);
+
+        StreamingNewtonInterpolant cubic(4);
+        for (int i = 0; i < 10; i++) cubic.Push(i, i * i * i - 2.0 * i);
+        streamingNewton.AddTest("Full window - Reproduces cubics after evictions", std::abs(cubic(7.5) - (7.5 * 7.5 * 7.5 - 15.0)) < 1e-10);
+
+        bool rejected = shouldThrowException([&]() { cubic.Push(8.0, 0.0); });
+        cubic.Push(5.0, 115.0);
+        streamingNewton.AddTest("Repeated node - Rejected until evicted", rejected && std::abs(cubic(7.5) - (7.5 * 7.5 * 7.5 - 15.0)) < 1e-10);
+
+        StreamingNewtonInterpolant empty(3);
+        streamingNewton.AddTest("Empty window - Evaluation throws", shouldThrowException([&]() { empty(1.0); })
+            && shouldThrowException([&]() { StreamingNewtonInterpolant(0); }));
+    }
+
+    {
+        UnitGroup batchRoots("Batched Root Finding");
+        // x e^x = p_i for 10000 parameters, enough to run on the thread pool.
+        std::vector<double> p(10000), a(10000, 0.0), b(10000, 10.0), x0(10000);
+        for (std::size_t i = 0; i < p.size(); i++) {
+            p[i] = 0.01 + 0.5 * i;
+            x0[i] = std::log1p(p[i]);
+        }
+        auto f = [&](const std::size_t* e, const double* x, double* y, std::size_t n) {
+            for (std::size_t k = 0; k < n; k++) y[k] = x[k] * std::exp(x[k]) - p[e[k]];
+        };
+        auto df = [](const std::size_t*, const double* x, double* y, std::size_t n) {
+            for (std::size_t k = 0; k < n; k++) y[k] = (1.0 + x[k]) * std::exp(x[k]);
+        };
+        auto solved = [&](const BatchRootResult& r, double accuracy) {
+            bool ok = r.roots.size() == p.size();
+            for (std::size_t i = 0; i < p.size() && ok; i++) {
+                ok = r.status[i] == BatchRootStatus::Converged && std::abs(r.roots[i] * std::exp(r.roots[i]) - p[i]) < accuracy * (1.0 + p[i]);
+            }
+            return ok;
+        };
+
+        const BatchRootResult bisected = bisection_batch(f, a, b, 1e-10);
+        batchRoots.AddTest("Bisection - Every lane converges", solved(bisected, 1e-8)
+            && std::abs(bisected.roots[0] - bisection([&](double x) { return x * std::exp(x) - p[0]; }, 0.0, 10.0, 1e-10)) < 1e-9);
+
+        const BatchRootResult falsi = falsi_batch(f, a, b, 1e-12);
+        batchRoots.AddTest("Regula falsi - Illinois lanes converge", solved(falsi, 1e-10) && falsi.iterations[5000] < bisected.iterations[5000]);
+
+        const BatchRootResult newtons = newton_batch(f, x0, df, 1e-10);
+        bool uneven = false;
+        for (std::size_t i = 1; i < p.size(); i++) uneven = uneven || newtons.iterations[i] != newtons.iterations[0];
+        batchRoots.AddTest("Newton - Lanes finish independently", solved(newtons, 1e-10) && uneven);
+
+        std::vector<double> c = { -1.0, 0.0, 1.0 };
+        auto shifted = [&](const std::size_t* e, const double* x, double* y, std::size_t n) {
+            for (std::size_t k = 0; k < n; k++) y[k] = x[k] * x[k] + c[e[k]];
+        };
+        auto slope = [](const std::size_t*, const double* x, double* y, std::size_t n) {
+            for (std::size_t k = 0; k < n; k++) y[k] = 2.0 * x[k];
+        };
+        const BatchRootResult bracketed = bisection_batch(shifted, { 0.0, -1.0, 0.0 }, { 2.0, 0.0, 2.0 });
+        batchRoots.AddTest("Per-lane status - Sign change and end point roots", bracketed.status[0] == BatchRootStatus::Converged
+            && std::abs(bracketed.roots[0] - 1.0) < 1e-7 && bracketed.roots[1] == 0.0 && bracketed.status[2] == BatchRootStatus::NoSignChange);
+
+        const BatchRootResult flat = newton_batch(shifted, { 0.0, 0.5, 3.0 }, slope, 1e-10, 50);
+        batchRoots.AddTest("Per-lane status - Zero derivative and iteration limit", flat.status[0] == BatchRootStatus::ZeroDerivative
+            && std::isnan(flat.roots[0]) && flat.status[1] == BatchRootStatus::Converged && flat.status[2] == BatchRootStatus::MaxIterations);
+
+        batchRoots.AddTest("Invalid input - Bracket sizes differ", shouldThrowException([&]() {
+            bisection_batch(f, { 0.0 }, { 1.0, 2.0 });
+            }));
+    }
 }